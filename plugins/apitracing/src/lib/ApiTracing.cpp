@@ -27,7 +27,7 @@ namespace ApiTracing
     ApiTracing::ApiTracing(VmiCore::Plugin::PluginInterface* pluginInterface,
                            const VmiCore::Plugin::IPluginConfig& config,
                            std::vector<std::string>& args)
-        : logger(pluginInterface->newNamedLogger(APITRACING_LOGGER_NAME))
+        : pluginInterface(pluginInterface), logger(pluginInterface->newNamedLogger(APITRACING_LOGGER_NAME))
     {
         logger->bind({{VmiCore::WRITE_TO_FILE_TAG, LOG_FILENAME}});
 
@@ -84,7 +84,10 @@ namespace ApiTracing
                 throw std::runtime_error("Unknown operating system.");
             }
         }
+    }
 
+    void ApiTracing::start()
+    {
         // Hook process if it's already running
         auto runningProcesses = pluginInterface->getRunningProcesses();
         for (const auto& processInformation : *runningProcesses)
@@ -15,9 +15,12 @@ namespace ApiTracing
 
         ~ApiTracing() override = default;
 
+        void start() override;
+
         void unload() override;
 
       private:
+        VmiCore::Plugin::PluginInterface* pluginInterface;
         std::unique_ptr<VmiCore::ILogger> logger;
         std::shared_ptr<Tracer> tracer;
     };
@@ -42,28 +42,65 @@ namespace ApiTracing
             functionEntrypoint, *processInformation, VMICORE_SETUP_SAFE_MEMBER_CALLBACK(hookCallback));
     }
 
+    VmiCore::BreakpointSpec
+    FunctionHook::getBreakpointSpec(VmiCore::addr_t moduleBaseAddress,
+                                    const std::shared_ptr<const VmiCore::ActiveProcessInformation>& processInformation)
+    {
+        return {.targetVA = introspectionAPI->translateUserlandSymbolToVA(
+                    moduleBaseAddress, processInformation->processUserDtb, functionName),
+                .callbackFunction = VMICORE_SETUP_SAFE_MEMBER_CALLBACK(hookCallback)};
+    }
+
+    void FunctionHook::setBreakpoint(std::shared_ptr<IBreakpoint> hookBreakpoint)
+    {
+        breakpoint = std::move(hookBreakpoint);
+    }
+
     BpResponse FunctionHook::hookCallback(IInterruptEvent& event)
     {
-        logger->info(
-            "hookCallback hit",
-            {{"Module", moduleName}, {"Function", functionName}, {"Gla", fmt::format("{:x}", event.getGla())}});
+        auto gla = event.getGla();
         if (parameterInformation->empty())
         {
+            pluginInterface->deferTask(event.getVcpuId(), [self = shared_from_this(), gla]() { self->logHit(gla); });
             return BpResponse::Continue;
         }
 
+        // Parameters have to be extracted while the guest is halted, everything else is done by a worker thread
         auto extractedParameters = extractor->extractParameters(event, parameterInformation);
+        pluginInterface->deferTask(
+            event.getVcpuId(),
+            [self = shared_from_this(),
+             gla,
+             cr3 = event.getCr3(),
+             gs = event.getGs(),
+             extractedParameters = std::move(extractedParameters)]()
+            {
+                self->logHit(gla);
+                self->logCall(cr3, gs, extractedParameters);
+            });
+
+        return BpResponse::Continue;
+    }
+
+    void FunctionHook::logHit(VmiCore::addr_t gla) const
+    {
+        logger->info("hookCallback hit",
+                     {{"Module", moduleName}, {"Function", functionName}, {"Gla", fmt::format("{:x}", gla)}});
+    }
+
+    void FunctionHook::logCall(uint64_t cr3,
+                               uint64_t gs,
+                               const std::vector<ExtractedParameterInformation>& extractedParameters) const
+    {
         auto json = getParameterListAsJson(extractedParameters);
         std::string unformattedTraces = Json::writeString(builder, json);
 
         logger->info("Monitored function called",
                      {{"FunctionName", functionName},
                       {"ModuleName", moduleName},
-                      {"ProcessDtb", fmt::format("{:x}", event.getCr3())},
-                      {"ProcessTeb", fmt::format("{:x}", event.getGs())},
+                      {"ProcessDtb", fmt::format("{:x}", cr3)},
+                      {"ProcessTeb", fmt::format("{:x}", gs)},
                       {"Parameterlist", unformattedTraces}});
-
-        return BpResponse::Continue;
     }
 
     Json::Value
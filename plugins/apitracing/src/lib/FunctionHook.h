@@ -8,6 +8,7 @@
 #include <json/writer.h>
 #include <vmicore/io/ILogger.h>
 #include <vmicore/plugins/PluginInterface.h>
+#include <vmicore/vmi/BreakpointSpec.h>
 #include <vmicore/vmi/IBreakpoint.h>
 
 namespace ApiTracing
@@ -25,6 +26,16 @@ namespace ApiTracing
         void hookFunction(VmiCore::addr_t moduleBaseAddress,
                           std::shared_ptr<const VmiCore::ActiveProcessInformation> processInformation);
 
+        /**
+         * Resolves the function entrypoint for creating the hook together with other ones. The resulting breakpoint
+         * has to be handed over via setBreakpoint.
+         */
+        [[nodiscard]] VmiCore::BreakpointSpec
+        getBreakpointSpec(VmiCore::addr_t moduleBaseAddress,
+                          const std::shared_ptr<const VmiCore::ActiveProcessInformation>& processInformation);
+
+        void setBreakpoint(std::shared_ptr<VmiCore::IBreakpoint> hookBreakpoint);
+
         [[nodiscard]] VmiCore::BpResponse hookCallback(VmiCore::IInterruptEvent& event);
 
         void teardown() const;
@@ -40,7 +51,14 @@ namespace ApiTracing
         std::unique_ptr<VmiCore::ILogger> logger;
         Json::StreamWriterBuilder builder;
 
-        Json::Value getParameterListAsJson(const std::vector<ExtractedParameterInformation>& extractedParameters);
+        static Json::Value
+        getParameterListAsJson(const std::vector<ExtractedParameterInformation>& extractedParameters);
+
+        void logHit(VmiCore::addr_t gla) const;
+
+        void logCall(uint64_t cr3,
+                     uint64_t gs,
+                     const std::vector<ExtractedParameterInformation>& extractedParameters) const;
     };
 }
 #endif // APITRACING_FUNCTIONHOOK_H
@@ -71,9 +71,19 @@ namespace ApiTracing
 
     void TracedProcess::injectHooks()
     {
+        struct PendingHook
+        {
+            std::string_view moduleName;
+            std::string_view functionName;
+            std::shared_ptr<FunctionHook> hook;
+        };
+
         auto introspectionAPI = pluginInterface->getIntrospectionAPI();
 
-        hookList.reserve(numberOfFunctionsToTrace());
+        std::vector<PendingHook> pendingHooks;
+        std::vector<VmiCore::BreakpointSpec> breakpointSpecs;
+        pendingHooks.reserve(numberOfFunctionsToTrace());
+        breakpointSpecs.reserve(numberOfFunctionsToTrace());
 
         for (const auto& moduleHookTarget : tracingProfile.modules)
         {
@@ -94,24 +104,45 @@ namespace ApiTracing
                     auto extractor = std::make_shared<Extractor>(introspectionAPI, pluginInterface, addressWidth);
                     auto functionHook = std::make_shared<FunctionHook>(
                         moduleHookTarget.name, functionName, extractor, introspectionAPI, definitions, pluginInterface);
-                    functionHook->hookFunction(moduleBaseAddress, processInformation);
-                    hookList.push_back(functionHook);
+                    breakpointSpecs.push_back(functionHook->getBreakpointSpec(moduleBaseAddress, processInformation));
+                    pendingHooks.push_back({moduleHookTarget.name, functionName, functionHook});
                 }
                 catch (const std::exception& e)
                 {
-                    logger->warning("Could not trace function",
-                                    {{"Library", moduleHookTarget.name},
-                                     {"Function", functionName},
-                                     {"Process", processInformation->name},
-                                     {"Pid", processInformation->pid},
-                                     {"Exception", e.what()}});
+                    logTracingFailure(moduleHookTarget.name, functionName, e.what());
                 }
             }
         }
 
+        // All hooks of the process are injected at once, so that the guest only has to be paused a single time
+        pluginInterface->createBreakpoints(*processInformation, breakpointSpecs);
+        hookList.reserve(pendingHooks.size());
+        for (std::size_t i = 0; i < pendingHooks.size(); i++)
+        {
+            if (!breakpointSpecs[i].breakpoint)
+            {
+                logTracingFailure(pendingHooks[i].moduleName, pendingHooks[i].functionName, breakpointSpecs[i].error);
+                continue;
+            }
+            pendingHooks[i].hook->setBreakpoint(std::move(breakpointSpecs[i].breakpoint));
+            hookList.push_back(std::move(pendingHooks[i].hook));
+        }
+
         hookList.shrink_to_fit();
     }
 
+    void TracedProcess::logTracingFailure(std::string_view moduleName,
+                                          std::string_view functionName,
+                                          std::string_view error) const
+    {
+        logger->warning("Could not trace function",
+                        {{"Library", moduleName},
+                         {"Function", functionName},
+                         {"Process", processInformation->name},
+                         {"Pid", processInformation->pid},
+                         {"Exception", error}});
+    }
+
     std::size_t TracedProcess::numberOfFunctionsToTrace() const
     {
         std::size_t numberOfFunctions = 0;
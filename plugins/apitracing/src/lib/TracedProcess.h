@@ -56,6 +56,9 @@ namespace ApiTracing
 
         void injectHooks();
 
+        void
+        logTracingFailure(std::string_view moduleName, std::string_view functionName, std::string_view error) const;
+
         [[nodiscard]] std::size_t numberOfFunctionsToTrace() const;
     };
 }
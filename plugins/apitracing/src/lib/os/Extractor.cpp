@@ -2,7 +2,9 @@
 #include "../ConstantDefinitions.h"
 #include "../Filenames.h"
 #include <fmt/core.h>
+#include <optional>
 #include <stdexcept>
+#include <vmicore/vmi/VmiException.h>
 
 using VmiCore::addr_t;
 using VmiCore::IInterruptEvent;
@@ -156,14 +158,7 @@ namespace ApiTracing
             case UNICODE_WSTR_32:
             case UNICODE_WSTR_64:
             {
-                try
-                {
-                    result.data = extractUnicodeString(shallowParameter, cr3);
-                }
-                catch (std::exception&)
-                {
-                    result.data = "";
-                }
+                result.data = extractUnicodeString(shallowParameter, cr3);
                 break;
             }
             case __PTR32:
@@ -223,13 +218,24 @@ namespace ApiTracing
         uint64_t stackPointerVA, uint64_t cr3, std::vector<ParameterInformation> stackParameterInformation) const
     {
         auto stackParams = std::vector<uint64_t>(stackParameterInformation.size());
+        auto entries = std::vector<VmiCore::BatchReadEntry>{};
+        entries.reserve(stackParameterInformation.size());
+        for (uint64_t i = 0; i < stackParameterInformation.size(); i++)
+        {
+            entries.push_back(VmiCore::BatchReadEntry::forValue(
+                stackPointerVA + i * (addressWidth / ConstantDefinitions::byteSize), cr3, stackParams[i]));
+        }
+        if (!introspectionAPI->readBatch(entries))
+        {
+            throw VmiCore::VmiException(
+                fmt::format("{}: Unable to read stack parameters at VA {:#x}", __func__, stackPointerVA));
+        }
+
         for (uint64_t i = 0; i < stackParameterInformation.size(); i++)
         {
             const auto& parameterType = stackParameterInformation.at(i);
             auto parameterLength = (parameterType.backingParameters.empty()) ? parameterType.size : addressWidth;
-            auto parameter = readParameter(
-                stackPointerVA + i * (addressWidth / ConstantDefinitions::byteSize), parameterLength, cr3);
-            stackParams[i] = parameter;
+            stackParams[i] = zeroGarbageBytes(stackParams[i], parameterLength);
         }
 
         return stackParams;
@@ -240,25 +246,62 @@ namespace ApiTracing
                                         uint64_t address,
                                         uint64_t cr3)
     {
+        // Read all plain values of the current struct within a single round trip
+        auto parameterValues = std::vector<uint64_t>(backingParameters.size());
+        auto batchEntryIndices = std::vector<std::optional<std::size_t>>(backingParameters.size());
+        auto entries = std::vector<VmiCore::BatchReadEntry>{};
+        for (std::size_t i = 0; i < backingParameters.size(); i++)
+        {
+            const auto& parameter = backingParameters[i];
+            if (parameter.backingParameters.empty() && parameter.size <= sizeof(uint64_t))
+            {
+                batchEntryIndices[i] = entries.size();
+                entries.push_back(
+                    {address + parameter.offset, cr3, parameter.size, static_cast<void*>(&parameterValues[i])});
+            }
+        }
+        // Failed reads are handled individually below
+        [[maybe_unused]] auto allSuccessful = introspectionAPI->readBatch(entries);
+
         std::vector<ExtractedParameterInformation> extractedBackingParameters;
-        for (const auto& parameter : backingParameters)
+        for (std::size_t i = 0; i < backingParameters.size(); i++)
         {
+            const auto& parameter = backingParameters[i];
             ExtractedParameterInformation extraction{.name = parameter.name, .data = {}, .backingParameters = {}};
             try
             {
                 if (parameter.backingParameters.empty())
                 {
-                    auto parameterValue = introspectionAPI->readVA(address + parameter.offset, cr3, parameter.size);
-                    extraction = extractSingleParameter(parameterValue, cr3, parameter);
+                    if (!batchEntryIndices[i].has_value())
+                    {
+                        throw std::invalid_argument(fmt::format("Parameter size too large: {}", parameter.size));
+                    }
+                    if (entries[batchEntryIndices[i].value()].success)
+                    {
+                        extraction = extractSingleParameter(parameterValues[i], cr3, parameter);
+                    }
+                    else
+                    {
+                        logger->debug("Could not read backing parameter",
+                                      {{"name", parameter.name},
+                                       {"address", fmt::format("{:#x}", address + parameter.offset)}});
+                    }
                 }
                 else
                 {
                     // Extract shallow parameters (based on size) from shallowParameters.at(parameterIndex). Then pass
                     // those to the nexţ iteration
-                    addr_t structPointer = dereferencePointer(address + parameter.offset, cr3);
-
-                    extraction.backingParameters =
-                        extractBackingParameters(parameter.backingParameters, structPointer, cr3);
+                    if (auto structPointer = tryDereferencePointer(address + parameter.offset, cr3))
+                    {
+                        extraction.backingParameters =
+                            extractBackingParameters(parameter.backingParameters, *structPointer, cr3);
+                    }
+                    else
+                    {
+                        logger->debug("Could not dereference backing parameter",
+                                      {{"name", parameter.name},
+                                       {"address", fmt::format("{:#x}", address + parameter.offset)}});
+                    }
                 }
             }
             // Don't stop extraction on first failed parameter. Instead, insert default element try to extract the rest.
@@ -272,12 +315,6 @@ namespace ApiTracing
         return extractedBackingParameters;
     }
 
-    uint64_t Extractor::readParameter(uint64_t stackPointerVA, uint8_t parameterSize, uint64_t cr3) const
-    {
-        auto output = introspectionAPI->read64VA(stackPointerVA, cr3);
-        return zeroGarbageBytes(output, parameterSize);
-    }
-
     uint64_t Extractor::zeroGarbageBytes(uint64_t parameter, uint8_t parameterSize) const
     {
         parameter = parameter << (addressWidth - parameterSize * ConstantDefinitions::byteSize);
@@ -287,29 +324,26 @@ namespace ApiTracing
 
     std::string Extractor::extractString(addr_t stringPointer, uint64_t cr3) const
     {
-        auto string = introspectionAPI->extractStringAtVA(stringPointer, cr3);
-        return {*string};
+        return introspectionAPI->tryExtractStringAtVA(stringPointer, cr3).value_or("");
     }
 
     std::string Extractor::extractWString(addr_t stringPointer, uint64_t cr3) const
     {
-        auto string = introspectionAPI->extractWStringAtVA(stringPointer, cr3);
-        return {*string};
+        return introspectionAPI->extractWStringAtVA(stringPointer, cr3).value_or("");
     }
 
     std::string Extractor::extractUnicodeString(addr_t stringPointer, uint64_t cr3) const
     {
-        auto string = introspectionAPI->extractUnicodeStringAtVA(stringPointer, cr3);
-        return {*string};
+        return introspectionAPI->tryExtractUnicodeStringAtVA(stringPointer, cr3).value_or("");
     }
 
-    addr_t Extractor::dereferencePointer(uint64_t addr, uint64_t cr3) const
+    std::optional<addr_t> Extractor::tryDereferencePointer(uint64_t addr, uint64_t cr3) const
     {
         if (addressWidth == ConstantDefinitions::x86AddressWidth)
         {
-            return introspectionAPI->read32VA(addr, cr3);
+            return introspectionAPI->tryRead32VA(addr, cr3);
         }
         // implicit x64 address width
-        return introspectionAPI->read64VA(addr, cr3);
+        return introspectionAPI->tryRead64VA(addr, cr3);
     }
 }
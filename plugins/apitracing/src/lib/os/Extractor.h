@@ -3,6 +3,7 @@
 
 #include "../config/FunctionDefinitions.h"
 #include <any>
+#include <optional>
 #include <ostream>
 #include <variant>
 #include <vector>
@@ -142,8 +143,6 @@ namespace ApiTracing
         [[nodiscard]] std::vector<ExtractedParameterInformation> extractBackingParameters(
             const std::vector<ParameterInformation>& backingParameters, uint64_t address, uint64_t cr3);
 
-        [[nodiscard]] uint64_t readParameter(uint64_t stackPointerVA, uint8_t parameterSize, uint64_t cr3) const;
-
         [[nodiscard]] uint64_t zeroGarbageBytes(uint64_t parameter, uint8_t parameterSize) const;
 
         [[nodiscard]] std::string extractString(VmiCore::addr_t stringPointer, uint64_t cr3) const;
@@ -152,7 +151,7 @@ namespace ApiTracing
 
         [[nodiscard]] std::string extractUnicodeString(VmiCore::addr_t stringPointer, uint64_t cr3) const;
 
-        [[nodiscard]] VmiCore::addr_t dereferencePointer(uint64_t addr, uint64_t cr3) const;
+        [[nodiscard]] std::optional<VmiCore::addr_t> tryDereferencePointer(uint64_t addr, uint64_t cr3) const;
     };
 }
 #endif // APITRACING_EXTRACTOR_H
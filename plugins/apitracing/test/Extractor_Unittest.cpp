@@ -1,8 +1,10 @@
 #include "../src/lib/os/Extractor.h"
 #include "ConstantDefinitions.h"
 #include "TestConstantDefinitions.h"
+#include <cstring>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <span>
 #include <vmicore/vmi/VmiException.h>
 #include <vmicore_test/io/mock_Logger.h>
 #include <vmicore_test/plugins/mock_PluginInterface.h>
@@ -151,6 +153,30 @@ namespace ApiTracing
             ON_CALL(*interruptEvent, getR8).WillByDefault(Return(testParams64[2].expectedValue));
             ON_CALL(*interruptEvent, getR9).WillByDefault(Return(testParams64[3].expectedValue));
             ON_CALL(*interruptEvent, getRsp).WillByDefault(Return(testRsp));
+            ON_CALL(*introspectionAPI, readBatch(_))
+                .WillByDefault([this](std::span<VmiCore::BatchReadEntry> entries)
+                               { return readBatchBySingleReads(entries); });
+        }
+
+        // Resolves batch reads via the readVA mock so that memory state only has to be set up once
+        bool readBatchBySingleReads(std::span<VmiCore::BatchReadEntry> entries)
+        {
+            bool allSuccessful = true;
+            for (auto& entry : entries)
+            {
+                try
+                {
+                    auto value = introspectionAPI->readVA(entry.virtualAddress, entry.dtb, entry.size);
+                    std::memcpy(entry.destination, &value, entry.size);
+                    entry.success = true;
+                }
+                catch (const VmiCore::VmiException&)
+                {
+                    entry.success = false;
+                    allSuccessful = false;
+                }
+            }
+            return allSuccessful;
         }
 
         void SetupParameterInformation(const std::vector<TestParameterInformation>& testParameters)
@@ -164,9 +190,10 @@ namespace ApiTracing
 
         void SetupNestedStructPointerReads()
         {
-            ON_CALL(*introspectionAPI, read64VA(param2Value, testDtb)).WillByDefault(Return(ObjectAttributesTwoValue));
+            ON_CALL(*introspectionAPI, tryRead64VA(param2Value, testDtb))
+                .WillByDefault(Return(ObjectAttributesTwoValue));
 
-            ON_CALL(*introspectionAPI, read64VA(ObjectAttributesOneValue, testDtb))
+            ON_CALL(*introspectionAPI, tryRead64VA(ObjectAttributesOneValue, testDtb))
                 .WillByDefault(Return(ObjectAttributesTwoValue));
 
             ON_CALL(*introspectionAPI,
@@ -177,8 +204,8 @@ namespace ApiTracing
                     readVA(ObjectAttributesTwoValue + ObjectAttributesTwoContentTwoOffset, testDtb, sizeof(uint64_t)))
                 .WillByDefault(Return(ExtractedStringAddress));
 
-            ON_CALL(*introspectionAPI, extractStringAtVA(ExtractedStringAddress, testDtb))
-                .WillByDefault([]() { return std::make_unique<std::string>(extractedString); });
+            ON_CALL(*introspectionAPI, tryExtractStringAtVA(ExtractedStringAddress, testDtb))
+                .WillByDefault(Return(std::optional<std::string>(extractedString)));
         }
 
         std::vector<uint64_t> SetupParametersAndStack(const std::vector<TestParameterInformation>& parameters,
@@ -206,7 +233,9 @@ namespace ApiTracing
             for (size_t i = ConstantDefinitions::maxRegisterParameterCount; i < parameters.size(); i++)
             {
                 ON_CALL(*introspectionAPI,
-                        read64VA(testRsp + ConstantDefinitions::stackParameterOffsetX64 + stackOffset, testDtb))
+                        readVA(testRsp + ConstantDefinitions::stackParameterOffsetX64 + stackOffset,
+                               testDtb,
+                               sizeof(uint64_t)))
                     .WillByDefault(Return(parameters[i].expectedValue));
                 stackOffset += stackEntrySize;
             }
@@ -217,7 +246,9 @@ namespace ApiTracing
             for (size_t i = 0; i < parameters.size(); i++)
             {
                 ON_CALL(*introspectionAPI,
-                        read64VA(testRsp + (i + 1) * ConstantDefinitions::stackParameterOffsetX86, testDtb))
+                        readVA(testRsp + (i + 1) * ConstantDefinitions::stackParameterOffsetX86,
+                               testDtb,
+                               sizeof(uint64_t)))
                     .WillByDefault(Return(parameters[i].expectedValue));
             }
         }
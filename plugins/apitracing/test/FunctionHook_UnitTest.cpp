@@ -89,7 +89,7 @@ namespace ApiTracing
                                       std::vector<ParameterInformation>{{.name = "TestParameter"}}),
                                   pluginInterface.get()};
         EXPECT_CALL(*introspectionAPI, translateUserlandSymbolToVA).Times(1);
-        EXPECT_CALL(*pluginInterface, createBreakpoint).Times(1);
+        EXPECT_CALL(*pluginInterface, createBreakpoint(_, _, _)).Times(1);
         auto tracedProcessInformation = createProcessInformation(tracedProcessDtb, tracedProcessUserDtb);
 
         functionHook.hookFunction(testModuleBase, tracedProcessInformation);
@@ -97,18 +97,39 @@ namespace ApiTracing
 
     TEST_F(FunctionHookTestFixture, hookCallBack_functionHookWithParameters_extractsParameters)
     {
-        FunctionHook functionHook{std::string(testModuleName),
-                                  std::string(testModuleFunctionName),
-                                  extractor,
-                                  introspectionAPI,
-                                  std::make_shared<std::vector<ParameterInformation>>(
-                                      std::vector<ParameterInformation>{{.name = "TestParameter"}}),
-                                  pluginInterface.get()};
+        auto functionHook = std::make_shared<FunctionHook>(
+            std::string(testModuleName),
+            std::string(testModuleFunctionName),
+            extractor,
+            introspectionAPI,
+            std::make_shared<std::vector<ParameterInformation>>(
+                std::vector<ParameterInformation>{{.name = "TestParameter"}}),
+            pluginInterface.get());
         auto tracedProcessInformation = createProcessInformation(tracedProcessDtb, tracedProcessUserDtb);
 
-        functionHook.hookFunction(testModuleBase, tracedProcessInformation);
+        functionHook->hookFunction(testModuleBase, tracedProcessInformation);
         EXPECT_CALL(*extractor, extractParameters).Times(1);
 
-        static_cast<void>(functionHook.hookCallback(*interruptEvent));
+        static_cast<void>(functionHook->hookCallback(*interruptEvent));
+    }
+
+    TEST_F(FunctionHookTestFixture, hookCallBack_functionHookWithParameters_defersLoggingToVcpuOfEvent)
+    {
+        constexpr uint32_t testVcpuId = 3;
+        auto functionHook = std::make_shared<FunctionHook>(
+            std::string(testModuleName),
+            std::string(testModuleFunctionName),
+            extractor,
+            introspectionAPI,
+            std::make_shared<std::vector<ParameterInformation>>(
+                std::vector<ParameterInformation>{{.name = "TestParameter"}}),
+            pluginInterface.get());
+        auto tracedProcessInformation = createProcessInformation(tracedProcessDtb, tracedProcessUserDtb);
+        functionHook->hookFunction(testModuleBase, tracedProcessInformation);
+        ON_CALL(*interruptEvent, getVcpuId()).WillByDefault(Return(testVcpuId));
+
+        EXPECT_CALL(*pluginInterface, deferTask(testVcpuId, _)).Times(1);
+
+        static_cast<void>(functionHook->hookCallback(*interruptEvent));
     }
 }
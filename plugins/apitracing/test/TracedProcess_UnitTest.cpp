@@ -12,11 +12,13 @@
 #include <vmicore_test/vmi/mock_IntrospectionAPI.h>
 
 using testing::_;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Ref;
 using testing::Return;
 using VmiCore::ActiveProcessInformation;
 using VmiCore::addr_t;
+using VmiCore::BreakpointSpec;
 using VmiCore::MemoryRegion;
 using VmiCore::MockBreakpoint;
 using VmiCore::MockIntrospectionAPI;
@@ -45,6 +47,11 @@ namespace ApiTracing
         constexpr std::string_view nonDllName = "KernelBase";
     }
 
+    MATCHER_P2(AreBreakpointTargets, firstTargetVA, secondTargetVA, "")
+    {
+        return arg.size() == 2 && arg[0].targetVA == firstTargetVA && arg[1].targetVA == secondTargetVA;
+    }
+
     MemoryRegion createMemoryRegionDescriptor(addr_t startAddr, size_t size, std::string_view name)
     {
         return MemoryRegion{
@@ -117,10 +124,10 @@ namespace ApiTracing
     {
         auto processInformation = createProcessInformationWithDefaultMemoryRegions(
             tracedProcessDtb, tracedProcessUserDtb, tracedProcessPid, targetProcessName);
-        EXPECT_CALL(*mockPluginInterface, createBreakpoint(kernelDllFunctionAddress, Ref(*processInformation), _))
-            .WillOnce(Return(std::make_shared<NiceMock<MockBreakpoint>>()));
-        EXPECT_CALL(*mockPluginInterface, createBreakpoint(ntdllFunctionAddress, Ref(*processInformation), _))
-            .WillOnce(Return(std::make_shared<NiceMock<MockBreakpoint>>()));
+        EXPECT_CALL(*mockPluginInterface,
+                    createBreakpoints(Ref(*processInformation),
+                                      AreBreakpointTargets(kernelDllFunctionAddress, ntdllFunctionAddress)))
+            .WillOnce(Return(true));
 
         EXPECT_NO_THROW(createTracedProcessWithDefaultDlls(processInformation));
     }
@@ -130,11 +137,16 @@ namespace ApiTracing
         auto processInformation = createProcessInformationWithDefaultMemoryRegions(
             tracedProcessDtb, tracedProcessUserDtb, tracedProcessPid, targetProcessName);
         auto kernelDllFunctionBreakpoint = std::make_shared<MockBreakpoint>();
-        EXPECT_CALL(*mockPluginInterface, createBreakpoint(kernelDllFunctionAddress, Ref(*processInformation), _))
-            .WillOnce(Return(kernelDllFunctionBreakpoint));
         auto ntdllFunctionBreakpoint = std::make_shared<MockBreakpoint>();
-        EXPECT_CALL(*mockPluginInterface, createBreakpoint(ntdllFunctionAddress, Ref(*processInformation), _))
-            .WillOnce(Return(ntdllFunctionBreakpoint));
+        EXPECT_CALL(*mockPluginInterface, createBreakpoints(Ref(*processInformation), _))
+            .WillOnce(Invoke(
+                [&kernelDllFunctionBreakpoint, &ntdllFunctionBreakpoint](const ActiveProcessInformation&,
+                                                                         std::span<BreakpointSpec> breakpointSpecs)
+                {
+                    breakpointSpecs[0].breakpoint = kernelDllFunctionBreakpoint;
+                    breakpointSpecs[1].breakpoint = ntdllFunctionBreakpoint;
+                    return true;
+                }));
 
         EXPECT_CALL(*kernelDllFunctionBreakpoint, remove());
         EXPECT_CALL(*ntdllFunctionBreakpoint, remove());
@@ -142,4 +154,23 @@ namespace ApiTracing
         auto tracedProcess = createTracedProcessWithDefaultDlls(processInformation);
         tracedProcess.removeHooks();
     }
+
+    TEST_F(TracedProcessTestFixture, removeHooks_oneBreakpointNotCreated_onlyCreatedBreakpointsRemoved)
+    {
+        auto processInformation = createProcessInformationWithDefaultMemoryRegions(
+            tracedProcessDtb, tracedProcessUserDtb, tracedProcessPid, targetProcessName);
+        auto ntdllFunctionBreakpoint = std::make_shared<MockBreakpoint>();
+        EXPECT_CALL(*mockPluginInterface, createBreakpoints(Ref(*processInformation), _))
+            .WillOnce(Invoke(
+                [&ntdllFunctionBreakpoint](const ActiveProcessInformation&, std::span<BreakpointSpec> breakpointSpecs)
+                {
+                    breakpointSpecs[0].error = "Page not present";
+                    breakpointSpecs[1].breakpoint = ntdllFunctionBreakpoint;
+                    return false;
+                }));
+        EXPECT_CALL(*ntdllFunctionBreakpoint, remove());
+
+        auto tracedProcess = createTracedProcessWithDefaultDlls(processInformation);
+        tracedProcess.removeHooks();
+    }
 }
@@ -31,6 +31,12 @@ class Cmdline
         "n", "name", "Name of the domain to introspect.", false, "", "domain_name", cmd};
     TCLAP::ValueArg<std::filesystem::path> kvmiSocketArgument{
         "s", "socket", "KVMi socket path {required for introspecting on kvm}.", false, "", "/path/to/socket", cmd};
+    TCLAP::ValueArg<std::filesystem::path> memoryDumpArgument{
+        "d", "dump", "Raw physical memory dump to analyze instead of a running VM.", false, "", "/path/to/dump", cmd};
+    TCLAP::ValueArg<std::filesystem::path> recordEventsArgument{
+        "", "record", "Record all events of the VM to the given trace file.", false, "", "/path/to/trace", cmd};
+    TCLAP::ValueArg<std::filesystem::path> replayEventsArgument{
+        "", "replay", "Replay a recorded trace on top of a memory dump.", false, "", "/path/to/trace", cmd};
     TCLAP::ValueArg<std::string> resultsDirectoryArgument{
         "r", "results", "Path to top level directory for results.", false, "./results", "results_directory", cmd};
     TCLAP::ValueArg<std::string> gRPCListenAddressArgument{
@@ -26,6 +26,13 @@ namespace VmiCore::Plugin
       public:
         virtual ~IPlugin() = default;
 
+        /**
+         * Called once all plugins have been initialized and all running processes are known. This is the place for
+         * initialization that depends on the state of the guest, e.g. hooking processes that are already running.
+         * Process start and termination callbacks are only invoked afterwards. Is allowed to throw.
+         */
+        virtual void start() {}
+
         /**
          * Called right before shutting down the application. Is allowed to throw.
          */
@@ -36,7 +43,10 @@ namespace VmiCore::Plugin
     };
 
     /**
-     * Entry point for plugin initialization. Will be called by the plugin host (VMICore).
+     * Entry point for plugin initialization. Will be called by the plugin host (VMICore) before the guest is paused,
+     * hence it should only perform work that does not depend on the state of the guest, such as parsing configuration
+     * files or compiling rules. Neither running processes nor breakpoints are available at this point. Everything else
+     * belongs into IPlugin::start().
      *
      * @param pluginInterface An object containing all API functions that are exposed to plugins.
      * @param config The plugin specific configuration. See <a href=./IPluginConfig.h>IPluginConfig.h</a href> for
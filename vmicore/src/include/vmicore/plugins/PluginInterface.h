@@ -5,12 +5,15 @@
 #include "../os/ActiveProcessInformation.h"
 #include "../types.h"
 #include "../vmi/BpResponse.h"
+#include "../vmi/BreakpointFilter.h"
+#include "../vmi/BreakpointSpec.h"
 #include "../vmi/IBreakpoint.h"
 #include "../vmi/IIntrospectionAPI.h"
 #include "../vmi/IMemoryMapping.h"
 #include "../vmi/events/IInterruptEvent.h"
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -23,7 +26,7 @@ namespace VmiCore::Plugin
     class PluginInterface
     {
       public:
-        constexpr static uint8_t API_VERSION = 16;
+        constexpr static uint8_t API_VERSION = 23;
 
         virtual ~PluginInterface() = default;
 
@@ -81,6 +84,35 @@ namespace VmiCore::Plugin
                          const ActiveProcessInformation& processInformation,
                          const std::function<BpResponse(IInterruptEvent&)>& callbackFunction) = 0;
 
+        /**
+         * Same as the overload above, but hits are only delivered to the callback if the given filter holds. The
+         * filter is evaluated by VMICore itself, hence uninteresting hits are discarded without invoking any plugin
+         * code. See BreakpointFilter for details.
+         *
+         * @param filter Conditions on registers and small reads of guest memory.
+         * @throws VmiException If the filter is malformed.
+         */
+        [[nodiscard]] virtual std::shared_ptr<IBreakpoint>
+        createBreakpoint(uint64_t targetVA,
+                         const ActiveProcessInformation& processInformation,
+                         const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
+                         const BreakpointFilter& filter) = 0;
+
+        /**
+         * Creates several breakpoints within the same process at once. In contrast to multiple calls of
+         * createBreakpoint, the address space is only flushed once, breakpoints on the same page share a single guard
+         * and all INT3s are written while the VM is paused only once. A failing entry does not abort the remaining
+         * ones.
+         *
+         * @param processInformation The process information for the target process. Can be obtained via
+         * getRunningProcesses().
+         * @param breakpointSpecs Breakpoints to create. The breakpoint or the error of each entry will be set
+         * accordingly.
+         * @return True if all breakpoints have been created, false otherwise.
+         */
+        virtual bool createBreakpoints(const ActiveProcessInformation& processInformation,
+                                       std::span<BreakpointSpec> breakpointSpecs) = 0;
+
         /**
          * Retrieves the path to the directory where plugins are supposed to store any files that are generated
          * throughout the course of a run. However, it is generally discouraged to store files directly. Instead,
@@ -125,6 +157,18 @@ namespace VmiCore::Plugin
          */
         [[nodiscard]] virtual std::shared_ptr<IIntrospectionAPI> getIntrospectionAPI() const = 0;
 
+        /**
+         * Runs the given task on a worker thread while the guest continues to execute. Use this for work that does not
+         * need the guest to be halted, e.g. formatting and logging of data that has already been extracted within a
+         * breakpoint callback. Tasks deferred for the same vCPU are executed in submission order, hence all tasks
+         * of a breakpoint are ordered per vCPU as well. All outstanding tasks are completed before plugins are
+         * unloaded.
+         *
+         * @param vcpuId The vCPU the task originates from. See IInterruptEvent::getVcpuId().
+         * @param task Must only capture data that stays valid until it has been executed.
+         */
+        virtual void deferTask(uint32_t vcpuId, std::function<void()> task) = 0;
+
       protected:
         PluginInterface() = default;
     };
@@ -0,0 +1,37 @@
+#ifndef VMICORE_BATCHREADENTRY_H
+#define VMICORE_BATCHREADENTRY_H
+
+#include "../types.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace VmiCore
+{
+    /**
+     * Describes a single read of a scatter-gather request. See IIntrospectionAPI::readBatch.
+     */
+    struct BatchReadEntry
+    {
+        /// Guest virtual address to start reading from.
+        addr_t virtualAddress;
+        /// Directory table base used for translating the virtual address.
+        addr_t dtb;
+        /// Number of bytes to read.
+        std::size_t size;
+        /// Buffer with a capacity of at least size bytes. Will only contain valid data if success is set.
+        void* destination;
+        /// Will be set by the batch read to indicate whether this particular read has been successful.
+        bool success = false;
+
+        /**
+         * Convenience factory for reading a trivially copyable value in its entirety.
+         */
+        template <typename T> static BatchReadEntry forValue(addr_t virtualAddress, addr_t dtb, T& destination)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Destination has to be trivially copyable");
+            return {virtualAddress, dtb, sizeof(T), static_cast<void*>(&destination)};
+        }
+    };
+}
+
+#endif // VMICORE_BATCHREADENTRY_H
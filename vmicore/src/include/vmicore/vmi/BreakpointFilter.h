@@ -0,0 +1,67 @@
+#ifndef VMICORE_BREAKPOINTFILTER_H
+#define VMICORE_BREAKPOINTFILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VmiCore
+{
+    /// Registers that can be referred to by a FilterCondition. See IRegisterReadable.
+    enum class FilterRegister
+    {
+        Rax,
+        Rbx,
+        Rcx,
+        Rdx,
+        Rdi,
+        R8,
+        R9,
+        Rip,
+        Rsp,
+        Cr3,
+        Gs,
+    };
+
+    /// Unsigned comparisons of the masked operand against the value of a FilterCondition.
+    enum class FilterComparison
+    {
+        Equal,
+        NotEqual,
+        Below,
+        AboveOrEqual,
+    };
+
+    /**
+     * A single comparison within a BreakpointFilter. The operand is either the content of the given register or, if
+     * a memory read size is set, the guest memory at the register content plus the offset. Memory is read within the
+     * address space of the interrupted context.
+     */
+    struct FilterCondition
+    {
+        FilterRegister reg;
+        /// Number of bytes to read from guest memory, either 1, 4 or 8. Zero compares the register content itself.
+        uint8_t memoryReadSize = 0;
+        /// Added to the register content in order to obtain the address to read from.
+        int64_t offset = 0;
+        /// Applied to the operand before comparing it, e.g. in order to test single flags.
+        uint64_t mask = ~0ULL;
+        FilterComparison comparison = FilterComparison::Equal;
+        uint64_t value = 0;
+    };
+
+    /**
+     * A predicate that VMICore evaluates on every hit of a breakpoint before invoking its callback. Hits are only
+     * delivered to the callback if all conditions hold. Conditions are evaluated in order and evaluation stops at the
+     * first one that does not hold, hence register comparisons should precede memory reads. If a memory read fails,
+     * the hit is delivered, as the filter is unable to decide.
+     */
+    struct BreakpointFilter
+    {
+        static constexpr std::size_t maxConditions = 8;
+
+        std::vector<FilterCondition> conditions;
+    };
+}
+
+#endif // VMICORE_BREAKPOINTFILTER_H
@@ -0,0 +1,35 @@
+#ifndef VMICORE_BREAKPOINTSPEC_H
+#define VMICORE_BREAKPOINTSPEC_H
+
+#include "../types.h"
+#include "BpResponse.h"
+#include "BreakpointFilter.h"
+#include "IBreakpoint.h"
+#include "events/IInterruptEvent.h"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace VmiCore
+{
+    /**
+     * Describes a single breakpoint of a bulk request. See PluginInterface::createBreakpoints.
+     */
+    struct BreakpointSpec
+    {
+        /// Guest virtual address to place the breakpoint on.
+        addr_t targetVA;
+        /// Called whenever the breakpoint is hit.
+        std::function<BpResponse(IInterruptEvent&)> callbackFunction;
+        /// Hits for which the filter does not hold are not delivered to the callback function.
+        std::optional<BreakpointFilter> filter{};
+        /// Will be set by the bulk request to the created breakpoint. Remains empty if this particular breakpoint
+        /// could not be created.
+        std::shared_ptr<IBreakpoint> breakpoint{};
+        /// Will be set by the bulk request to the reason why the breakpoint could not be created.
+        std::string error{};
+    };
+}
+
+#endif // VMICORE_BREAKPOINTSPEC_H
@@ -3,9 +3,11 @@
 
 #include "../os/OperatingSystem.h"
 #include "../types.h"
+#include "BatchReadEntry.h"
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -33,9 +35,31 @@ namespace VmiCore
 
         [[nodiscard]] virtual uint64_t readVA(addr_t virtualAddress, addr_t dtb, std::size_t size) = 0;
 
+        /**
+         * Non-throwing counterparts of the read functions above. Paged out guest memory is common, so these should
+         * be preferred on hot paths where failing reads are expected and handled by the caller anyway.
+         *
+         * @return The value read or std::nullopt if the address is not accessible.
+         */
+        [[nodiscard]] virtual std::optional<uint8_t> tryRead8VA(addr_t virtualAddress, addr_t cr3) = 0;
+
+        [[nodiscard]] virtual std::optional<uint32_t> tryRead32VA(addr_t virtualAddress, addr_t cr3) = 0;
+
+        [[nodiscard]] virtual std::optional<uint64_t> tryRead64VA(addr_t virtualAddress, addr_t cr3) = 0;
+
         [[nodiscard]] virtual bool
         readXVA(addr_t virtualAddress, addr_t cr3, std::vector<uint8_t>& content, std::size_t size) = 0;
 
+        /**
+         * Performs multiple reads within a single round trip. Entries are grouped by page internally, so reading
+         * several fields of the same structure only costs one access to guest memory. A failing entry does not abort
+         * the remaining reads.
+         *
+         * @param entries Reads to perform. The success flag of each entry will be updated accordingly.
+         * @return True if all reads have been successful, false otherwise.
+         */
+        [[nodiscard]] virtual bool readBatch(std::span<BatchReadEntry> entries) = 0;
+
         [[nodiscard]] virtual uint64_t getCurrentVmId() = 0;
 
         [[nodiscard]] virtual uint getNumberOfVCPUs() const = 0;
@@ -55,11 +79,12 @@ namespace VmiCore
 
         [[nodiscard]] virtual std::unique_ptr<std::string> extractUnicodeStringAtVA(addr_t stringVA, addr_t cr3) = 0;
 
-        [[nodiscard]] virtual std::optional<std::unique_ptr<std::string>> tryExtractUnicodeStringAtVA(addr_t stringVA,
-                                                                                                      addr_t cr3) = 0;
+        [[nodiscard]] virtual std::optional<std::string> tryExtractUnicodeStringAtVA(addr_t stringVA, addr_t cr3) = 0;
 
         [[nodiscard]] virtual std::unique_ptr<std::string> extractStringAtVA(addr_t virtualAddress, addr_t cr3) = 0;
 
+        [[nodiscard]] virtual std::optional<std::string> tryExtractStringAtVA(addr_t virtualAddress, addr_t cr3) = 0;
+
         [[nodiscard]] virtual OperatingSystem getOsType() = 0;
 
         [[nodiscard]] virtual uint16_t getWindowsBuild() = 0;
@@ -30,6 +30,11 @@ namespace VmiCore
          */
         [[nodiscard]] virtual addr_t getOffset() const = 0;
 
+        /**
+         * Retrieve the id of the vCPU that has hit the breakpoint.
+         */
+        [[nodiscard]] virtual uint32_t getVcpuId() const = 0;
+
       protected:
         IInterruptEvent() = default;
     };
@@ -1,4 +1,8 @@
 #include "GlobalControl.h"
+#include <atomic>
+#include <csignal>
+#include <pthread.h>
+#include <stdexcept>
 
 namespace VmiCore
 {
@@ -6,6 +10,16 @@ namespace VmiCore
     {
         std::unique_ptr<ILogger> staticLogger;
         std::shared_ptr<IEventStream> staticEventStream;
+        LatencyHistograms staticLatencyHistograms;
+
+        // libvmi does not expose the descriptor it waits on, so a blocking wait is interrupted by a signal instead of
+        // watching an additional eventfd. Waits that have not been entered yet when the signal arrives still end
+        // after their timeout at the latest.
+        constexpr int wakeupSignal = SIGUSR1;
+        std::atomic<bool> eventLoopRegistered = false;
+        std::atomic<pthread_t> eventLoopThread{};
+
+        void wakeupHandler([[maybe_unused]] int signal) {}
     }
 
     namespace GlobalControl
@@ -31,12 +45,45 @@ namespace VmiCore
             throw std::runtime_error("No Eventstream present");
         }
 
+        LatencyHistograms& latencyHistograms()
+        {
+            return staticLatencyHistograms;
+        }
+
         void init(std::unique_ptr<ILogger> logger, std::shared_ptr<IEventStream> eventStream)
         {
             staticLogger = std::move(logger);
             staticEventStream = std::move(eventStream);
         }
 
+        void requestShutdown()
+        {
+            endVmi = true;
+            if (eventLoopRegistered && pthread_equal(pthread_self(), eventLoopThread) == 0)
+            {
+                pthread_kill(eventLoopThread, wakeupSignal);
+            }
+        }
+
+        void registerEventLoopThread()
+        {
+            struct sigaction sigactionStruct{};
+            sigactionStruct.sa_handler = &wakeupHandler;
+            // Waits for events are interrupted regardless, but all other system calls of callbacks are resumed
+            sigactionStruct.sa_flags = SA_RESTART;
+            if (sigaction(wakeupSignal, &sigactionStruct, nullptr) != 0)
+            {
+                throw std::runtime_error("Unable to register event loop wakeup handler.");
+            }
+            eventLoopThread = pthread_self();
+            eventLoopRegistered = true;
+        }
+
+        void unregisterEventLoopThread()
+        {
+            eventLoopRegistered = false;
+        }
+
         void uninit()
         {
             staticLogger.reset();
@@ -2,6 +2,7 @@
 #define VMICORE_GLOBALCONTROL_H
 
 #include "io/IEventStream.h"
+#include "vmi/LatencyHistogram.h"
 #include <memory>
 #include <vmicore/io/ILogger.h>
 
@@ -13,7 +14,26 @@ namespace VmiCore::GlobalControl
     const std::unique_ptr<ILogger>& logger();
     const std::shared_ptr<IEventStream>& eventStream();
 
+    /**
+     * Latency histograms of the event loop and all event callbacks. Disabled unless configured otherwise.
+     */
+    LatencyHistograms& latencyHistograms();
+
     void init(std::unique_ptr<ILogger> logger, std::shared_ptr<IEventStream> eventStream);
+
+    /**
+     * Ends the analysis. Safe to be called from any thread as well as from signal handlers. If the event loop thread
+     * is blocked while waiting for events, the wait is interrupted right away.
+     */
+    void requestShutdown();
+
+    /**
+     * Registers the calling thread as the event loop thread that is woken up by requestShutdown.
+     */
+    void registerEventLoopThread();
+
+    void unregisterEventLoopThread();
+
     void uninit();
 }
 
@@ -1,10 +1,12 @@
 #include "VmiHub.h"
 #include "GlobalControl.h"
 #include "os/linux/ActiveProcessesSupervisor.h"
+#include "os/linux/Constants.h"
 #include "os/linux/SystemEventSupervisor.h"
 #include "os/windows/ActiveProcessesSupervisor.h"
 #include "os/windows/SystemEventSupervisor.h"
 #include "plugins/PluginException.h"
+#include <chrono>
 #include <csignal>
 #include <memory>
 #include <utility>
@@ -16,6 +18,10 @@ namespace VmiCore
     {
         int exitCode = 0;
         constexpr auto loggerName = FILENAME_STEM;
+        // Shutdown requests usually interrupt the wait right away. The timeout bounds the shutdown latency for requests
+        // that arrive right before the wait is entered.
+        constexpr int idleWaitTimeoutMs = 500;
+        constexpr auto latencyHistogramsFileName = "latency_histograms.txt";
     }
 
     VmiHub::VmiHub(std::shared_ptr<IConfigParser> configInterface,
@@ -40,28 +46,40 @@ namespace VmiCore
     {
         // TODO: only set postRunPluginAction to true after sample process is started
         GlobalControl::postRunPluginAction = true;
-#ifdef TRACE_MODE
-        auto loopStart = std::chrono::steady_clock::now();
-#endif
+        auto& latencyHistograms = GlobalControl::latencyHistograms();
+        auto& waitLatency = latencyHistograms.get("eventLoop.wait");
+        auto& drainLatency = latencyHistograms.get("eventLoop.drain");
+        auto dumpInterval = configInterface->getLatencyHistogramDumpInterval();
+        auto nextDump = std::chrono::steady_clock::now() + dumpInterval;
+        GlobalControl::registerEventLoopThread();
         while (!GlobalControl::endVmi)
         {
             try
             {
-#ifdef TRACE_MODE
-                auto callStart = std::chrono::steady_clock::now();
-                vmiInterface->waitForEvent();
-                auto currentTime = std::chrono::steady_clock::now();
-                auto callDuration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - callStart);
-                auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - loopStart);
-                logger->debug(
-                    "Event loop call",
-                    {{"durationMilliseconds", callDuration.count()}, {"totalElapsedTimeSeconds", elapsedTime.count()}});
-#else
-                vmiInterface->eventsListen(500);
-#endif
+                {
+                    ScopedLatency measurement(waitLatency);
+                    // Narrows the window in which a shutdown request cannot interrupt the wait anymore
+                    if (GlobalControl::endVmi)
+                    {
+                        break;
+                    }
+                    vmiInterface->eventsListen(idleWaitTimeoutMs);
+                }
+                // Drain bursts of events without going back to a blocking wait in between
+                while (!GlobalControl::endVmi && vmiInterface->areEventsPending())
+                {
+                    ScopedLatency measurement(drainLatency);
+                    vmiInterface->eventsListen(0);
+                }
             }
             catch (const std::exception& e)
             {
+                if (GlobalControl::endVmi)
+                {
+                    // The wait has been interrupted by a shutdown request
+                    logger->debug("Event loop interrupted during shutdown", {{"exception", e.what()}});
+                    break;
+                }
                 logger->error("Error while waiting for events", {{"exception", e.what()}});
                 eventStream->sendErrorEvent(e.what());
                 logger->info("Trying to get the VM state");
@@ -69,6 +87,91 @@ namespace VmiCore
                 exitCode = 1;
                 GlobalControl::endVmi = true;
             }
+
+            if (latencyHistograms.isEnabled() && dumpInterval.count() > 0 &&
+                std::chrono::steady_clock::now() >= nextDump)
+            {
+                writeLatencyHistograms();
+                nextDump = std::chrono::steady_clock::now() + dumpInterval;
+            }
+        }
+        GlobalControl::unregisterEventLoopThread();
+    }
+
+    bool VmiHub::startMonitoring(IPluginSystem& plugins,
+                                 ISystemEventSupervisor& systemEvents,
+                                 IActiveProcessesSupervisor& activeProcesses,
+                                 const std::map<std::string, std::vector<std::string>, std::less<>>& pluginArgs)
+    {
+        // Plugin initialization does not depend on the guest state, so lengthy work like compiling rules does not
+        // stall the guest
+        try
+        {
+            plugins.loadPlugins();
+            plugins.initializePlugins(pluginArgs);
+        }
+        catch (const PluginException& e)
+        {
+            logger->error("Failed to initialize plugin", {{"Plugin", e.plugin()}, {"Exception", e.what()}});
+            eventStream->sendErrorEvent(e.what());
+            return false;
+        }
+
+        // Only walking the process list and placing the system breakpoints require a consistent guest state
+        auto pauseStart = std::chrono::steady_clock::now();
+        vmiInterface->pauseVm();
+        systemEvents.initialize();
+        vmiInterface->resumeVm();
+        logPauseDuration(std::chrono::steady_clock::now() - pauseStart);
+
+        // Process events are serviced in between, so that no vCPU is held back at a system breakpoint for longer than
+        // the extraction of a single process takes
+        while (activeProcesses.extractNextDiscoveredProcess())
+        {
+            if (vmiInterface->areEventsPending())
+            {
+                vmiInterface->eventsListen(0);
+            }
+        }
+
+        try
+        {
+            plugins.startPlugins();
+        }
+        catch (const PluginException& e)
+        {
+            logger->error("Failed to start plugin", {{"Plugin", e.plugin()}, {"Exception", e.what()}});
+            eventStream->sendErrorEvent(e.what());
+            vmiInterface->pauseVm();
+            systemEvents.teardown();
+            vmiInterface->resumeVm();
+            return false;
+        }
+
+        return true;
+    }
+
+    void VmiHub::logPauseDuration(std::chrono::steady_clock::duration pauseDuration) const
+    {
+        auto pauseDurationNs =
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(pauseDuration).count());
+        logger->info("Guest paused for initialization", {{"pauseDurationNs", pauseDurationNs}});
+        if (auto& pauseLatency = GlobalControl::latencyHistograms().get("startup.pause"); pauseLatency.isEnabled())
+        {
+            pauseLatency.record(pauseDurationNs);
+        }
+    }
+
+    void VmiHub::writeLatencyHistograms() const
+    {
+        try
+        {
+            GlobalControl::latencyHistograms().writeTo(configInterface->getResultsDirectory() /
+                                                       latencyHistogramsFileName);
+        }
+        catch (const std::exception& e)
+        {
+            logger->warning("Unable to write latency histograms", {{"exception", e.what()}});
         }
     }
 
@@ -103,7 +206,7 @@ namespace VmiCore
     {
         exitCode = 128 + signal;
         logReceivedSignal(signal);
-        GlobalControl::endVmi = true;
+        GlobalControl::requestShutdown();
     }
 
     void setupSignalHandling()
@@ -124,6 +227,7 @@ namespace VmiCore
 
     uint VmiHub::run(const std::map<std::string, std::vector<std::string>, std::less<>>& pluginArgs)
     {
+        GlobalControl::latencyHistograms().setEnabled(configInterface->areLatencyHistogramsEnabled());
         vmiInterface->initializeVmi();
         std::shared_ptr<IActiveProcessesSupervisor> activeProcessesSupervisor;
         std::shared_ptr<IInterruptEventSupervisor> interruptEventSupervisor;
@@ -131,10 +235,19 @@ namespace VmiCore
         {
             case OperatingSystem::LINUX:
             {
-                activeProcessesSupervisor =
-                    std::make_shared<Linux::ActiveProcessesSupervisor>(vmiInterface, loggingLib, eventStream);
+                auto kernelAddressSpace = std::make_shared<KernelAddressSpace>(
+                    vmiInterface, vmiInterface->convertPidToDtb(Linux::SYSTEM_PID));
+                auto kernelOffsets =
+                    std::make_shared<const Linux::KernelOffsets>(Linux::KernelOffsets::init(vmiInterface));
+                activeProcessesSupervisor = std::make_shared<Linux::ActiveProcessesSupervisor>(
+                    vmiInterface, kernelAddressSpace, kernelOffsets, loggingLib, eventStream);
                 interruptEventSupervisor = std::make_shared<InterruptEventSupervisor>(
-                    vmiInterface, singleStepSupervisor, activeProcessesSupervisor, contextSwitchHandler, loggingLib);
+                    vmiInterface,
+                    singleStepSupervisor,
+                    activeProcessesSupervisor,
+                    contextSwitchHandler,
+                    loggingLib,
+                    configInterface->getBreakpointMode());
 
                 pluginSystem = std::make_shared<PluginSystem>(configInterface,
                                                               vmiInterface,
@@ -155,11 +268,18 @@ namespace VmiCore
             }
             case OperatingSystem::WINDOWS:
             {
-                auto kernelObjectExtractor = std::make_shared<Windows::KernelAccess>(vmiInterface);
+                auto kernelAddressSpace = std::make_shared<KernelAddressSpace>(
+                    vmiInterface, vmiInterface->convertPidToDtb(Windows::SYSTEM_PID));
+                auto kernelObjectExtractor = std::make_shared<Windows::KernelAccess>(vmiInterface, kernelAddressSpace);
                 activeProcessesSupervisor = std::make_shared<Windows::ActiveProcessesSupervisor>(
-                    vmiInterface, kernelObjectExtractor, loggingLib, eventStream);
+                    vmiInterface, kernelAddressSpace, kernelObjectExtractor, loggingLib, eventStream);
                 interruptEventSupervisor = std::make_shared<InterruptEventSupervisor>(
-                    vmiInterface, singleStepSupervisor, activeProcessesSupervisor, contextSwitchHandler, loggingLib);
+                    vmiInterface,
+                    singleStepSupervisor,
+                    activeProcessesSupervisor,
+                    contextSwitchHandler,
+                    loggingLib,
+                    configInterface->getBreakpointMode());
                 pluginSystem = std::make_shared<PluginSystem>(configInterface,
                                                               vmiInterface,
                                                               activeProcessesSupervisor,
@@ -182,26 +302,16 @@ namespace VmiCore
             }
         }
 
-        vmiInterface->pauseVm();
-        systemEventSupervisor->initialize();
-        try
+        if (!startMonitoring(*pluginSystem, *systemEventSupervisor, *activeProcessesSupervisor, pluginArgs))
         {
-            pluginSystem->initializePlugins(pluginArgs);
-            vmiInterface->resumeVm();
-
-            eventStream->sendReadyEvent();
-
-            setupSignalHandling();
-            waitForEvents();
-
-            vmiInterface->pauseVm();
-        }
-        catch (const PluginException& e)
-        {
-            logger->error("Failed to initialize plugin", {{"Plugin", e.plugin()}, {"Exception", e.what()}});
-            eventStream->sendErrorEvent(e.what());
+            return exitCode;
         }
 
+        eventStream->sendReadyEvent();
+        setupSignalHandling();
+        waitForEvents();
+
+        vmiInterface->pauseVm();
         if (GlobalControl::postRunPluginAction)
         {
             pluginSystem->unloadPlugins();
@@ -209,6 +319,11 @@ namespace VmiCore
         systemEventSupervisor->teardown();
         vmiInterface->resumeVm();
 
+        if (GlobalControl::latencyHistograms().isEnabled())
+        {
+            writeLatencyHistograms();
+        }
+
         return exitCode;
     }
 }
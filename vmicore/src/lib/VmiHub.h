@@ -4,12 +4,14 @@
 #include "config/IConfigParser.h"
 #include "io/IEventStream.h"
 #include "io/ILogging.h"
+#include "os/IActiveProcessesSupervisor.h"
 #include "os/ISystemEventSupervisor.h"
 #include "plugins/PluginSystem.h"
 #include "vmi/InterruptEventSupervisor.h"
 #include "vmi/LibvmiInterface.h"
 #include "vmi/RegisterEventSupervisor.h"
 #include "vmicore/io/ILogger.h"
+#include <chrono>
 #include <functional> // std::equal_to
 #include <map>
 #include <memory>
@@ -29,6 +31,18 @@ namespace VmiCore
 
         uint run(const std::map<std::string, std::vector<std::string>, std::less<>>& pluginArgs);
 
+        /**
+         * Initializes the plugins before pausing the guest. Only the monitoring of system events is set up while the
+         * guest is paused. Afterwards, the running processes are extracted and the plugins are started, while process
+         * events are already being handled.
+         *
+         * @return False if any plugin has failed, in which case the monitoring has been torn down again.
+         */
+        bool startMonitoring(IPluginSystem& plugins,
+                             ISystemEventSupervisor& systemEvents,
+                             IActiveProcessesSupervisor& activeProcesses,
+                             const std::map<std::string, std::vector<std::string>, std::less<>>& pluginArgs);
+
       private:
         std::shared_ptr<IConfigParser> configInterface;
         std::shared_ptr<ILibvmiInterface> vmiInterface;
@@ -42,6 +56,10 @@ namespace VmiCore
         std::shared_ptr<IRegisterEventSupervisor> contextSwitchHandler;
 
         void waitForEvents() const;
+
+        void logPauseDuration(std::chrono::steady_clock::duration pauseDuration) const;
+
+        void writeLatencyHistograms() const;
     };
 }
 
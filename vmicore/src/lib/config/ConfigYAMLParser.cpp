@@ -1,9 +1,27 @@
 #include "ConfigYAMLParser.h"
 #include "PluginConfig.h"
+#include <fmt/core.h>
 #include <iostream>
+#include <vmicore/vmi/VmiException.h>
 
 namespace VmiCore
 {
+    namespace
+    {
+        BreakpointMode parseBreakpointMode(const std::string& breakpointMode)
+        {
+            if (breakpointMode == "single_step")
+            {
+                return BreakpointMode::SingleStep;
+            }
+            if (breakpointMode == "emulate")
+            {
+                return BreakpointMode::Emulate;
+            }
+            throw VmiException(fmt::format("{}: Unknown breakpoint mode {}", __func__, breakpointMode));
+        }
+    }
+
     void ConfigYAMLParser::extractConfiguration(const std::filesystem::path& configurationPath)
     {
         configRootNode = YAML::LoadFile(configurationPath);
@@ -15,6 +33,28 @@ namespace VmiCore
             configuration.socketPath = configRootNode["vm"]["socket"].as<std::string>();
         }
         configuration.offsetsFile = configRootNode["vm"]["offsets_file"].as<std::string>();
+        if (configRootNode["vm"]["mapping_pool_budget"].IsDefined())
+        {
+            configuration.mappingPoolBudget = configRootNode["vm"]["mapping_pool_budget"].as<std::size_t>();
+        }
+        if (configRootNode["vm"]["breakpoint_mode"].IsDefined())
+        {
+            configuration.breakpointMode =
+                parseBreakpointMode(configRootNode["vm"]["breakpoint_mode"].as<std::string>());
+        }
+        if (configRootNode["vm"]["memory_dump"].IsDefined())
+        {
+            configuration.memoryDumpPath = configRootNode["vm"]["memory_dump"].as<std::string>();
+        }
+        if (configRootNode["latency_histograms"].IsDefined())
+        {
+            configuration.latencyHistogramsEnabled = true;
+            if (configRootNode["latency_histograms"]["dump_interval"].IsDefined())
+            {
+                configuration.latencyHistogramDumpInterval =
+                    std::chrono::seconds(configRootNode["latency_histograms"]["dump_interval"].as<uint64_t>());
+            }
+        }
         configuration.pluginDirectory = configRootNode["plugin_system"]["directory"].as<std::string>();
 
         for (const auto& node : configRootNode["plugin_system"]["plugins"])
@@ -70,6 +110,56 @@ namespace VmiCore
         return configuration.offsetsFile;
     }
 
+    std::size_t ConfigYAMLParser::getMappingPoolBudget() const
+    {
+        return configuration.mappingPoolBudget;
+    }
+
+    BreakpointMode ConfigYAMLParser::getBreakpointMode() const
+    {
+        return configuration.breakpointMode;
+    }
+
+    std::filesystem::path ConfigYAMLParser::getMemoryDumpPath() const
+    {
+        return configuration.memoryDumpPath;
+    }
+
+    void ConfigYAMLParser::setMemoryDumpPath(const std::filesystem::path& memoryDumpPath)
+    {
+        configuration.memoryDumpPath = memoryDumpPath;
+    }
+
+    std::filesystem::path ConfigYAMLParser::getEventRecordingPath() const
+    {
+        return configuration.eventRecordingPath;
+    }
+
+    void ConfigYAMLParser::setEventRecordingPath(const std::filesystem::path& eventRecordingPath)
+    {
+        configuration.eventRecordingPath = eventRecordingPath;
+    }
+
+    std::filesystem::path ConfigYAMLParser::getEventReplayPath() const
+    {
+        return configuration.eventReplayPath;
+    }
+
+    void ConfigYAMLParser::setEventReplayPath(const std::filesystem::path& eventReplayPath)
+    {
+        configuration.eventReplayPath = eventReplayPath;
+    }
+
+    bool ConfigYAMLParser::areLatencyHistogramsEnabled() const
+    {
+        return configuration.latencyHistogramsEnabled;
+    }
+
+    std::chrono::seconds ConfigYAMLParser::getLatencyHistogramDumpInterval() const
+    {
+        return configuration.latencyHistogramDumpInterval;
+    }
+
     std::filesystem::path ConfigYAMLParser::getPluginDirectory() const
     {
         return configuration.pluginDirectory;
@@ -31,12 +31,36 @@ namespace VmiCore
 
         [[nodiscard]] std::string getOffsetsFile() const override;
 
+        [[nodiscard]] std::size_t getMappingPoolBudget() const override;
+
+        [[nodiscard]] BreakpointMode getBreakpointMode() const override;
+
+        [[nodiscard]] std::filesystem::path getMemoryDumpPath() const override;
+
+        void setMemoryDumpPath(const std::filesystem::path& memoryDumpPath) override;
+
+        [[nodiscard]] std::filesystem::path getEventRecordingPath() const override;
+
+        void setEventRecordingPath(const std::filesystem::path& eventRecordingPath) override;
+
+        [[nodiscard]] std::filesystem::path getEventReplayPath() const override;
+
+        void setEventReplayPath(const std::filesystem::path& eventReplayPath) override;
+
+        [[nodiscard]] bool areLatencyHistogramsEnabled() const override;
+
+        [[nodiscard]] std::chrono::seconds getLatencyHistogramDumpInterval() const override;
+
         [[nodiscard]] std::filesystem::path getPluginDirectory() const override;
 
         [[nodiscard]] const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&
         getPlugins() const override;
 
       private:
+        // Bytes of guest memory that may be kept mapped for reuse by plugins. Pooling is opt-in, as pooled mappings do
+        // not reflect page table changes after they have been created.
+        static constexpr std::size_t defaultMappingPoolBudget = 0;
+
         using vmiConfiguration = struct configuration_t
         {
             std::filesystem::path resultsDirectory;
@@ -44,6 +68,13 @@ namespace VmiCore
             std::string vmName;
             std::filesystem::path socketPath;
             std::string offsetsFile;
+            std::size_t mappingPoolBudget = defaultMappingPoolBudget;
+            BreakpointMode breakpointMode = BreakpointMode::SingleStep;
+            std::filesystem::path memoryDumpPath;
+            std::filesystem::path eventRecordingPath;
+            std::filesystem::path eventReplayPath;
+            bool latencyHistogramsEnabled = false;
+            std::chrono::seconds latencyHistogramDumpInterval{0};
             std::filesystem::path pluginDirectory;
             std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>> plugins{};
         };
@@ -1,6 +1,9 @@
 #ifndef VMICORE_CONFIGPARSER_H
 #define VMICORE_CONFIGPARSER_H
 
+#include "../vmi/BreakpointMode.h"
+#include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <map>
 #include <memory>
@@ -34,6 +37,42 @@ namespace VmiCore
 
         [[nodiscard]] virtual std::string getOffsetsFile() const = 0;
 
+        [[nodiscard]] virtual std::size_t getMappingPoolBudget() const = 0;
+
+        [[nodiscard]] virtual BreakpointMode getBreakpointMode() const = 0;
+
+        /**
+         * @return Path to a raw physical memory dump to analyze instead of a running VM or an empty path.
+         */
+        [[nodiscard]] virtual std::filesystem::path getMemoryDumpPath() const = 0;
+
+        virtual void setMemoryDumpPath(const std::filesystem::path& memoryDumpPath) = 0;
+
+        /**
+         * @return Path of the trace file all events of a live VM are recorded to or an empty path.
+         */
+        [[nodiscard]] virtual std::filesystem::path getEventRecordingPath() const = 0;
+
+        virtual void setEventRecordingPath(const std::filesystem::path& eventRecordingPath) = 0;
+
+        /**
+         * @return Path of a previously recorded trace file to replay on top of the memory dump or an empty path.
+         */
+        [[nodiscard]] virtual std::filesystem::path getEventReplayPath() const = 0;
+
+        virtual void setEventReplayPath(const std::filesystem::path& eventReplayPath) = 0;
+
+        /**
+         * @return Whether latency histograms of the event loop and all event callbacks are recorded.
+         */
+        [[nodiscard]] virtual bool areLatencyHistogramsEnabled() const = 0;
+
+        /**
+         * @return Interval in which latency histograms are written to the results directory. Zero means they are only
+         * written at shutdown.
+         */
+        [[nodiscard]] virtual std::chrono::seconds getLatencyHistogramDumpInterval() const = 0;
+
         [[nodiscard]] virtual std::filesystem::path getPluginDirectory() const = 0;
 
         [[nodiscard]] virtual const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&
@@ -13,8 +13,21 @@ namespace VmiCore
       public:
         virtual ~IActiveProcessesSupervisor() = default;
 
+        /**
+         * Walks the process list of the guest, which requires the guest to be paused. Apart from the system process,
+         * discovered processes are only recorded, their information is extracted by extractNextDiscoveredProcess.
+         */
         virtual void initialize() = 0;
 
+        /**
+         * Extracts the information of the next process recorded by initialize. Intended to be called while the guest
+         * is running and process events are handled in between. Processes that have been added or removed by such an
+         * event in the meantime are not extracted anymore, neither are processes that cannot be extracted.
+         *
+         * @return False if no recorded process is left.
+         */
+        virtual bool extractNextDiscoveredProcess() = 0;
+
         [[nodiscard]] virtual std::shared_ptr<ActiveProcessInformation> getSystemProcessInformation() const = 0;
 
         [[nodiscard]] virtual std::shared_ptr<ActiveProcessInformation> getProcessInformationByPid(pid_t pid) const = 0;
@@ -10,13 +10,17 @@ namespace VmiCore::Linux
 {
     ActiveProcessesSupervisor::ActiveProcessesSupervisor(
         std::shared_ptr<ILibvmiInterface> vmiInterface,
+        std::shared_ptr<KernelAddressSpace> kernelAddressSpace,
+        std::shared_ptr<const KernelOffsets> kernelOffsets,
         std::shared_ptr<ILogging> loggingLib, // NOLINT(performance-unnecessary-value-param)
         std::shared_ptr<IEventStream> eventStream)
-        : vmiInterface(vmiInterface),
+        : vmiInterface(std::move(vmiInterface)),
+          kernelAddressSpace(kernelAddressSpace),
+          kernelOffsets(kernelOffsets),
           logging(loggingLib),
           logger(loggingLib->newNamedLogger(FILENAME_STEM)),
           eventStream(std::move(eventStream)),
-          pathExtractor(std::move(vmiInterface), loggingLib)
+          pathExtractor(std::move(kernelAddressSpace), std::move(kernelOffsets), loggingLib)
     {
     }
 
@@ -28,25 +32,48 @@ namespace VmiCore::Linux
             // Check if kernel page table isolation is enabled
             auto x86CapabilityOffset = vmiInterface->getKernelStructOffset("cpuinfo_x86", "x86_capability");
             // X86_FEATURE_PTI is defined as 7*32+11
-            auto x86CapabilityEntry = vmiInterface->read32VA(vmiInterface->translateKernelSymbolToVA("boot_cpu_data") +
-                                                                 x86CapabilityOffset + PTI_FEATURE_ARRAY_ENTRY_OFFSET,
-                                                             vmiInterface->convertPidToDtb(SYSTEM_PID));
+            auto x86CapabilityEntry = kernelAddressSpace->read32(
+                vmiInterface->translateKernelSymbolToVA("boot_cpu_data") + x86CapabilityOffset +
+                PTI_FEATURE_ARRAY_ENTRY_OFFSET);
             pti = x86CapabilityEntry & PTI_FEATURE_MASK;
         }
 
         logger->info("--- Initialization ---");
-        auto taskOffset = vmiInterface->getOffset("linux_tasks");
+        auto taskOffset = kernelOffsets->taskStruct.tasks;
         auto initTaskVA = vmiInterface->translateKernelSymbolToVA("init_task") + taskOffset;
         auto currentListEntry = initTaskVA;
         logger->debug("Got VA of initTask", {{"initTaskVA", fmt::format("{:#x}", currentListEntry)}});
 
-        do
+        // The system process is needed for setting up the kernel breakpoints while the guest is still paused
+        addNewProcess(initTaskVA - taskOffset);
+        currentListEntry = kernelAddressSpace->read64(currentListEntry);
+        while (currentListEntry != initTaskVA)
         {
-            addNewProcess(currentListEntry - taskOffset);
-            currentListEntry = vmiInterface->read64VA(currentListEntry, vmiInterface->convertPidToDtb(SYSTEM_PID));
-        } while (currentListEntry != initTaskVA);
+            discoveredTaskStructs.push_back(currentListEntry - taskOffset);
+            currentListEntry = kernelAddressSpace->read64(currentListEntry);
+        }
 
-        logger->info("--- End of Initialization ---");
+        logger->info("--- End of Initialization ---", {{"discoveredProcesses", discoveredTaskStructs.size() + 1}});
+    }
+
+    bool ActiveProcessesSupervisor::extractNextDiscoveredProcess()
+    {
+        if (discoveredTaskStructs.empty())
+        {
+            return false;
+        }
+        auto taskStruct = discoveredTaskStructs.front();
+        discoveredTaskStructs.pop_front();
+        try
+        {
+            addNewProcess(taskStruct);
+        }
+        catch (const std::exception& e)
+        {
+            logger->warning("Unable to extract discovered process",
+                            {{"task_struct", fmt::format("{:#x}", taskStruct)}, {"exception", e.what()}});
+        }
+        return true;
     }
 
     std::unique_ptr<ActiveProcessInformation> ActiveProcessesSupervisor::extractProcessInformation(uint64_t taskStruct)
@@ -54,40 +81,33 @@ namespace VmiCore::Linux
         auto processInformation = std::make_unique<ActiveProcessInformation>();
         processInformation->base = taskStruct;
 
-        auto mm = vmiInterface->read64VA(taskStruct + vmiInterface->getKernelStructOffset("task_struct", "mm"),
-                                         vmiInterface->convertPidToDtb(SYSTEM_PID));
+        auto mm = kernelAddressSpace->read64(taskStruct + kernelOffsets->taskStruct.mm);
         if (mm != 0)
         {
             processInformation->processDtb =
-                vmiInterface->convertVAToPA(vmiInterface->read64VA(mm + vmiInterface->getOffset("linux_pgd"),
-                                                                   vmiInterface->convertPidToDtb(SYSTEM_PID)),
-                                            vmiInterface->convertPidToDtb(SYSTEM_PID));
+                kernelAddressSpace->convertToPA(kernelAddressSpace->read64(mm + kernelOffsets->mmStruct.pgd));
             processInformation->processUserDtb =
                 pti ? processInformation->processDtb + USER_DTB_OFFSET : processInformation->processDtb;
             processInformation->processPath = std::make_unique<std::string>(pathExtractor.extractDPath(
-                vmiInterface->read64VA(mm + vmiInterface->getKernelStructOffset("mm_struct", "exe_file"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID)) +
-                vmiInterface->getKernelStructOffset("file", "f_path")));
+                kernelAddressSpace->read64(mm + kernelOffsets->mmStruct.exe_file) + kernelOffsets->file.f_path));
             processInformation->fullName = processInformation->processPath
                                                ? splitProcessFileNameFromPath(*processInformation->processPath)
                                                : nullptr;
-            processInformation->memoryRegionExtractor = std::make_unique<MMExtractor>(vmiInterface, logging, mm);
+            processInformation->memoryRegionExtractor =
+                std::make_unique<MMExtractor>(kernelAddressSpace, kernelOffsets, logging, mm);
         }
 
         processInformation->pid = extractPid(taskStruct);
-        processInformation->parentPid = vmiInterface->read32VA(
-            vmiInterface->read64VA(taskStruct + vmiInterface->getKernelStructOffset("task_struct", "real_parent"),
-                                   vmiInterface->convertPidToDtb(SYSTEM_PID)) +
-                vmiInterface->getKernelStructOffset("task_struct", "tgid"),
-            vmiInterface->convertPidToDtb(SYSTEM_PID));
-        processInformation->name = *vmiInterface->extractStringAtVA(taskStruct + vmiInterface->getOffset("linux_name"),
-                                                                    vmiInterface->convertPidToDtb(SYSTEM_PID));
+        processInformation->parentPid = kernelAddressSpace->read32(
+            kernelAddressSpace->read64(taskStruct + kernelOffsets->taskStruct.real_parent) +
+            kernelOffsets->taskStruct.tgid);
+        processInformation->name = *kernelAddressSpace->extractString(taskStruct + kernelOffsets->taskStruct.comm);
 
         // Special case: The process with pid 0 only consists of idle threads and therefore has got no mm_struct. In
         // this case we simply use the kpgd that's already stored in libvmi.
         if (processInformation->pid == SYSTEM_PID)
         {
-            processInformation->processDtb = vmiInterface->convertPidToDtb(SYSTEM_PID);
+            processInformation->processDtb = kernelAddressSpace->getDtb();
             processInformation->processUserDtb = processInformation->processDtb;
         }
 
@@ -96,8 +116,7 @@ namespace VmiCore::Linux
 
     pid_t ActiveProcessesSupervisor::extractPid(uint64_t taskStruct) const
     {
-        return static_cast<pid_t>(vmiInterface->read32VA(taskStruct + vmiInterface->getOffset("linux_pid"),
-                                                         vmiInterface->convertPidToDtb(SYSTEM_PID)));
+        return static_cast<pid_t>(kernelAddressSpace->read32(taskStruct + kernelOffsets->taskStruct.pid));
     }
 
     std::shared_ptr<ActiveProcessInformation> ActiveProcessesSupervisor::getSystemProcessInformation() const
@@ -133,6 +152,8 @@ namespace VmiCore::Linux
 
     void ActiveProcessesSupervisor::addNewProcess(uint64_t taskStruct)
     {
+        // A discovered process may be subject to a process event before it has been extracted
+        std::erase(discoveredTaskStructs, taskStruct);
         std::shared_ptr<ActiveProcessInformation> processInformation(extractProcessInformation(taskStruct));
         std::string parentPid("unknownParentPid");
         std::string parentName("unknownParentName");
@@ -200,10 +221,18 @@ namespace VmiCore::Linux
                      {"ParentProcessId", parentPid},
                      {"ParentProcessDtb", parentDtb}});
 
+                // Page tables of terminated processes are freed and may be reused, so their translations are stale
+                vmiInterface->flushV2PCache(processInformationIterator->second->processDtb);
+                vmiInterface->flushV2PCache(processInformationIterator->second->processUserDtb);
                 processInformationByPid.erase(processInformationIterator);
             }
             pidsByTaskStruct.erase(taskStructIterator);
         }
+        else if (std::erase(discoveredTaskStructs, taskStruct) > 0)
+        {
+            logger->debug("Discovered process removed before its extraction",
+                          {{"taskStruct", fmt::format("{:#x}", taskStruct)}});
+        }
         else
         {
             logger->warning("Process does not seem to be stored as an active process",
@@ -235,8 +264,7 @@ namespace VmiCore::Linux
 
     std::tuple<int, int, int> ActiveProcessesSupervisor::extractKernelVersion() const
     {
-        auto banner = vmiInterface->extractStringAtVA(vmiInterface->translateKernelSymbolToVA("linux_banner"),
-                                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        auto banner = kernelAddressSpace->extractString(vmiInterface->translateKernelSymbolToVA("linux_banner"));
         logger->debug("Banner extracted", {{"Banner", *banner}});
 
         std::smatch matches;
@@ -5,7 +5,9 @@
 #include "../../io/ILogging.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "../IActiveProcessesSupervisor.h"
+#include "KernelOffsets.h"
 #include "PathExtractor.h"
+#include <deque>
 #include <map>
 #include <memory>
 #include <regex>
@@ -17,11 +19,15 @@ namespace VmiCore::Linux
     {
       public:
         ActiveProcessesSupervisor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                                  std::shared_ptr<KernelAddressSpace> kernelAddressSpace,
+                                  std::shared_ptr<const KernelOffsets> kernelOffsets,
                                   std::shared_ptr<ILogging> loggingLib,
                                   std::shared_ptr<IEventStream> eventStream);
 
         void initialize() override;
 
+        bool extractNextDiscoveredProcess() override;
+
         [[nodiscard]] std::shared_ptr<ActiveProcessInformation> getSystemProcessInformation() const override;
 
         [[nodiscard]] std::shared_ptr<ActiveProcessInformation> getProcessInformationByPid(pid_t pid) const override;
@@ -38,12 +44,15 @@ namespace VmiCore::Linux
 
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::shared_ptr<KernelAddressSpace> kernelAddressSpace;
+        std::shared_ptr<const KernelOffsets> kernelOffsets;
         std::shared_ptr<ILogging> logging;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<IEventStream> eventStream;
         PathExtractor pathExtractor;
         std::map<pid_t, std::shared_ptr<ActiveProcessInformation>> processInformationByPid;
         std::map<uint64_t, pid_t> pidsByTaskStruct;
+        std::deque<uint64_t> discoveredTaskStructs;
         std::regex kernelBannerVersionMatcher{R"(Linux version ([0-9]+)\.([0-9]+)\.([0-9]+))"};
         bool pti = false;
 
@@ -0,0 +1,82 @@
+#ifndef VMICORE_LINUX_KERNELOFFSETS_H
+#define VMICORE_LINUX_KERNELOFFSETS_H
+
+#include "../../vmi/LibvmiInterface.h"
+#include <memory>
+
+namespace VmiCore::Linux
+{
+    namespace KernelStructOffsets
+    {
+        using task_struct = struct task_struct
+        {
+            addr_t tasks;
+            addr_t mm;
+            addr_t pid;
+            addr_t tgid;
+            addr_t real_parent;
+            addr_t comm;
+        };
+
+        using mm_struct = struct mm_struct
+        {
+            addr_t pgd;
+            addr_t exe_file;
+        };
+
+        using vm_area_struct = struct vm_area_struct
+        {
+            addr_t vm_start;
+            addr_t vm_end;
+            addr_t vm_next;
+            addr_t vm_flags;
+            addr_t vm_file;
+        };
+
+        using file = struct file
+        {
+            addr_t f_path;
+        };
+
+        using path = struct path
+        {
+            addr_t mnt;
+            addr_t dentry;
+        };
+
+        using dentry = struct dentry
+        {
+            addr_t d_name;
+            addr_t d_parent;
+        };
+
+        using qstr = struct qstr
+        {
+            addr_t name;
+        };
+
+        using mount = struct mount
+        {
+            addr_t mnt;
+            addr_t mnt_mountpoint;
+            addr_t mnt_parent;
+        };
+    } // namespace KernelStructOffsets
+
+    class KernelOffsets
+    {
+      public:
+        static KernelOffsets init(const std::shared_ptr<ILibvmiInterface>& vmiInterface);
+
+        KernelStructOffsets::task_struct taskStruct{};
+        KernelStructOffsets::mm_struct mmStruct{};
+        KernelStructOffsets::vm_area_struct vmAreaStruct{};
+        KernelStructOffsets::file file{};
+        KernelStructOffsets::path path{};
+        KernelStructOffsets::dentry dentry{};
+        KernelStructOffsets::qstr qstr{};
+        KernelStructOffsets::mount mount{};
+    };
+}
+
+#endif // VMICORE_LINUX_KERNELOFFSETS_H
@@ -1,17 +1,18 @@
 #include "MMExtractor.h"
 #include "../PageProtection.h"
-#include "Constants.h"
 #include "ProtectionValues.h"
 #include <vmicore/filename.h>
 
 namespace VmiCore::Linux
 {
-    MMExtractor::MMExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+    MMExtractor::MMExtractor(std::shared_ptr<KernelAddressSpace> kernelAddressSpace,
+                             std::shared_ptr<const KernelOffsets> kernelOffsets,
                              const std::shared_ptr<ILogging>& logging,
                              uint64_t mm)
-        : vmiInterface(std::move(vmiInterface)),
+        : kernelAddressSpace(std::move(kernelAddressSpace)),
+          kernelOffsets(std::move(kernelOffsets)),
           logger(logging->newNamedLogger(FILENAME_STEM)),
-          pathExtractor(this->vmiInterface, logging),
+          pathExtractor(this->kernelAddressSpace, this->kernelOffsets, logging),
           mm(mm)
     {
     }
@@ -20,27 +21,18 @@ namespace VmiCore::Linux
     {
         auto regions = std::make_unique<std::vector<MemoryRegion>>();
 
-        for (auto area = vmiInterface->read64VA(mm, vmiInterface->convertPidToDtb(SYSTEM_PID)); area != 0;
-             area = vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_next"),
-                                           vmiInterface->convertPidToDtb(SYSTEM_PID)))
+        for (auto area = kernelAddressSpace->read64(mm); area != 0;
+             area = kernelAddressSpace->read64(area + kernelOffsets->vmAreaStruct.vm_next))
         {
-            const auto start =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_start"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto end =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_end"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
+            const auto start = kernelAddressSpace->read64(area + kernelOffsets->vmAreaStruct.vm_start);
+            const auto end = kernelAddressSpace->read64(area + kernelOffsets->vmAreaStruct.vm_end);
             const auto size = end - start + 1;
-            const auto flags =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_flags"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto file =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_file"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
+            const auto flags = kernelAddressSpace->read64(area + kernelOffsets->vmAreaStruct.vm_flags);
+            const auto file = kernelAddressSpace->read64(area + kernelOffsets->vmAreaStruct.vm_file);
             std::string fileName{};
             if (file != 0)
             {
-                fileName = pathExtractor.extractDPath(file + vmiInterface->getKernelStructOffset("file", "f_path"));
+                fileName = pathExtractor.extractDPath(file + kernelOffsets->file.f_path);
             }
 
             auto permissions = std::make_unique<PageProtection>(flags, OperatingSystem::LINUX);
@@ -2,7 +2,8 @@
 #define VMICORE_LINUX_MEMORYREGIONEXTRACTOR_H
 
 #include "../../io/ILogging.h"
-#include "../../vmi/LibvmiInterface.h"
+#include "../../vmi/KernelAddressSpace.h"
+#include "KernelOffsets.h"
 #include "PathExtractor.h"
 #include <vmicore/io/ILogger.h>
 #include <vmicore/os/IMemoryRegionExtractor.h>
@@ -12,14 +13,16 @@ namespace VmiCore::Linux
     class MMExtractor : public IMemoryRegionExtractor
     {
       public:
-        MMExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+        MMExtractor(std::shared_ptr<KernelAddressSpace> kernelAddressSpace,
+                    std::shared_ptr<const KernelOffsets> kernelOffsets,
                     const std::shared_ptr<ILogging>& logging,
                     uint64_t mm);
 
         [[nodiscard]] std::unique_ptr<std::vector<MemoryRegion>> extractAllMemoryRegions() const override;
 
       private:
-        std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::shared_ptr<KernelAddressSpace> kernelAddressSpace;
+        std::shared_ptr<const KernelOffsets> kernelOffsets;
         std::unique_ptr<ILogger> logger;
         PathExtractor pathExtractor;
         uint64_t mm;
@@ -1,12 +1,15 @@
 #include "PathExtractor.h"
-#include "Constants.h"
+#include <fmt/core.h>
 #include <vmicore/filename.h>
 
 namespace VmiCore::Linux
 {
-    PathExtractor::PathExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+    PathExtractor::PathExtractor(std::shared_ptr<KernelAddressSpace> kernelAddressSpace,
+                                 std::shared_ptr<const KernelOffsets> kernelOffsets,
                                  const std::shared_ptr<ILogging>& logging)
-        : vmiInterface(std::move(vmiInterface)), logger(logging->newNamedLogger(FILENAME_STEM))
+        : kernelAddressSpace(std::move(kernelAddressSpace)),
+          kernelOffsets(std::move(kernelOffsets)),
+          logger(logging->newNamedLogger(FILENAME_STEM))
     {
     }
 
@@ -17,65 +20,53 @@ namespace VmiCore::Linux
             return {};
         }
 
-        const auto mnt = vmiInterface->read64VA(path + vmiInterface->getKernelStructOffset("path", "mnt"),
-                                                vmiInterface->convertPidToDtb(SYSTEM_PID));
-        const auto dentry = vmiInterface->read64VA(path + vmiInterface->getKernelStructOffset("path", "dentry"),
-                                                   vmiInterface->convertPidToDtb(SYSTEM_PID));
+        const auto mnt = kernelAddressSpace->tryRead64(path + kernelOffsets->path.mnt);
+        const auto dentry = kernelAddressSpace->tryRead64(path + kernelOffsets->path.dentry);
 
-        if (dentry == 0 || mnt == 0)
+        if (!mnt || !dentry || *dentry == 0 || *mnt == 0)
         {
             return {};
         }
 
-        return createPath(dentry, mnt - vmiInterface->getKernelStructOffset("mount", "mnt"));
+        return createPath(*dentry, *mnt - kernelOffsets->mount.mnt);
     }
 
     std::string PathExtractor::createPath(uint64_t dentry, uint64_t mnt) const
     {
         std::string path;
-        try
-        {
-            const auto name = vmiInterface->extractStringAtVA(
-                vmiInterface->read64VA(dentry + vmiInterface->getKernelStructOffset("dentry", "d_name") +
-                                           vmiInterface->getKernelStructOffset("qstr", "name"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID)),
-                vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto parent =
-                vmiInterface->read64VA(dentry + vmiInterface->getKernelStructOffset("dentry", "d_parent"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto mntRoot = vmiInterface->read64VA(mnt + vmiInterface->getKernelStructOffset("mount", "mnt"),
-                                                        vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto mntMountpoint =
-                vmiInterface->read64VA(mnt + vmiInterface->getKernelStructOffset("mount", "mnt_mountpoint"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto mntParent =
-                vmiInterface->read64VA(mnt + vmiInterface->getKernelStructOffset("mount", "mnt_parent"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
 
-            if (parent != dentry && dentry != mntRoot)
-            {
-                path.append(createPath(parent, mnt));
-            }
-            else if (mntParent != mnt)
-            {
-                path.append(createPath(mntMountpoint, mntParent));
-            }
+        const auto namePointer =
+            kernelAddressSpace->tryRead64(dentry + kernelOffsets->dentry.d_name + kernelOffsets->qstr.name);
+        const auto name = namePointer ? kernelAddressSpace->tryExtractString(*namePointer) : std::nullopt;
+        const auto parent = kernelAddressSpace->tryRead64(dentry + kernelOffsets->dentry.d_parent);
+        const auto mntRoot = kernelAddressSpace->tryRead64(mnt + kernelOffsets->mount.mnt);
+        const auto mntMountpoint = kernelAddressSpace->tryRead64(mnt + kernelOffsets->mount.mnt_mountpoint);
+        const auto mntParent = kernelAddressSpace->tryRead64(mnt + kernelOffsets->mount.mnt_parent);
 
-            if ((parent == dentry && name->at(0) == '/') || dentry == mntRoot)
-            {
-                return path;
-            }
-            if (parent == dentry)
-            {
-                return path.append(*name);
-            }
-            return path.append(fmt::format("/{}", *name));
+        if (!name || !parent || !mntRoot || !mntMountpoint || !mntParent)
+        {
+            logger->warning("Unable to extract part of a path.",
+                            {{"dentry", fmt::format("{:#x}", dentry)}, {"mount", fmt::format("{:#x}", mnt)}});
+            return path;
+        }
+
+        if (*parent != dentry && dentry != *mntRoot)
+        {
+            path.append(createPath(*parent, mnt));
         }
-        catch (const std::exception& e)
+        else if (*mntParent != mnt)
         {
-            logger->warning("Unable to extract part of a path.", {{"exception", e.what()}});
+            path.append(createPath(*mntMountpoint, *mntParent));
         }
 
-        return path;
+        if ((*parent == dentry && name->starts_with('/')) || dentry == *mntRoot)
+        {
+            return path;
+        }
+        if (*parent == dentry)
+        {
+            return path.append(*name);
+        }
+        return path.append(fmt::format("/{}", *name));
     }
 }
@@ -2,7 +2,8 @@
 #define VMICORE_LINUX_PATHEXTRACTION_H
 
 #include "../../io/ILogging.h"
-#include "../../vmi/LibvmiInterface.h"
+#include "../../vmi/KernelAddressSpace.h"
+#include "KernelOffsets.h"
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -13,13 +14,15 @@ namespace VmiCore::Linux
     class PathExtractor
     {
       public:
-        explicit PathExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
-                               const std::shared_ptr<ILogging>& logging);
+        PathExtractor(std::shared_ptr<KernelAddressSpace> kernelAddressSpace,
+                      std::shared_ptr<const KernelOffsets> kernelOffsets,
+                      const std::shared_ptr<ILogging>& logging);
 
         [[nodiscard]] std::string extractDPath(uint64_t path) const;
 
       private:
-        std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::shared_ptr<KernelAddressSpace> kernelAddressSpace;
+        std::shared_ptr<const KernelOffsets> kernelOffsets;
         std::unique_ptr<ILogger> logger;
 
         [[nodiscard]] std::string createPath(uint64_t dentry, uint64_t mnt) const;
@@ -80,9 +80,7 @@ namespace VmiCore::Linux
     {
         auto taskStructBase = event.getRdi();
 
-        pluginSystem->passProcessTerminationEventToRegisteredPlugins(
-            activeProcessesSupervisor->getProcessInformationByBase(taskStructBase));
-        activeProcessesSupervisor->removeActiveProcess(taskStructBase);
+        notifyProcessTermination(taskStructBase);
         activeProcessesSupervisor->addNewProcess(taskStructBase);
         pluginSystem->passProcessStartEventToRegisteredPlugins(
             activeProcessesSupervisor->getProcessInformationByBase(taskStructBase));
@@ -94,13 +92,25 @@ namespace VmiCore::Linux
     {
         auto taskStructBase = event.getRdi();
 
-        pluginSystem->passProcessTerminationEventToRegisteredPlugins(
-            activeProcessesSupervisor->getProcessInformationByBase(taskStructBase));
-        activeProcessesSupervisor->removeActiveProcess(taskStructBase);
+        notifyProcessTermination(taskStructBase);
 
         return BpResponse::Continue;
     }
 
+    void SystemEventSupervisor::notifyProcessTermination(uint64_t taskStructBase)
+    {
+        try
+        {
+            pluginSystem->passProcessTerminationEventToRegisteredPlugins(
+                activeProcessesSupervisor->getProcessInformationByBase(taskStructBase));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            logger->debug("Terminated process not passed to plugins", {{"exception", e.what()}});
+        }
+        activeProcessesSupervisor->removeActiveProcess(taskStructBase);
+    }
+
     void SystemEventSupervisor::teardown()
     {
         procForkConnectorEvent->remove();
@@ -57,6 +57,9 @@ namespace VmiCore::Linux
         void startProcExecConnectorMonitoring();
 
         void startProcExitConnectorMonitoring();
+
+        // Processes that are unknown, e.g. because they have not been extracted yet, are not passed to the plugins
+        void notifyProcessTermination(uint64_t taskStructBase);
     };
 }
 
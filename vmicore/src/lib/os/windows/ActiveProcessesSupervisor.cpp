@@ -13,10 +13,12 @@ namespace VmiCore::Windows
     }
 
     ActiveProcessesSupervisor::ActiveProcessesSupervisor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                                                         std::shared_ptr<KernelAddressSpace> kernelAddressSpace,
                                                          std::shared_ptr<IKernelAccess> kernelAccess,
                                                          std::shared_ptr<ILogging> logging,
                                                          std::shared_ptr<IEventStream> eventStream)
         : vmiInterface(std::move(vmiInterface)),
+          kernelAddressSpace(std::move(kernelAddressSpace)),
           kernelAccess(std::move(kernelAccess)),
           logger(logging->newNamedLogger(FILENAME_STEM)),
           logging(std::move(logging)),
@@ -32,15 +34,43 @@ namespace VmiCore::Windows
         logger->debug("Got VA of PsActiveProcessHead",
                       {{"PsActiveProcessHeadVA", fmt::format("{:#x}", psActiveProcessListHeadVA)}});
 
-        auto currentListEntry =
-            vmiInterface->read64VA(psActiveProcessListHeadVA, vmiInterface->convertPidToDtb(SYSTEM_PID));
+        auto currentListEntry = kernelAddressSpace->read64(psActiveProcessListHeadVA);
         while (currentListEntry != psActiveProcessListHeadVA)
         {
-            addNewProcess(kernelAccess->getCurrentProcessEprocessBase(currentListEntry));
-            currentListEntry = vmiInterface->read64VA(currentListEntry, vmiInterface->convertPidToDtb(SYSTEM_PID));
+            auto eprocessBase = kernelAccess->getCurrentProcessEprocessBase(currentListEntry);
+            // The system process is needed for setting up the kernel breakpoints while the guest is still paused
+            if (kernelAccess->extractPID(eprocessBase) == SYSTEM_PID)
+            {
+                addNewProcess(eprocessBase);
+            }
+            else
+            {
+                discoveredEprocessBases.push_back(eprocessBase);
+            }
+            currentListEntry = kernelAddressSpace->read64(currentListEntry);
         }
 
-        logger->info("--- End of Initialization ---");
+        logger->info("--- End of Initialization ---", {{"discoveredProcesses", discoveredEprocessBases.size() + 1}});
+    }
+
+    bool ActiveProcessesSupervisor::extractNextDiscoveredProcess()
+    {
+        if (discoveredEprocessBases.empty())
+        {
+            return false;
+        }
+        auto eprocessBase = discoveredEprocessBases.front();
+        discoveredEprocessBases.pop_front();
+        try
+        {
+            addNewProcess(eprocessBase);
+        }
+        catch (const std::exception& e)
+        {
+            logger->warning("Unable to extract discovered process",
+                            {{"_EPROCESS_base", fmt::format("{:#x}", eprocessBase)}, {"exception", e.what()}});
+        }
+        return true;
     }
 
     std::unique_ptr<ActiveProcessInformation>
@@ -48,17 +78,18 @@ namespace VmiCore::Windows
     {
         auto processInformation = std::make_unique<ActiveProcessInformation>();
         processInformation->base = eprocessBase;
-        processInformation->processDtb = kernelAccess->extractDirectoryTableBase(eprocessBase);
-        processInformation->processUserDtb = kernelAccess->extractUserDirectoryTableBase(eprocessBase);
+        auto eprocess = kernelAccess->extractEprocessInformation(eprocessBase);
+        processInformation->processDtb = eprocess.directoryTableBase;
+        processInformation->processUserDtb = eprocess.userDirectoryTableBase;
         // KPTI implemented but inactive
         if (processInformation->processUserDtb == 0)
         {
             processInformation->processUserDtb = processInformation->processDtb;
         }
-        processInformation->pid = kernelAccess->extractPID(eprocessBase);
-        processInformation->parentPid = kernelAccess->extractParentID(eprocessBase);
-        processInformation->name = kernelAccess->extractImageFileName(eprocessBase);
-        processInformation->is32BitProcess = kernelAccess->extractIsWow64Process(eprocessBase);
+        processInformation->pid = eprocess.pid;
+        processInformation->parentPid = eprocess.parentPid;
+        processInformation->name = std::move(eprocess.imageFileName);
+        processInformation->is32BitProcess = eprocess.isWow64Process;
         try
         {
             processInformation->processPath = extractProcessPath(eprocessBase);
@@ -112,6 +143,8 @@ namespace VmiCore::Windows
 
     void ActiveProcessesSupervisor::addNewProcess(uint64_t eprocessBase)
     {
+        // A discovered process may be subject to a process event before it has been extracted
+        std::erase(discoveredEprocessBases, eprocessBase);
         std::shared_ptr<ActiveProcessInformation> processInformation(extractProcessInformation(eprocessBase));
         std::string parentPid("unknownParentPid");
         std::string parentName("unknownParentName");
@@ -193,10 +226,18 @@ namespace VmiCore::Windows
                      {"ParentProcessId", parentPid},
                      {"ParentProcessCr3", parentDtb}});
 
+                // Page tables of terminated processes are freed and may be reused, so their translations are stale
+                vmiInterface->flushV2PCache(processInformationIterator->second->processDtb);
+                vmiInterface->flushV2PCache(processInformationIterator->second->processUserDtb);
                 processInformationByPid.erase(processInformationIterator);
             }
             pidsByEprocessBase.erase(eprocessBaseIterator);
         }
+        else if (std::erase(discoveredEprocessBases, eprocessBase) > 0)
+        {
+            logger->debug("Discovered process removed before its extraction",
+                          {{"_EPROCESS_base", fmt::format("{:#x}", eprocessBase)}});
+        }
         else
         {
             logger->warning("Process does not seem to be stored as an active process",
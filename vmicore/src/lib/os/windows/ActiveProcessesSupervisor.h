@@ -3,12 +3,15 @@
 
 #include "../../io/IEventStream.h"
 #include "../../io/ILogging.h"
+#include "../../vmi/KernelAddressSpace.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "../IActiveProcessesSupervisor.h"
 #include "Constants.h"
 #include "VadTreeWin10.h"
+#include <deque>
 #include <map>
 #include <memory>
+#include <vector>
 #include <vmicore/io/ILogger.h>
 
 namespace VmiCore::Windows
@@ -17,12 +20,15 @@ namespace VmiCore::Windows
     {
       public:
         ActiveProcessesSupervisor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                                  std::shared_ptr<KernelAddressSpace> kernelAddressSpace,
                                   std::shared_ptr<IKernelAccess> kernelAccess,
                                   std::shared_ptr<ILogging> logging,
                                   std::shared_ptr<IEventStream> eventStream);
 
         void initialize() override;
 
+        bool extractNextDiscoveredProcess() override;
+
         [[nodiscard]] std::shared_ptr<ActiveProcessInformation> getSystemProcessInformation() const override;
 
         [[nodiscard]] std::shared_ptr<ActiveProcessInformation> getProcessInformationByPid(pid_t pid) const override;
@@ -39,9 +45,11 @@ namespace VmiCore::Windows
 
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::shared_ptr<KernelAddressSpace> kernelAddressSpace;
         std::shared_ptr<IKernelAccess> kernelAccess;
         std::map<pid_t, std::shared_ptr<ActiveProcessInformation>> processInformationByPid;
         std::map<uint64_t, pid_t> pidsByEprocessBase;
+        std::deque<uint64_t> discoveredEprocessBases;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<ILogging> logging;
         std::shared_ptr<IEventStream> eventStream;
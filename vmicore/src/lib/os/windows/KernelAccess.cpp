@@ -1,5 +1,6 @@
 #include "KernelAccess.h"
-#include "Constants.h"
+#include <algorithm>
+#include <array>
 #include <fmt/core.h>
 #include <vmicore/os/PagingDefinitions.h>
 #include <vmicore/vmi/VmiException.h>
@@ -11,7 +12,9 @@ namespace
 
 namespace VmiCore::Windows
 {
-    KernelAccess::KernelAccess(std::shared_ptr<ILibvmiInterface> vmiInterface) : vmiInterface(std::move(vmiInterface))
+    KernelAccess::KernelAccess(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                               std::shared_ptr<KernelAddressSpace> kernelAddressSpace)
+        : vmiInterface(std::move(vmiInterface)), kernelAddressSpace(std::move(kernelAddressSpace))
     {
     }
 
@@ -22,32 +25,28 @@ namespace VmiCore::Windows
 
     addr_t KernelAccess::extractVadTreeRootAddress(addr_t eprocessBase) const
     {
-        auto vadRoot = vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.VadRoot,
-                                              vmiInterface->convertPidToDtb(SYSTEM_PID));
+        auto vadRoot = kernelAddressSpace->read64(eprocessBase + kernelOffsets.eprocess.VadRoot);
         return vadRoot;
     }
 
     addr_t KernelAccess::extractImageFilePointer(addr_t eprocessBase) const
     {
-        auto imageFilePointer = vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.ImageFilePointer,
-                                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
+        auto imageFilePointer = kernelAddressSpace->read64(eprocessBase + kernelOffsets.eprocess.ImageFilePointer);
         return imageFilePointer;
     }
 
     std::unique_ptr<std::string> KernelAccess::extractFileName(addr_t fileObjectBaseAddress) const
     {
         expectSaneKernelAddress(fileObjectBaseAddress, static_cast<const char*>(__func__));
-        return vmiInterface->extractUnicodeStringAtVA(fileObjectBaseAddress + kernelOffsets.fileObject.FileName,
-                                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return kernelAddressSpace->extractUnicodeString(fileObjectBaseAddress + kernelOffsets.fileObject.FileName);
     }
 
     addr_t KernelAccess::extractControlAreaBasePointer(addr_t vadEntryBaseVA) const
     {
         expectSaneKernelAddress(vadEntryBaseVA, static_cast<const char*>(__func__));
-        auto subSectionBaseAddress = vmiInterface->read64VA(vadEntryBaseVA + kernelOffsets.mmVad.Subsection,
-                                                            vmiInterface->convertPidToDtb(SYSTEM_PID));
-        auto controlAreaBaseAddress = vmiInterface->read64VA(
-            subSectionBaseAddress + kernelOffsets.subSection.ControlArea, vmiInterface->convertPidToDtb(SYSTEM_PID));
+        auto subSectionBaseAddress = kernelAddressSpace->read64(vadEntryBaseVA + kernelOffsets.mmVad.Subsection);
+        auto controlAreaBaseAddress =
+            kernelAddressSpace->read64(subSectionBaseAddress + kernelOffsets.subSection.ControlArea);
         return controlAreaBaseAddress;
     }
 
@@ -59,12 +58,25 @@ namespace VmiCore::Windows
         }
     }
 
+    void KernelAccess::readBatchOrThrow(std::span<BatchReadEntry> entries, const char* caller) const
+    {
+        if (vmiInterface->readBatch(entries))
+        {
+            return;
+        }
+
+        auto failedEntry = std::ranges::find_if(entries, [](const BatchReadEntry& entry) { return !entry.success; });
+        throw VmiException(fmt::format("{}: Unable to read {} bytes from VA {:#x}",
+                                       caller,
+                                       failedEntry != entries.end() ? failedEntry->size : 0,
+                                       failedEntry != entries.end() ? failedEntry->virtualAddress : 0));
+    }
+
     addr_t KernelAccess::extractFilePointerObjectAddress(addr_t controlAreaBaseVA) const
     {
         expectSaneKernelAddress(controlAreaBaseVA, static_cast<const char*>(__func__));
-        auto filePointerObjectExFastRef = vmiInterface->read64VA(
-            controlAreaBaseVA + kernelOffsets.controlArea.FilePointer + kernelOffsets.exFastRef.Object,
-            vmiInterface->convertPidToDtb(SYSTEM_PID));
+        auto filePointerObjectExFastRef = kernelAddressSpace->read64(
+            controlAreaBaseVA + kernelOffsets.controlArea.FilePointer + kernelOffsets.exFastRef.Object);
         auto filePointerObjectAddress = removeReferenceCountFromExFastRef(filePointerObjectExFastRef);
         return filePointerObjectAddress;
     }
@@ -74,27 +86,60 @@ namespace VmiCore::Windows
         return exFastRefValue & ~(exFastRefBits);
     }
 
+    KernelAccess::MmVadShortView KernelAccess::readMmVadShort(addr_t vadShortBaseVA) const
+    {
+        expectSaneKernelAddress(vadShortBaseVA, static_cast<const char*>(__func__));
+        return kernelAddressSpace->readStruct<mmVadShortCapacity>(vadShortBaseVA,
+                                                                  kernelOffsets.structSizes.mmVadShort);
+    }
+
     std::tuple<addr_t, addr_t> KernelAccess::extractMmVadShortChildNodeAddresses(addr_t currentVadEntryBaseVA) const
     {
         expectSaneKernelAddress(currentVadEntryBaseVA, static_cast<const char*>(__func__));
-        auto leftChildAddress = vmiInterface->read64VA(currentVadEntryBaseVA + getVadNodeLeftChildOffset(),
-                                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-        auto rightChildAddress = vmiInterface->read64VA(currentVadEntryBaseVA + getVadNodeRightChildOffset(),
-                                                        vmiInterface->convertPidToDtb(SYSTEM_PID));
-        return {leftChildAddress, rightChildAddress};
+        return decodeMmVadShortChildNodeAddresses(readMmVadShort(getVadShortBaseVA(currentVadEntryBaseVA)));
     }
 
     std::tuple<uint64_t, uint64_t> KernelAccess::extractMmVadShortVpns(addr_t currentVadShortBaseVA) const
     {
-        expectSaneKernelAddress(currentVadShortBaseVA, static_cast<const char*>(__func__));
-        auto startingVpnHigh = vmiInterface->read8VA(currentVadShortBaseVA + kernelOffsets.mmVadShort.StartingVpnHigh,
-                                                     vmiInterface->convertPidToDtb(SYSTEM_PID));
-        auto endingVpnHigh = vmiInterface->read8VA(currentVadShortBaseVA + kernelOffsets.mmVadShort.EndingVpnHigh,
-                                                   vmiInterface->convertPidToDtb(SYSTEM_PID));
-        auto startingVpn = vmiInterface->read32VA(currentVadShortBaseVA + kernelOffsets.mmVadShort.StartingVpn,
-                                                  vmiInterface->convertPidToDtb(SYSTEM_PID));
-        auto endingVpn = vmiInterface->read32VA(currentVadShortBaseVA + kernelOffsets.mmVadShort.EndingVpn,
-                                                vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return decodeMmVadShortVpns(readMmVadShort(currentVadShortBaseVA));
+    }
+
+    std::optional<VadShortInformation> KernelAccess::tryExtractVadShortInformation(addr_t vadEntryBaseVA) const
+    {
+        if (vadEntryBaseVA < PagingDefinitions::kernelspaceLowerBoundary)
+        {
+            return std::nullopt;
+        }
+        auto vadShort = kernelAddressSpace->tryReadStruct<mmVadShortCapacity>(getVadShortBaseVA(vadEntryBaseVA),
+                                                                              kernelOffsets.structSizes.mmVadShort);
+        if (!vadShort)
+        {
+            return std::nullopt;
+        }
+
+        VadShortInformation vadShortInformation{};
+        std::tie(vadShortInformation.leftChildAddress, vadShortInformation.rightChildAddress) =
+            decodeMmVadShortChildNodeAddresses(*vadShort);
+        std::tie(vadShortInformation.startingVpn, vadShortInformation.endingVpn) = decodeMmVadShortVpns(*vadShort);
+        vadShortInformation.protection = decodeProtectionFlagValue(*vadShort);
+        vadShortInformation.isPrivateMemory = decodeIsPrivateMemory(*vadShort);
+
+        return vadShortInformation;
+    }
+
+    std::tuple<addr_t, addr_t> KernelAccess::decodeMmVadShortChildNodeAddresses(const MmVadShortView& vadShort) const
+    {
+        return {vadShort.read<addr_t>(kernelOffsets.mmVadShort.VadNode + kernelOffsets.rtlBalancedNode.Left),
+                vadShort.read<addr_t>(kernelOffsets.mmVadShort.VadNode + kernelOffsets.rtlBalancedNode.Right)};
+    }
+
+    std::tuple<uint64_t, uint64_t> KernelAccess::decodeMmVadShortVpns(const MmVadShortView& vadShort) const
+    {
+        auto startingVpnHigh = vadShort.read<uint8_t>(kernelOffsets.mmVadShort.StartingVpnHigh);
+        auto endingVpnHigh = vadShort.read<uint8_t>(kernelOffsets.mmVadShort.EndingVpnHigh);
+        auto startingVpn = vadShort.read<uint32_t>(kernelOffsets.mmVadShort.StartingVpn);
+        auto endingVpn = vadShort.read<uint32_t>(kernelOffsets.mmVadShort.EndingVpn);
+
         // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
         uint64_t vadShortEndingVpn = (static_cast<uint64_t>(endingVpnHigh) << sizeof(endingVpn) * 8) + endingVpn;
         uint64_t vadShortStartingVpn =
@@ -116,66 +161,72 @@ namespace VmiCore::Windows
 
     addr_t KernelAccess::extractDirectoryTableBase(addr_t eprocessBase) const
     {
-        return vmiInterface->read64VA(eprocessBase + kernelOffsets.kprocess.directoryTableBase,
-                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return kernelAddressSpace->read64(eprocessBase + kernelOffsets.kprocess.directoryTableBase);
     }
 
     addr_t KernelAccess::extractUserDirectoryTableBase(addr_t eprocessBase) const
     {
-        return vmiInterface->read64VA(eprocessBase + kernelOffsets.kprocess.userDirectoryTableBase,
-                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return kernelAddressSpace->read64(eprocessBase + kernelOffsets.kprocess.userDirectoryTableBase);
     }
 
     pid_t KernelAccess::extractParentID(addr_t eprocessBase) const
     {
         return static_cast<pid_t>(
-            vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.InheritedFromUniqueProcessId,
-                                   vmiInterface->convertPidToDtb(SYSTEM_PID)));
+            kernelAddressSpace->read64(eprocessBase + kernelOffsets.eprocess.InheritedFromUniqueProcessId));
     }
 
     std::string KernelAccess::extractImageFileName(addr_t eprocessBase) const
     {
-        return *vmiInterface->extractStringAtVA(eprocessBase + kernelOffsets.eprocess.ImageFileName,
-                                                vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return *kernelAddressSpace->extractString(eprocessBase + kernelOffsets.eprocess.ImageFileName);
     }
 
     pid_t KernelAccess::extractPID(addr_t eprocessBase) const
     {
-        return static_cast<pid_t>(vmiInterface->read32VA(eprocessBase + kernelOffsets.eprocess.UniqueProcessId,
-                                                         vmiInterface->convertPidToDtb(SYSTEM_PID)));
+        return static_cast<pid_t>(kernelAddressSpace->read32(eprocessBase + kernelOffsets.eprocess.UniqueProcessId));
+    }
+
+    EprocessInformation KernelAccess::extractEprocessInformation(addr_t eprocessBase) const
+    {
+        // _EPROCESS.ImageFileName is a UCHAR[15] that is only null terminated if the name is shorter
+        constexpr std::size_t imageFileNameLength = 15;
+        auto eprocess =
+            kernelAddressSpace->readStruct<eprocessCapacity>(eprocessBase, kernelOffsets.structSizes.eprocess);
+
+        return {.directoryTableBase = eprocess.read<addr_t>(kernelOffsets.kprocess.directoryTableBase),
+                .userDirectoryTableBase = eprocess.read<addr_t>(kernelOffsets.kprocess.userDirectoryTableBase),
+                .pid = static_cast<pid_t>(eprocess.read<uint32_t>(kernelOffsets.eprocess.UniqueProcessId)),
+                .parentPid =
+                    static_cast<pid_t>(eprocess.read<uint64_t>(kernelOffsets.eprocess.InheritedFromUniqueProcessId)),
+                .imageFileName = eprocess.readString(kernelOffsets.eprocess.ImageFileName, imageFileNameLength),
+                .isWow64Process = eprocess.read<uint64_t>(kernelOffsets.eprocess.WoW64Process) != 0};
     }
 
     uint32_t KernelAccess::extractExitStatus(addr_t eprocessBase) const
     {
-        return vmiInterface->read32VA(eprocessBase + kernelOffsets.eprocess.ExitStatus,
-                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return kernelAddressSpace->read32(eprocessBase + kernelOffsets.eprocess.ExitStatus);
     }
 
     addr_t KernelAccess::extractSectionAddress(addr_t eprocessBase) const
     {
-        return vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.SectionObject,
-                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return kernelAddressSpace->read64(eprocessBase + kernelOffsets.eprocess.SectionObject);
     }
 
     addr_t KernelAccess::extractControlAreaAddress(addr_t sectionAddress) const
     {
         expectSaneKernelAddress(sectionAddress, static_cast<const char*>(__func__));
-        return vmiInterface->read64VA(sectionAddress + kernelOffsets.section.controlArea,
-                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return kernelAddressSpace->read64(sectionAddress + kernelOffsets.section.controlArea);
     }
 
     addr_t KernelAccess::extractControlAreaFilePointer(addr_t controlAreaAddress) const
     {
         expectSaneKernelAddress(controlAreaAddress, static_cast<const char*>(__func__));
-        return vmiInterface->read64VA(controlAreaAddress + kernelOffsets.controlArea.FilePointer,
-                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return kernelAddressSpace->read64(controlAreaAddress + kernelOffsets.controlArea.FilePointer);
     }
 
     std::unique_ptr<std::string> KernelAccess::extractProcessPath(addr_t filePointerAddress) const
     {
         expectSaneKernelAddress(filePointerAddress, static_cast<const char*>(__func__));
-        return vmiInterface->extractUnicodeStringAtVA(filePointerAddress + kernelOffsets.fileObject.FileName,
-                                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return kernelAddressSpace->extractUnicodeString(filePointerAddress + kernelOffsets.fileObject.FileName);
     }
 
     addr_t KernelAccess::getMmVadShortFlagsAddr(addr_t vadShortBaseVA) const
@@ -185,23 +236,31 @@ namespace VmiCore::Windows
 
     uint8_t KernelAccess::extractProtectionFlagValue(addr_t vadShortBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName);
+        return decodeProtectionFlagValue(readMmVadShort(vadShortBaseVA));
+    }
+
+    bool KernelAccess::extractIsPrivateMemory(addr_t vadShortBaseVA) const
+    {
+        return decodeIsPrivateMemory(readMmVadShort(vadShortBaseVA));
+    }
+
+    uint8_t KernelAccess::decodeProtectionFlagValue(const MmVadShortView& vadShort) const
+    {
         // As of now, there are 32 Protectionvalues
         assert((kernelOffsets.mmvadFlags.protection.endBit - kernelOffsets.mmvadFlags.protection.startBit) < 6);
-        return static_cast<uint8_t>(extractFlagValue(getMmVadShortFlagsAddr(vadShortBaseVA),
-                                                     flagsSize,
-                                                     kernelOffsets.mmvadFlags.protection.startBit,
-                                                     kernelOffsets.mmvadFlags.protection.endBit));
+        return static_cast<uint8_t>(vadShort.readBitfield(kernelOffsets.mmVadShort.Flags,
+                                                          kernelOffsets.structSizes.mmvadFlags,
+                                                          kernelOffsets.mmvadFlags.protection.startBit,
+                                                          kernelOffsets.mmvadFlags.protection.endBit));
     }
 
-    bool KernelAccess::extractIsPrivateMemory(addr_t vadShortBaseVA) const
+    bool KernelAccess::decodeIsPrivateMemory(const MmVadShortView& vadShort) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName);
         assert((kernelOffsets.mmvadFlags.privateMemory.endBit - kernelOffsets.mmvadFlags.privateMemory.startBit) == 1);
-        return static_cast<bool>(extractFlagValue(getMmVadShortFlagsAddr(vadShortBaseVA),
-                                                  flagsSize,
-                                                  kernelOffsets.mmvadFlags.privateMemory.startBit,
-                                                  kernelOffsets.mmvadFlags.privateMemory.endBit));
+        return static_cast<bool>(vadShort.readBitfield(kernelOffsets.mmVadShort.Flags,
+                                                       kernelOffsets.structSizes.mmvadFlags,
+                                                       kernelOffsets.mmvadFlags.privateMemory.startBit,
+                                                       kernelOffsets.mmvadFlags.privateMemory.endBit));
     }
 
     addr_t KernelAccess::getMmSectionFlagsAddr(addr_t controlAreaBaseVA) const
@@ -211,7 +270,7 @@ namespace VmiCore::Windows
 
     bool KernelAccess::extractIsBeingDeleted(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.structSizes.mmsectionFlags;
         assert((kernelOffsets.mmsectionFlags.beingDeleted.endBit -
                 kernelOffsets.mmsectionFlags.beingDeleted.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
@@ -222,7 +281,7 @@ namespace VmiCore::Windows
 
     bool KernelAccess::extractIsImage(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.structSizes.mmsectionFlags;
         assert((kernelOffsets.mmsectionFlags.image.endBit - kernelOffsets.mmsectionFlags.image.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
                                                   flagsSize,
@@ -232,7 +291,7 @@ namespace VmiCore::Windows
 
     bool KernelAccess::extractIsFile(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.structSizes.mmsectionFlags;
         assert((kernelOffsets.mmsectionFlags.file.endBit - kernelOffsets.mmsectionFlags.file.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
                                                   flagsSize,
@@ -240,18 +299,6 @@ namespace VmiCore::Windows
                                                   kernelOffsets.mmsectionFlags.file.endBit));
     }
 
-    addr_t KernelAccess::getVadNodeRightChildOffset() const
-    {
-        return kernelOffsets.mmVad.mmVadShortBaseAddress + kernelOffsets.mmVadShort.VadNode +
-               kernelOffsets.rtlBalancedNode.Right;
-    }
-
-    addr_t KernelAccess::getVadNodeLeftChildOffset() const
-    {
-        return kernelOffsets.mmVad.mmVadShortBaseAddress + kernelOffsets.mmVadShort.VadNode +
-               kernelOffsets.rtlBalancedNode.Left;
-    }
-
     uint64_t KernelAccess::extractFlagValue(addr_t flagBaseVA, size_t size, size_t startBit, size_t endBit) const
     {
         expectSaneKernelAddress(flagBaseVA, static_cast<const char*>(__func__));
@@ -259,14 +306,14 @@ namespace VmiCore::Windows
         switch (size)
         {
             case sizeof(uint32_t):
-                flagValue = vmiInterface->read32VA(flagBaseVA, vmiInterface->convertPidToDtb(SYSTEM_PID));
+                flagValue = kernelAddressSpace->read32(flagBaseVA);
                 break;
             case sizeof(uint64_t):
-                flagValue = vmiInterface->read64VA(flagBaseVA, vmiInterface->convertPidToDtb(SYSTEM_PID));
+                flagValue = kernelAddressSpace->read64(flagBaseVA);
                 break;
             default:
                 throw VmiException(fmt::format(
-                    "{}: {} is unknown flag struct size", KernelStructOffsets::mmvad_flags::structName, size));
+                    "{}: {} is unknown flag struct size", KernelStructOffsets::mmsection_flags::structName, size));
         }
 
         return getFlagValue(flagValue, startBit, endBit);
@@ -275,7 +322,7 @@ namespace VmiCore::Windows
     bool KernelAccess::extractIsWow64Process(uint64_t eprocessBase) const
     {
         auto wow64ProcessAddress = eprocessBase + kernelOffsets.eprocess.WoW64Process;
-        auto wow64Process = vmiInterface->read64VA(wow64ProcessAddress, vmiInterface->convertPidToDtb(SYSTEM_PID));
+        auto wow64Process = kernelAddressSpace->read64(wow64ProcessAddress);
 
         return wow64Process != 0;
     }
@@ -288,16 +335,20 @@ namespace VmiCore::Windows
         }
 
         constexpr std::size_t mmProtectToValueLength = 32;
-        mmProtectToValue = std::vector<uint32_t>{};
-        mmProtectToValue.value().reserve(mmProtectToValueLength);
+        auto protectToValue = std::vector<uint32_t>(mmProtectToValueLength);
         auto mmProtectToValueAddress = vmiInterface->translateKernelSymbolToVA("MmProtectToValue");
+        auto systemDtb = kernelAddressSpace->getDtb();
 
+        std::vector<BatchReadEntry> entries{};
+        entries.reserve(mmProtectToValueLength);
         for (std::size_t i = 0; i < mmProtectToValueLength; i++)
         {
-            mmProtectToValue.value().push_back(vmiInterface->read32VA(mmProtectToValueAddress + i * sizeof(uint32_t),
-                                                                      vmiInterface->convertPidToDtb(SYSTEM_PID)));
+            entries.push_back(
+                BatchReadEntry::forValue(mmProtectToValueAddress + i * sizeof(uint32_t), systemDtb, protectToValue[i]));
         }
+        readBatchOrThrow(entries, static_cast<const char*>(__func__));
 
+        mmProtectToValue = std::move(protectToValue);
         return mmProtectToValue.value();
     }
 }
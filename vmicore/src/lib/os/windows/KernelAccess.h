@@ -1,15 +1,46 @@
 #ifndef VMICORE_WINDOWS_KERNELACCESS_H
 #define VMICORE_WINDOWS_KERNELACCESS_H
 
+#include "../../vmi/KernelAddressSpace.h"
 #include "../../vmi/LibvmiInterface.h"
+#include "../../vmi/StructView.h"
 #include "KernelOffsets.h"
 #include "ProtectionValues.h"
 #include <optional>
+#include <span>
+#include <string>
 #include <vector>
 #include <vmicore/types.h>
+#include <vmicore/vmi/BatchReadEntry.h>
 
 namespace VmiCore::Windows
 {
+    /**
+     * All fields of a _MMVAD_SHORT that are needed for walking the vad tree, decoded from a single snapshot.
+     */
+    struct VadShortInformation
+    {
+        addr_t leftChildAddress;
+        addr_t rightChildAddress;
+        uint64_t startingVpn;
+        uint64_t endingVpn;
+        uint8_t protection;
+        bool isPrivateMemory;
+    };
+
+    /**
+     * All fields of an _EPROCESS that are needed for discovering a process, decoded from a single snapshot.
+     */
+    struct EprocessInformation
+    {
+        addr_t directoryTableBase;
+        addr_t userDirectoryTableBase;
+        pid_t pid;
+        pid_t parentPid;
+        std::string imageFileName;
+        bool isWow64Process;
+    };
+
     class IKernelAccess
     {
       public:
@@ -33,6 +64,14 @@ namespace VmiCore::Windows
         [[nodiscard]] virtual std::tuple<uint64_t, uint64_t>
         extractMmVadShortVpns(addr_t currentVadShortBaseVA) const = 0;
 
+        /**
+         * Non-throwing as vad trees frequently contain nodes that are paged out or already freed.
+         *
+         * @return The decoded node or std::nullopt if the node could not be read.
+         */
+        [[nodiscard]] virtual std::optional<VadShortInformation>
+        tryExtractVadShortInformation(addr_t vadEntryBaseVA) const = 0;
+
         [[nodiscard]] virtual addr_t getVadShortBaseVA(addr_t vadEntryBaseVA) const = 0;
 
         [[nodiscard]] virtual addr_t getCurrentProcessEprocessBase(addr_t currentListEntry) const = 0;
@@ -47,6 +86,8 @@ namespace VmiCore::Windows
 
         [[nodiscard]] virtual pid_t extractPID(addr_t eprocessBase) const = 0;
 
+        [[nodiscard]] virtual EprocessInformation extractEprocessInformation(addr_t eprocessBase) const = 0;
+
         [[nodiscard]] virtual uint32_t extractExitStatus(addr_t eprocessBase) const = 0;
 
         [[nodiscard]] virtual addr_t extractSectionAddress(addr_t eprocessBase) const = 0;
@@ -82,7 +123,8 @@ namespace VmiCore::Windows
     class KernelAccess : public IKernelAccess
     {
       public:
-        explicit KernelAccess(std::shared_ptr<ILibvmiInterface> vmiInterface);
+        KernelAccess(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                     std::shared_ptr<KernelAddressSpace> kernelAddressSpace);
 
         ~KernelAccess() override = default;
 
@@ -105,6 +147,9 @@ namespace VmiCore::Windows
 
         [[nodiscard]] std::tuple<uint64_t, uint64_t> extractMmVadShortVpns(addr_t currentVadShortBaseVA) const override;
 
+        [[nodiscard]] std::optional<VadShortInformation>
+        tryExtractVadShortInformation(addr_t vadEntryBaseVA) const override;
+
         [[nodiscard]] addr_t getVadShortBaseVA(addr_t vadEntryBaseVA) const override;
 
         [[nodiscard]] addr_t getCurrentProcessEprocessBase(addr_t currentListEntry) const override;
@@ -119,6 +164,8 @@ namespace VmiCore::Windows
 
         [[nodiscard]] pid_t extractPID(addr_t eprocessBase) const override;
 
+        [[nodiscard]] EprocessInformation extractEprocessInformation(addr_t eprocessBase) const override;
+
         [[nodiscard]] uint32_t extractExitStatus(addr_t eprocessBase) const override;
 
         [[nodiscard]] addr_t extractSectionAddress(addr_t eprocessBase) const override;
@@ -148,13 +195,27 @@ namespace VmiCore::Windows
         [[nodiscard]] std::vector<uint32_t> extractMmProtectToValue() override;
 
       private:
+        // Upper bounds for the struct sizes of all supported kernel versions
+        static constexpr std::size_t mmVadShortCapacity = 0x80;
+        static constexpr std::size_t eprocessCapacity = 0x1000;
+
+        using MmVadShortView = StructView<mmVadShortCapacity>;
+
         std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::shared_ptr<KernelAddressSpace> kernelAddressSpace;
         KernelOffsets kernelOffsets;
         std::optional<std::vector<uint32_t>> mmProtectToValue = std::nullopt;
 
-        [[nodiscard]] addr_t getVadNodeLeftChildOffset() const;
+        [[nodiscard]] MmVadShortView readMmVadShort(addr_t vadShortBaseVA) const;
+
+        [[nodiscard]] std::tuple<addr_t, addr_t>
+        decodeMmVadShortChildNodeAddresses(const MmVadShortView& vadShort) const;
+
+        [[nodiscard]] std::tuple<uint64_t, uint64_t> decodeMmVadShortVpns(const MmVadShortView& vadShort) const;
 
-        [[nodiscard]] addr_t getVadNodeRightChildOffset() const;
+        [[nodiscard]] uint8_t decodeProtectionFlagValue(const MmVadShortView& vadShort) const;
+
+        [[nodiscard]] bool decodeIsPrivateMemory(const MmVadShortView& vadShort) const;
 
         [[nodiscard]] uint64_t extractFlagValue(addr_t flagBaseVA, size_t size, size_t startBit, size_t endBit) const;
 
@@ -169,6 +230,8 @@ namespace VmiCore::Windows
             return flagValueLSB;
         }
 
+        void readBatchOrThrow(std::span<BatchReadEntry> entries, const char* caller) const;
+
         static void expectSaneKernelAddress(addr_t address, const char* caller);
     };
 }
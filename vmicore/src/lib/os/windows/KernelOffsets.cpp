@@ -54,7 +54,13 @@ namespace VmiCore::Windows
                                  ? vmiInterface->getKernelStructOffset("_KPROCESS", "UserDirectoryTableBase")
                                  : vmiInterface->getKernelStructOffset("_KPROCESS", "DirectoryTableBase")},
             .subSection = {.ControlArea = vmiInterface->getKernelStructOffset("_SUBSECTION", "ControlArea")},
-            .exFastRef = {.Object = vmiInterface->getKernelStructOffset("_EX_FAST_REF", "Object")}};
+            .exFastRef = {.Object = vmiInterface->getKernelStructOffset("_EX_FAST_REF", "Object")},
+            .structSizes = {.eprocess = vmiInterface->getStructSizeFromJson("_EPROCESS"),
+                            .mmVadShort = vmiInterface->getStructSizeFromJson("_MMVAD_SHORT"),
+                            .mmvadFlags =
+                                vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName),
+                            .mmsectionFlags =
+                                vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName)}};
 
         return kernelOffsets;
     }
@@ -102,6 +102,14 @@ namespace VmiCore::Windows
             _flag image;
             _flag file;
         } __attribute__((aligned(128)));
+
+        using struct_sizes = struct struct_sizes
+        {
+            size_t eprocess;
+            size_t mmVadShort;
+            size_t mmvadFlags;
+            size_t mmsectionFlags;
+        } __attribute__((aligned(32)));
     } // namespace KernelStructOffsets
     // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
 
@@ -122,6 +130,7 @@ namespace VmiCore::Windows
         KernelStructOffsets::_kprocess kprocess{};
         KernelStructOffsets::_subsection subSection{};
         KernelStructOffsets::_ex_fast_ref exFastRef{};
+        KernelStructOffsets::struct_sizes structSizes{};
     };
 }
 
@@ -65,16 +65,7 @@ namespace VmiCore::Windows
                       });
         if (isTerminationEvent)
         {
-            try
-            {
-                pluginSystem->passProcessTerminationEventToRegisteredPlugins(
-                    activeProcessesSupervisor->getProcessInformationByBase(eprocessBase));
-                activeProcessesSupervisor->removeActiveProcess(eprocessBase);
-            }
-            catch (const std::invalid_argument& e)
-            {
-                logger->warning("InvalidArgumentException", {{"exception", e.what()}});
-            }
+            notifyProcessTermination(eprocessBase);
         }
         else
         {
@@ -90,13 +81,27 @@ namespace VmiCore::Windows
         auto bugCheckCode = event.getRcx();
         eventStream->sendBSODEvent(static_cast<int64_t>(bugCheckCode));
         logger->warning("BSOD detected!", {{"BugCheckCode", fmt::format("{:#x}", bugCheckCode)}});
-        GlobalControl::endVmi = true;
+        GlobalControl::requestShutdown();
         GlobalControl::postRunPluginAction = false;
         pluginSystem->unloadPlugins();
         // deactivate the interrupt event because we are terminating immediately (no single stepping)
         return BpResponse::Deactivate;
     }
 
+    void SystemEventSupervisor::notifyProcessTermination(uint64_t eprocessBase)
+    {
+        try
+        {
+            pluginSystem->passProcessTerminationEventToRegisteredPlugins(
+                activeProcessesSupervisor->getProcessInformationByBase(eprocessBase));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            logger->debug("Terminated process not passed to plugins", {{"exception", e.what()}});
+        }
+        activeProcessesSupervisor->removeActiveProcess(eprocessBase);
+    }
+
     void SystemEventSupervisor::teardown()
     {
         notifyProcessInterruptEvent->remove();
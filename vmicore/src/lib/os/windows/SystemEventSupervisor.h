@@ -52,6 +52,9 @@ namespace VmiCore::Windows
         void startPspCallProcessNotifyRoutinesMonitoring();
 
         void startKeBugCheck2Monitoring();
+
+        // Processes that are unknown, e.g. because they have not been extracted yet, are not passed to the plugins
+        void notifyProcessTermination(uint64_t eprocessBase);
     };
 }
 
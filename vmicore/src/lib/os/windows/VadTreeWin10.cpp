@@ -42,34 +42,27 @@ namespace VmiCore::Windows
                 continue;
             }
 
-            addr_t leftChildAddress = 0;
-            addr_t rightChildAddress = 0;
-            try
-            {
-                std::tie(leftChildAddress, rightChildAddress) =
-                    kernelAccess->extractMmVadShortChildNodeAddresses(currentVadEntryBaseVA);
-            }
-            catch (const std::exception& e)
+            auto vadShortInformation = kernelAccess->tryExtractVadShortInformation(currentVadEntryBaseVA);
+            if (!vadShortInformation)
             {
                 logger->warning("Unable to extract process",
                                 {{"ProcessName", processName},
                                  {"ProcessId", static_cast<int64_t>(pid)},
-                                 {"_MMVAD_SHORT", fmt::format("{:#x}", currentVadEntryBaseVA)},
-                                 {"exception", e.what()}});
+                                 {"_MMVAD_SHORT", fmt::format("{:#x}", currentVadEntryBaseVA)}});
                 continue;
             }
-            if (leftChildAddress != 0)
+            if (vadShortInformation->leftChildAddress != 0)
             {
-                nextVadEntries.push_back(leftChildAddress);
+                nextVadEntries.push_back(vadShortInformation->leftChildAddress);
             }
-            if (rightChildAddress != 0)
+            if (vadShortInformation->rightChildAddress != 0)
             {
-                nextVadEntries.push_back(rightChildAddress);
+                nextVadEntries.push_back(vadShortInformation->rightChildAddress);
             }
 
             try
             {
-                const auto currentVad = createVadt(currentVadEntryBaseVA);
+                const auto currentVad = createVadt(currentVadEntryBaseVA, *vadShortInformation);
 
                 const auto startAddress = currentVad->startingVPN << PagingDefinitions::numberOfPageIndexBits;
                 const auto endAddress = ((currentVad->endingVPN + 1) << PagingDefinitions::numberOfPageIndexBits) - 1;
@@ -105,15 +98,16 @@ namespace VmiCore::Windows
         return imageFlag || fileFlag;
     }
 
-    std::unique_ptr<Vadt> VadTreeWin10::createVadt(uint64_t vadEntryBaseVA) const
+    std::unique_ptr<Vadt> VadTreeWin10::createVadt(uint64_t vadEntryBaseVA,
+                                                   const VadShortInformation& vadShortInformation) const
     {
         auto vadt = std::make_unique<Vadt>();
-        auto vadShortBaseVA = kernelAccess->getVadShortBaseVA(vadEntryBaseVA);
-        std::tie(vadt->startingVPN, vadt->endingVPN) = kernelAccess->extractMmVadShortVpns(vadShortBaseVA);
-        vadt->protection = kernelAccess->extractProtectionFlagValue(vadShortBaseVA);
+        vadt->startingVPN = vadShortInformation.startingVpn;
+        vadt->endingVPN = vadShortInformation.endingVpn;
+        vadt->protection = vadShortInformation.protection;
         vadt->isFileBacked = false;
         vadt->isBeingDeleted = false;
-        vadt->isSharedMemory = !kernelAccess->extractIsPrivateMemory(vadShortBaseVA);
+        vadt->isSharedMemory = !vadShortInformation.isPrivateMemory;
         vadt->isProcessBaseImage = false;
 
         vadt->vadEntryBaseVA = vadEntryBaseVA;
@@ -31,7 +31,8 @@ namespace VmiCore::Windows
         std::unique_ptr<ILogger> logger;
         std::vector<uint32_t> mmProtectToValue;
 
-        [[nodiscard]] std::unique_ptr<Vadt> createVadt(uint64_t vadEntryBaseVA) const;
+        [[nodiscard]] std::unique_ptr<Vadt> createVadt(uint64_t vadEntryBaseVA,
+                                                       const VadShortInformation& vadShortInformation) const;
 
         [[nodiscard]] std::unique_ptr<std::string> extractFileName(addr_t filePointerObjectAddress) const;
     };
@@ -1,5 +1,5 @@
 #include "PluginSystem.h"
-#include "../vmi/MemoryMapping.h"
+#include "../GlobalControl.h"
 #include "PluginException.h"
 #include <bit>
 #include <cstdint>
@@ -13,6 +13,7 @@ namespace VmiCore
     namespace
     {
         bool isInstanciated = false;
+        constexpr std::size_t maxDeferredTasksPerWorker = 4096;
     }
 
     PluginSystem::PluginSystem(std::shared_ptr<IConfigParser> configInterface,
@@ -29,7 +30,12 @@ namespace VmiCore
           fileTransport(std::move(pluginLogging)),
           loggingLib(std::move(loggingLib)),
           logger(this->loggingLib->newNamedLogger(FILENAME_STEM)),
-          eventStream(std::move(eventStream))
+          eventStream(std::move(eventStream)),
+          mappingPool(std::make_unique<MemoryMappingPool>(
+              this->loggingLib, this->vmiInterface, this->configInterface->getMappingPoolBudget())),
+          // Tasks are ordered per vCPU, so additional workers would never receive any task
+          workerPool(std::make_unique<WorkerPool>(
+              this->loggingLib, this->vmiInterface->getNumberOfVCPUs(), maxDeferredTasksPerWorker))
     {
         if (isInstanciated)
         {
@@ -46,8 +52,7 @@ namespace VmiCore
     std::unique_ptr<IMemoryMapping>
     PluginSystem::mapProcessMemoryRegion(addr_t baseVA, addr_t dtb, std::size_t numberOfPages) const
     {
-        return std::make_unique<MemoryMapping>(
-            loggingLib, vmiInterface, vmiInterface->mmapGuest(baseVA, dtb, numberOfPages));
+        return mappingPool->map(baseVA, dtb, numberOfPages);
     }
 
     void PluginSystem::registerProcessStartEvent(
@@ -70,6 +75,22 @@ namespace VmiCore
         return interruptEventSupervisor->createBreakpoint(targetVA, processInformation, callbackFunction, false);
     }
 
+    std::shared_ptr<IBreakpoint>
+    PluginSystem::createBreakpoint(uint64_t targetVA,
+                                   const ActiveProcessInformation& processInformation,
+                                   const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
+                                   const BreakpointFilter& filter)
+    {
+        return interruptEventSupervisor->createBreakpoint(
+            targetVA, processInformation, callbackFunction, false, filter);
+    }
+
+    bool PluginSystem::createBreakpoints(const ActiveProcessInformation& processInformation,
+                                         std::span<BreakpointSpec> breakpointSpecs)
+    {
+        return interruptEventSupervisor->createBreakpoints(processInformation, breakpointSpecs, false);
+    }
+
     std::unique_ptr<ILogger> PluginSystem::newNamedLogger(std::string_view name) const
     {
         return loggingLib->newNamedLogger(name);
@@ -117,6 +138,11 @@ namespace VmiCore
         return vmiInterface;
     }
 
+    void PluginSystem::deferTask(uint32_t vcpuId, std::function<void()> task)
+    {
+        workerPool->submit(vcpuId, std::move(task));
+    }
+
     std::unique_ptr<std::string> PluginSystem::getResultsDir() const
     {
         return std::make_unique<std::string>(configInterface->getResultsDirectory());
@@ -128,9 +154,7 @@ namespace VmiCore
         return activeProcessesSupervisor->getActiveProcesses();
     }
 
-    void PluginSystem::initializePlugin(const std::string& pluginName,
-                                        std::shared_ptr<Plugin::IPluginConfig> config,
-                                        const std::vector<std::string>& args)
+    void PluginSystem::loadPlugin(const std::string& pluginName, std::shared_ptr<Plugin::IPluginConfig> config)
     {
         auto pluginDirectory = configInterface->getPluginDirectory();
         logger->debug("Plugin directory", {{"dirName", pluginDirectory.string()}});
@@ -169,25 +193,57 @@ namespace VmiCore
             throw PluginException(pluginName, fmt::format("Unable to retrieve init function: {}", dlErrorMessage));
         }
 
-        auto plugin = pluginInitFunction(dynamic_cast<Plugin::PluginInterface*>(this), std::move(config), args);
+        loadedPlugins.push_back(
+            {.name = pluginName, .config = std::move(config), .initFunction = pluginInitFunction});
+    }
 
-        plugins.emplace_back(pluginName, std::move(plugin));
+    void PluginSystem::loadPlugins()
+    {
+        for (const auto& [name, config] : configInterface->getPlugins())
+        {
+            loadPlugin(name, config);
+        }
     }
 
     void PluginSystem::initializePlugins(const std::map<std::string, std::vector<std::string>, std::less<>>& pluginArgs)
     {
-        for (const auto& [name, config] : configInterface->getPlugins())
+        for (auto& [name, config, initFunction] : loadedPlugins)
         {
-            initializePlugin(
-                name, config, pluginArgs.contains(name) ? pluginArgs.at(name) : std::vector<std::string>{name});
+            auto plugin = initFunction(dynamic_cast<Plugin::PluginInterface*>(this),
+                                       std::move(config),
+                                       pluginArgs.contains(name) ? pluginArgs.at(name) : std::vector<std::string>{name});
+            plugins.emplace_back(name, std::move(plugin));
+        }
+        loadedPlugins.clear();
+    }
+
+    void PluginSystem::startPlugins()
+    {
+        pluginsStarted = true;
+        for (auto& [name, plugin] : plugins)
+        {
+            try
+            {
+                plugin->start();
+            }
+            catch (const std::exception& e)
+            {
+                throw PluginException(name, fmt::format("Unable to start plugin: {}", e.what()));
+            }
         }
     }
 
     void PluginSystem::passProcessStartEventToRegisteredPlugins(
         std::shared_ptr<const ActiveProcessInformation> processInformation)
     {
+        static auto& pluginCallbackLatency = GlobalControl::latencyHistograms().get("plugin.processStart");
+        if (!pluginsStarted)
+        {
+            return;
+        }
         for (const auto& processStartCallback : registeredProcessStartCallbacks)
         {
+            ScopedLatency measurement(pluginCallbackLatency);
             processStartCallback(processInformation);
         }
     }
@@ -195,14 +251,23 @@ namespace VmiCore
     void PluginSystem::passProcessTerminationEventToRegisteredPlugins(
         std::shared_ptr<const ActiveProcessInformation> processInformation)
     {
-        for (const auto& processTerminationCallback : registeredProcessTerminationCallbacks)
+        static auto& pluginCallbackLatency = GlobalControl::latencyHistograms().get("plugin.processTermination");
+        if (pluginsStarted)
         {
-            processTerminationCallback(processInformation);
+            for (const auto& processTerminationCallback : registeredProcessTerminationCallbacks)
+            {
+                ScopedLatency measurement(pluginCallbackLatency);
+                processTerminationCallback(processInformation);
+            }
         }
+        mappingPool->invalidateDtb(processInformation->processDtb);
+        mappingPool->invalidateDtb(processInformation->processUserDtb);
     }
 
     void PluginSystem::unloadPlugins()
     {
+        workerPool->drain();
+        mappingPool->clear();
         vmiInterface->flushV2PCache(LibvmiInterface::flushAllPTs);
         vmiInterface->flushPageCache();
 
@@ -219,6 +284,8 @@ namespace VmiCore
             }
         }
 
+        // Plugins may still have deferred tasks during unload
+        workerPool->drain();
         registeredProcessStartCallbacks.clear();
         registeredProcessTerminationCallbacks.clear();
         plugins.clear();
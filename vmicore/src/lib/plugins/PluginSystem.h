@@ -8,6 +8,8 @@
 #include "../os/IActiveProcessesSupervisor.h"
 #include "../vmi/InterruptEventSupervisor.h"
 #include "../vmi/LibvmiInterface.h"
+#include "../vmi/MemoryMappingPool.h"
+#include "WorkerPool.h"
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -24,9 +26,26 @@ namespace VmiCore
       public:
         ~IPluginSystem() override = default;
 
+        /**
+         * Loads the libraries of all configured plugins and checks their API versions. Does not depend on the state of
+         * the guest, so it may be done before the guest is paused.
+         */
+        virtual void loadPlugins() = 0;
+
+        /**
+         * Initializes all plugins previously loaded by loadPlugins. Plugins are not supposed to access the guest
+         * during initialization, so it may be done before the guest is paused as well.
+         */
         virtual void
         initializePlugins(const std::map<std::string, std::vector<std::string>, std::less<>>& pluginArgs) = 0;
 
+        /**
+         * Lets all initialized plugins set up whatever depends on the state of the guest. Requires all running
+         * processes to be known. Process events are passed to the plugins only once they have been started, as all
+         * processes that are running by then are reported through getRunningProcesses.
+         */
+        virtual void startPlugins() = 0;
+
         virtual void passProcessStartEventToRegisteredPlugins(
             std::shared_ptr<const ActiveProcessInformation> processInformation) = 0;
 
@@ -52,8 +71,12 @@ namespace VmiCore
 
         ~PluginSystem() override;
 
+        void loadPlugins() override;
+
         void initializePlugins(const std::map<std::string, std::vector<std::string>, std::less<>>& pluginArgs) override;
 
+        void startPlugins() override;
+
         void passProcessStartEventToRegisteredPlugins(
             std::shared_ptr<const ActiveProcessInformation> processInformation) override;
 
@@ -63,6 +86,13 @@ namespace VmiCore
         void unloadPlugins() override;
 
       private:
+        struct LoadedPlugin
+        {
+            std::string name;
+            std::shared_ptr<Plugin::IPluginConfig> config;
+            decltype(Plugin::vmicore_plugin_init)* initFunction;
+        };
+
         std::shared_ptr<IConfigParser> configInterface;
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::shared_ptr<IActiveProcessesSupervisor> activeProcessesSupervisor;
@@ -75,7 +105,12 @@ namespace VmiCore
         std::shared_ptr<ILogging> loggingLib;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<IEventStream> eventStream;
+        std::unique_ptr<IMemoryMappingPool> mappingPool;
+        bool pluginsStarted = false;
+        std::vector<LoadedPlugin> loadedPlugins;
         std::vector<std::pair<std::string, std::unique_ptr<Plugin::IPlugin>>> plugins;
+        // Declared after the plugins, so that no deferred task outlives the plugin it belongs to
+        std::unique_ptr<IWorkerPool> workerPool;
 
         [[nodiscard]] std::unique_ptr<std::string> getResultsDir() const override;
 
@@ -96,6 +131,15 @@ namespace VmiCore
                          const ActiveProcessInformation& processInformation,
                          const std::function<BpResponse(IInterruptEvent&)>& callbackFunction) override;
 
+        [[nodiscard]] std::shared_ptr<IBreakpoint>
+        createBreakpoint(uint64_t targetVA,
+                         const ActiveProcessInformation& processInformation,
+                         const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
+                         const BreakpointFilter& filter) override;
+
+        bool createBreakpoints(const ActiveProcessInformation& processInformation,
+                               std::span<BreakpointSpec> breakpointSpecs) override;
+
         [[nodiscard]] std::unique_ptr<ILogger> newNamedLogger(std::string_view name) const override;
 
         void writeToFile(const std::string& filename, const std::string& message) const override;
@@ -108,9 +152,9 @@ namespace VmiCore
 
         [[nodiscard]] std::shared_ptr<IIntrospectionAPI> getIntrospectionAPI() const override;
 
-        void initializePlugin(const std::string& pluginName,
-                              std::shared_ptr<Plugin::IPluginConfig> config,
-                              const std::vector<std::string>& args);
+        void deferTask(uint32_t vcpuId, std::function<void()> task) override;
+
+        void loadPlugin(const std::string& pluginName, std::shared_ptr<Plugin::IPluginConfig> config);
     };
 }
 
@@ -0,0 +1,140 @@
+#include "WorkerPool.h"
+#include "../GlobalControl.h"
+#include <algorithm>
+#include <vmicore/filename.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        uint64_t nanosecondsSince(std::chrono::steady_clock::time_point start)
+        {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    WorkerPool::WorkerPool(const std::shared_ptr<ILogging>& logging,
+                           std::size_t numberOfWorkers,
+                           std::size_t maxQueueDepth)
+        : logger(logging->newNamedLogger(FILENAME_STEM)), maxQueueDepth(std::max<std::size_t>(maxQueueDepth, 1))
+    {
+        for (std::size_t i = 0; i < std::max<std::size_t>(numberOfWorkers, 1); i++)
+        {
+            auto& worker = workers.emplace_back(std::make_unique<Worker>());
+            worker->thread = std::thread(&WorkerPool::work, this, std::ref(*worker));
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        for (auto& worker : workers)
+        {
+            {
+                std::scoped_lock lock(worker->lock);
+                worker->stopping = true;
+            }
+            worker->taskAvailable.notify_one();
+        }
+        for (auto& worker : workers)
+        {
+            worker->thread.join();
+        }
+
+        auto statistics = getStatistics();
+        if (statistics.executedTasks > 0)
+        {
+            logger->info("Worker pool statistics",
+                         {{"executedTasks", statistics.executedTasks},
+                          {"maxQueueDepth", statistics.maxQueueDepth},
+                          {"totalQueueWaitNs", statistics.totalQueueWaitNs},
+                          {"maxQueueWaitNs", statistics.maxQueueWaitNs},
+                          {"totalSubmitStallNs", statistics.totalSubmitStallNs}});
+        }
+    }
+
+    void WorkerPool::submit(uint64_t orderingKey, std::function<void()> task)
+    {
+        auto& worker = *workers[orderingKey % workers.size()];
+        {
+            std::unique_lock lock(worker.lock);
+            if (worker.tasks.size() >= maxQueueDepth)
+            {
+                auto stallStart = std::chrono::steady_clock::now();
+                worker.taskCompleted.wait(lock, [this, &worker]() { return worker.tasks.size() < maxQueueDepth; });
+                worker.statistics.totalSubmitStallNs += nanosecondsSince(stallStart);
+            }
+            worker.tasks.push_back({.function = std::move(task), .submitted = std::chrono::steady_clock::now()});
+            worker.statistics.maxQueueDepth =
+                std::max(worker.statistics.maxQueueDepth, static_cast<uint64_t>(worker.tasks.size()));
+        }
+        worker.taskAvailable.notify_one();
+    }
+
+    void WorkerPool::drain()
+    {
+        for (auto& worker : workers)
+        {
+            std::unique_lock lock(worker->lock);
+            worker->taskCompleted.wait(lock, [&worker]() { return worker->tasks.empty() && !worker->busy; });
+        }
+    }
+
+    WorkerPoolStatistics WorkerPool::getStatistics() const
+    {
+        WorkerPoolStatistics total{};
+        for (const auto& worker : workers)
+        {
+            std::scoped_lock lock(worker->lock);
+            total.executedTasks += worker->statistics.executedTasks;
+            total.maxQueueDepth = std::max(total.maxQueueDepth, worker->statistics.maxQueueDepth);
+            total.totalQueueWaitNs += worker->statistics.totalQueueWaitNs;
+            total.maxQueueWaitNs = std::max(total.maxQueueWaitNs, worker->statistics.maxQueueWaitNs);
+            total.totalSubmitStallNs += worker->statistics.totalSubmitStallNs;
+        }
+        return total;
+    }
+
+    void WorkerPool::work(Worker& worker)
+    {
+        std::unique_lock lock(worker.lock);
+        while (true)
+        {
+            worker.taskAvailable.wait(lock, [&worker]() { return !worker.tasks.empty() || worker.stopping; });
+            if (worker.tasks.empty())
+            {
+                // Only stop once all queued tasks have been executed
+                return;
+            }
+
+            auto task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+            worker.busy = true;
+            auto queueWaitNs = nanosecondsSince(task.submitted);
+            worker.statistics.totalQueueWaitNs += queueWaitNs;
+            worker.statistics.maxQueueWaitNs = std::max(worker.statistics.maxQueueWaitNs, queueWaitNs);
+            lock.unlock();
+
+            try
+            {
+                static auto& taskLatency = GlobalControl::latencyHistograms().get("plugin.deferredTask");
+                ScopedLatency measurement(taskLatency);
+                task.function();
+            }
+            catch (const std::exception& e)
+            {
+                logger->error("Deferred task failed", {{"exception", e.what()}});
+            }
+            catch (...)
+            {
+                // Plugins may throw anything, which must neither terminate the worker nor leave it marked as busy
+                logger->error("Deferred task failed", {{"exception", "unknown"}});
+            }
+
+            lock.lock();
+            worker.busy = false;
+            worker.statistics.executedTasks++;
+            worker.taskCompleted.notify_all();
+        }
+    }
+}
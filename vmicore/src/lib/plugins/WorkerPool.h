@@ -0,0 +1,105 @@
+#ifndef VMICORE_WORKERPOOL_H
+#define VMICORE_WORKERPOOL_H
+
+#include "../io/ILogging.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <vmicore/io/ILogger.h>
+
+namespace VmiCore
+{
+    struct WorkerPoolStatistics
+    {
+        uint64_t executedTasks;
+        uint64_t maxQueueDepth;
+        uint64_t totalQueueWaitNs;
+        uint64_t maxQueueWaitNs;
+        // Time submitters have been blocked because the queue of the target worker was full
+        uint64_t totalSubmitStallNs;
+    };
+
+    class IWorkerPool
+    {
+      public:
+        virtual ~IWorkerPool() = default;
+
+        /**
+         * Queues the task for execution on a worker thread. Tasks with the same ordering key are executed one after
+         * another in submission order, while tasks with different keys may run in parallel. Blocks as long as the
+         * queue responsible for the key is full.
+         */
+        virtual void submit(uint64_t orderingKey, std::function<void()> task) = 0;
+
+        /**
+         * Blocks until all tasks submitted so far have been executed.
+         */
+        virtual void drain() = 0;
+
+        [[nodiscard]] virtual WorkerPoolStatistics getStatistics() const = 0;
+
+      protected:
+        IWorkerPool() = default;
+    };
+
+    /**
+     * Each worker owns a bounded queue and ordering keys are distributed statically among the workers, which keeps
+     * the order per key without any coordination between workers.
+     */
+    class WorkerPool final : public IWorkerPool
+    {
+      public:
+        WorkerPool(const std::shared_ptr<ILogging>& logging, std::size_t numberOfWorkers, std::size_t maxQueueDepth);
+
+        ~WorkerPool() override;
+
+        WorkerPool(const WorkerPool&) = delete;
+
+        WorkerPool(const WorkerPool&&) = delete;
+
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        WorkerPool& operator=(const WorkerPool&&) = delete;
+
+        void submit(uint64_t orderingKey, std::function<void()> task) override;
+
+        void drain() override;
+
+        [[nodiscard]] WorkerPoolStatistics getStatistics() const override;
+
+      private:
+        struct Task
+        {
+            std::function<void()> function;
+            std::chrono::steady_clock::time_point submitted;
+        };
+
+        struct Worker
+        {
+            mutable std::mutex lock{};
+            std::condition_variable taskAvailable{};
+            // Signaled whenever a task has been completed, so that blocked submitters and drain can proceed
+            std::condition_variable taskCompleted{};
+            std::deque<Task> tasks{};
+            bool busy = false;
+            bool stopping = false;
+            WorkerPoolStatistics statistics{};
+            std::thread thread{};
+        };
+
+        std::unique_ptr<ILogger> logger;
+        std::size_t maxQueueDepth;
+        std::vector<std::unique_ptr<Worker>> workers{};
+
+        void work(Worker& worker);
+    };
+}
+
+#endif // VMICORE_WORKERPOOL_H
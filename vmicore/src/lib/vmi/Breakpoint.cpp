@@ -8,12 +8,14 @@ namespace VmiCore
                            std::function<void(Breakpoint*)> notifyDelete,
                            std::function<BpResponse(IInterruptEvent&)> callback,
                            uint64_t processDtb,
-                           bool global)
+                           bool global,
+                           std::optional<BreakpointFilter> filter)
         : targetPA(targetPA),
           notifyFunction(std::move(notifyDelete)),
           callbackFunction(std::move(callback)),
           dtb(processDtb),
-          global(global)
+          global(global),
+          filter(std::move(filter))
     {
     }
 
@@ -48,20 +50,18 @@ namespace VmiCore
         }
     }
 
-    BPStateResponse Breakpoint::getNewBreakpointState(uint64_t newDtb) const
+    uint64_t Breakpoint::getDtb() const
     {
-        using enum VmiCore::BPStateResponse;
+        return dtb;
+    }
 
-        if (global) // Breakpoint always present e.g. in specific kernel functions
-        {
-            return Enable;
-        }
+    bool Breakpoint::isGlobal() const
+    {
+        return global;
+    }
 
-        if (dtb == newDtb)
-        {
-            return Enable;
-        }
-        // Process is not hooked
-        return Disable;
+    const std::optional<BreakpointFilter>& Breakpoint::getFilter() const
+    {
+        return filter;
     }
 }
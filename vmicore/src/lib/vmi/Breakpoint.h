@@ -4,9 +4,11 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vmicore/types.h>
 #include <vmicore/vmi/BpResponse.h>
+#include <vmicore/vmi/BreakpointFilter.h>
 #include <vmicore/vmi/IBreakpoint.h>
 #include <vmicore/vmi/events/IInterruptEvent.h>
 
@@ -25,7 +27,8 @@ namespace VmiCore
                    std::function<void(Breakpoint*)> notifyDelete,
                    std::function<BpResponse(IInterruptEvent&)> callback,
                    uint64_t dtb,
-                   bool global);
+                   bool global,
+                   std::optional<BreakpointFilter> filter = std::nullopt);
 
         addr_t getTargetPA() const override;
 
@@ -33,7 +36,17 @@ namespace VmiCore
 
         BpResponse callback(IInterruptEvent& event);
 
-        BPStateResponse getNewBreakpointState(uint64_t dtb) const;
+        [[nodiscard]] uint64_t getDtb() const;
+
+        /**
+         * @return Whether the breakpoint is active in all address spaces, e.g. in specific kernel functions.
+         */
+        [[nodiscard]] bool isGlobal() const;
+
+        /**
+         * @return Predicate that has to hold for a hit to be delivered to the callback, if any.
+         */
+        [[nodiscard]] const std::optional<BreakpointFilter>& getFilter() const;
 
       private:
         uint64_t targetPA;
@@ -41,6 +54,7 @@ namespace VmiCore
         std::function<BpResponse(IInterruptEvent&)> callbackFunction;
         uint64_t dtb;
         bool global = false;
+        std::optional<BreakpointFilter> filter;
         bool deleted = false;
     };
 }
@@ -0,0 +1,19 @@
+#ifndef VMICORE_BREAKPOINTMODE_H
+#define VMICORE_BREAKPOINTMODE_H
+
+namespace VmiCore
+{
+    /**
+     * Determines how the guest continues after a breakpoint has been handled.
+     */
+    enum class BreakpointMode
+    {
+        // The original instruction is restored and single stepped before the INT3 is written again
+        SingleStep,
+        // The original instruction is emulated by the hypervisor, so the INT3 stays in guest memory. Falls back to
+        // single stepping for instructions that cannot be emulated.
+        Emulate
+    };
+}
+
+#endif // VMICORE_BREAKPOINTMODE_H
@@ -0,0 +1,151 @@
+#include "BreakpointTable.h"
+
+namespace VmiCore
+{
+    namespace
+    {
+        // Fibonacci hashing, i.e. 2^64 divided by the golden ratio. Spreads page aligned and adjacent PAs alike.
+        constexpr uint64_t hashMultiplier = 0x9E3779B97F4A7C15;
+    }
+
+    bool BreakpointRecord::hasBreakpoints() const
+    {
+        return !globalBreakpoints.empty() || !breakpointsByDtb.empty();
+    }
+
+    bool BreakpointRecord::hasBreakpointsOfDtb(addr_t dtb) const
+    {
+        return breakpointsByDtb.contains(dtb);
+    }
+
+    std::vector<std::shared_ptr<Breakpoint>>* BreakpointRecord::findBreakpointsOfDtb(addr_t dtb)
+    {
+        // Spares hashing the DTB on hits of INT3s that only belong to global breakpoints
+        if (breakpointsByDtb.empty())
+        {
+            return nullptr;
+        }
+        auto breakpointsOfDtb = breakpointsByDtb.find(dtb);
+        return breakpointsOfDtb != breakpointsByDtb.end() ? &breakpointsOfDtb->second : nullptr;
+    }
+
+    BreakpointRecord* BreakpointTable::find(addr_t targetPA)
+    {
+        if (slots.empty())
+        {
+            return nullptr;
+        }
+        auto& record = slots[findSlot(targetPA)];
+        return record.targetPA != emptySlot ? &record : nullptr;
+    }
+
+    std::pair<BreakpointRecord&, bool> BreakpointTable::findOrInsert(addr_t targetPA)
+    {
+        if (slots.empty())
+        {
+            rehash(minimumSlotCountBits);
+        }
+        auto slot = findSlot(targetPA);
+        if (slots[slot].targetPA != emptySlot)
+        {
+            return {slots[slot], false};
+        }
+
+        // Load factor is kept at or below one half, so that probe sequences stay short
+        if ((recordCount + 1) * 2 > slots.size())
+        {
+            rehash(slotCountBits + 1);
+            slot = findSlot(targetPA);
+        }
+        slots[slot].targetPA = targetPA;
+        recordCount++;
+        return {slots[slot], true};
+    }
+
+    void BreakpointTable::erase(addr_t targetPA)
+    {
+        if (slots.empty())
+        {
+            return;
+        }
+        auto slot = findSlot(targetPA);
+        if (slots[slot].targetPA == emptySlot)
+        {
+            return;
+        }
+
+        // Records behind the erased one are shifted back into the gap if their probe sequence passes it, which makes
+        // tombstones unnecessary
+        auto mask = slots.size() - 1;
+        for (auto next = (slot + 1) & mask; slots[next].targetPA != emptySlot; next = (next + 1) & mask)
+        {
+            auto homeSlot = getHomeSlot(slots[next].targetPA);
+            if (((next - homeSlot) & mask) >= ((next - slot) & mask))
+            {
+                slots[slot] = std::move(slots[next]);
+                slot = next;
+            }
+        }
+        slots[slot] = BreakpointRecord{.targetPA = emptySlot};
+        recordCount--;
+    }
+
+    void BreakpointTable::clear()
+    {
+        slots.clear();
+        slotCountBits = 0;
+        recordCount = 0;
+    }
+
+    std::size_t BreakpointTable::size() const
+    {
+        return recordCount;
+    }
+
+    bool BreakpointTable::empty() const
+    {
+        return recordCount == 0;
+    }
+
+    void BreakpointTable::forEach(const std::function<void(BreakpointRecord&)>& visitor)
+    {
+        for (auto& record : slots)
+        {
+            if (record.targetPA != emptySlot)
+            {
+                visitor(record);
+            }
+        }
+    }
+
+    std::size_t BreakpointTable::getHomeSlot(addr_t targetPA) const
+    {
+        return static_cast<std::size_t>((targetPA * hashMultiplier) >> (64 - slotCountBits));
+    }
+
+    std::size_t BreakpointTable::findSlot(addr_t targetPA) const
+    {
+        auto mask = slots.size() - 1;
+        auto slot = getHomeSlot(targetPA);
+        while (slots[slot].targetPA != emptySlot && slots[slot].targetPA != targetPA)
+        {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void BreakpointTable::rehash(std::size_t newSlotCountBits)
+    {
+        auto oldSlots = std::move(slots);
+        slotCountBits = newSlotCountBits;
+        slots.clear();
+        slots.resize(std::size_t{1} << slotCountBits, BreakpointRecord{.targetPA = emptySlot});
+        for (auto& record : oldSlots)
+        {
+            if (record.targetPA != emptySlot)
+            {
+                slots[findSlot(record.targetPA)] = std::move(record);
+            }
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef VMICORE_BREAKPOINTTABLE_H
+#define VMICORE_BREAKPOINTTABLE_H
+
+#include "Breakpoint.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <libvmi/events.h>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vmicore/types.h>
+
+namespace VmiCore
+{
+    /**
+     * Everything that is known about a single INT3, i.e. about all breakpoints that share its physical address. The
+     * members that are needed on every hit come first and fit into the first cache line of the record.
+     */
+    struct alignas(64) BreakpointRecord
+    {
+        static constexpr std::size_t notListed = std::numeric_limits<std::size_t>::max();
+
+        addr_t targetPA;
+        uint8_t originalValue = 0;
+        BPStateResponse state = BPStateResponse::Disable;
+        std::vector<std::shared_ptr<Breakpoint>> globalBreakpoints{};
+        // Original instruction if the INT3 is emulated instead of single stepped
+        std::optional<emul_insn_t> emulatedInstruction{};
+
+        // Position within the list of INT3s that are toggled on context switches
+        std::size_t enabledListIndex = notListed;
+        // Process specific breakpoints by the address space they belong to, so that a hit only looks at those of the
+        // interrupted address space, no matter how many processes share the page
+        std::unordered_map<addr_t, std::vector<std::shared_ptr<Breakpoint>>> breakpointsByDtb{};
+
+        [[nodiscard]] bool hasBreakpoints() const;
+
+        [[nodiscard]] bool hasBreakpointsOfDtb(addr_t dtb) const;
+
+        // Returns nullptr if there are no process specific breakpoints of the given address space
+        [[nodiscard]] std::vector<std::shared_ptr<Breakpoint>>* findBreakpointsOfDtb(addr_t dtb);
+    };
+
+    /**
+     * Open addressing hash table of breakpoint records keyed by their physical address. Records are stored within the
+     * slots themselves, so that a hit costs a single probe in the common case. Note that records are moved by
+     * insertions and removals, hence pointers and references to them must not be kept across those.
+     */
+    class BreakpointTable
+    {
+      public:
+        [[nodiscard]] BreakpointRecord* find(addr_t targetPA);
+
+        /**
+         * @return The existing record at the given PA or a newly inserted one, together with whether it has been
+         * inserted.
+         */
+        std::pair<BreakpointRecord&, bool> findOrInsert(addr_t targetPA);
+
+        void erase(addr_t targetPA);
+
+        void clear();
+
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        void forEach(const std::function<void(BreakpointRecord&)>& visitor);
+
+      private:
+        // Physical addresses are below 2^52, hence this key never collides with a breakpoint
+        static constexpr addr_t emptySlot = std::numeric_limits<addr_t>::max();
+        static constexpr std::size_t minimumSlotCountBits = 4;
+
+        std::vector<BreakpointRecord> slots{};
+        std::size_t slotCountBits = 0;
+        std::size_t recordCount = 0;
+
+        [[nodiscard]] std::size_t getHomeSlot(addr_t targetPA) const;
+
+        // Returns the slot holding the given PA or the empty slot at which it would be inserted
+        [[nodiscard]] std::size_t findSlot(addr_t targetPA) const;
+
+        void rehash(std::size_t newSlotCountBits);
+    };
+}
+
+#endif // VMICORE_BREAKPOINTTABLE_H
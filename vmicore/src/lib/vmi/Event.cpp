@@ -120,4 +120,9 @@ namespace VmiCore
             }
         }
     }
+
+    uint32_t Event::getVcpuId() const
+    {
+        return libvmiEvent->vcpu_id;
+    }
 }
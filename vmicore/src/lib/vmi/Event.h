@@ -42,6 +42,8 @@ namespace VmiCore
 
         [[nodiscard]] addr_t getOffset() const override;
 
+        [[nodiscard]] uint32_t getVcpuId() const override;
+
       private:
         vmi_event_t* libvmiEvent;
     };
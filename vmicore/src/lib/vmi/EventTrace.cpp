@@ -0,0 +1,238 @@
+#include "EventTrace.h"
+#include <array>
+#include <fmt/core.h>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore/vmi/VmiException.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr std::array<char, 8> traceMagic{'V', 'M', 'I', 'T', 'R', 'A', 'C', 'E'};
+        constexpr uint32_t traceVersion = 1;
+
+        template <typename T> void writeValue(std::ofstream& stream, const T& value)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <typename T> bool readValue(std::ifstream& stream, T& value)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+        }
+    }
+
+    EventTraceRecord EventTraceRecord::fromEvent(const vmi_event_t& event)
+    {
+        EventTraceRecord record{};
+        record.type = event.type;
+        record.vcpuId = event.vcpu_id;
+        switch (event.type)
+        {
+            case VMI_EVENT_INTERRUPT:
+                record.gla = event.interrupt_event.gla;
+                record.gfn = event.interrupt_event.gfn;
+                record.offset = event.interrupt_event.offset;
+                break;
+            case VMI_EVENT_SINGLESTEP:
+                record.gla = event.ss_event.gla;
+                record.gfn = event.ss_event.gfn;
+                record.offset = event.ss_event.offset;
+                break;
+            case VMI_EVENT_MEMORY:
+                record.gla = event.mem_event.gla;
+                record.gfn = event.mem_event.gfn;
+                record.offset = event.mem_event.offset;
+                record.outAccess = event.mem_event.out_access;
+                break;
+            case VMI_EVENT_REGISTER:
+                record.registerValue = event.reg_event.value;
+                record.previousRegisterValue = event.reg_event.previous;
+                break;
+            default:
+                break;
+        }
+        if (event.x86_regs != nullptr)
+        {
+            record.registers = *event.x86_regs;
+        }
+        return record;
+    }
+
+    void EventTraceRecord::applyTo(vmi_event_t& event)
+    {
+        event.vcpu_id = vcpuId;
+        switch (type)
+        {
+            case VMI_EVENT_INTERRUPT:
+                event.interrupt_event.gla = gla;
+                event.interrupt_event.gfn = gfn;
+                event.interrupt_event.offset = offset;
+                break;
+            case VMI_EVENT_SINGLESTEP:
+                event.ss_event.gla = gla;
+                event.ss_event.gfn = gfn;
+                event.ss_event.offset = offset;
+                break;
+            case VMI_EVENT_MEMORY:
+                event.mem_event.gla = gla;
+                event.mem_event.gfn = gfn;
+                event.mem_event.offset = offset;
+                event.mem_event.out_access = static_cast<vmi_mem_access_t>(outAccess);
+                break;
+            case VMI_EVENT_REGISTER:
+                event.reg_event.value = registerValue;
+                event.reg_event.previous = previousRegisterValue;
+                break;
+            default:
+                break;
+        }
+        event.x86_regs = &registers;
+    }
+
+    EventTraceWriter::EventTraceWriter(const std::filesystem::path& tracePath)
+        : traceFile(tracePath, std::ios::binary | std::ios::trunc)
+    {
+        if (!traceFile)
+        {
+            throw VmiException(fmt::format("{}: Unable to create event trace {}", __func__, tracePath.string()));
+        }
+        traceFile.write(traceMagic.data(), traceMagic.size());
+        writeValue(traceFile, traceVersion);
+        writeValue(traceFile, static_cast<uint32_t>(sizeof(x86_registers_t)));
+    }
+
+    void EventTraceWriter::write(const EventTraceRecord& record)
+    {
+        writeValue(traceFile, static_cast<uint32_t>(record.type));
+        writeValue(traceFile, record.vcpuId);
+        writeValue(traceFile, record.gla);
+        writeValue(traceFile, record.gfn);
+        writeValue(traceFile, record.offset);
+        writeValue(traceFile, record.outAccess);
+        writeValue(traceFile, record.registerValue);
+        writeValue(traceFile, record.previousRegisterValue);
+        writeValue(traceFile, record.registers);
+        writeValue(traceFile, static_cast<uint32_t>(record.pages.size()));
+        for (const auto& page : record.pages)
+        {
+            writeValue(traceFile, page.dtb);
+            writeValue(traceFile, page.pageAddress);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            traceFile.write(reinterpret_cast<const char*>(page.content.data()),
+                            static_cast<std::streamsize>(PagingDefinitions::pageSizeInBytes));
+        }
+        if (!traceFile)
+        {
+            throw VmiException(fmt::format("{}: Unable to write event trace record", __func__));
+        }
+        numberOfRecords++;
+    }
+
+    uint64_t EventTraceWriter::getNumberOfRecords() const
+    {
+        return numberOfRecords;
+    }
+
+    EventRecorder::EventRecorder(PageReader readPage) : readPage(std::move(readPage)) {}
+
+    bool EventRecorder::isRecording() const
+    {
+        return !activeRecords.empty();
+    }
+
+    void EventRecorder::begin(const vmi_event_t& event)
+    {
+        activeRecords.insert_or_assign(std::this_thread::get_id(),
+                                       ActiveRecord{.record = EventTraceRecord::fromEvent(event), .capturedPages = {}});
+    }
+
+    void EventRecorder::capture(addr_t dtb, addr_t address, std::size_t size)
+    {
+        auto activeRecord = activeRecords.find(std::this_thread::get_id());
+        if (activeRecord == activeRecords.end() || size == 0)
+        {
+            return;
+        }
+        auto& [record, capturedPages] = activeRecord->second;
+        for (auto page = address & PagingDefinitions::stripPageOffsetMask; page < address + size;
+             page += PagingDefinitions::pageSizeInBytes)
+        {
+            if (!capturedPages.emplace(dtb, page).second)
+            {
+                continue;
+            }
+            EventTracePage tracePage{
+                .dtb = dtb, .pageAddress = page, .content = std::vector<uint8_t>(PagingDefinitions::pageSizeInBytes)};
+            if (readPage(dtb, page, tracePage.content))
+            {
+                record.pages.push_back(std::move(tracePage));
+            }
+        }
+    }
+
+    std::optional<EventTraceRecord> EventRecorder::finish()
+    {
+        auto activeRecord = activeRecords.extract(std::this_thread::get_id());
+        if (activeRecord.empty())
+        {
+            return std::nullopt;
+        }
+        return std::move(activeRecord.mapped().record);
+    }
+
+    EventTraceReader::EventTraceReader(const std::filesystem::path& tracePath) : traceFile(tracePath, std::ios::binary)
+    {
+        std::array<char, traceMagic.size()> magic{};
+        uint32_t version = 0;
+        uint32_t registersSize = 0;
+        if (!traceFile.read(magic.data(), magic.size()) || magic != traceMagic || !readValue(traceFile, version) ||
+            !readValue(traceFile, registersSize))
+        {
+            throw VmiException(fmt::format("{}: {} is not an event trace", __func__, tracePath.string()));
+        }
+        if (version != traceVersion || registersSize != sizeof(x86_registers_t))
+        {
+            throw VmiException(fmt::format("{}: Event trace {} has been recorded with an incompatible build",
+                                           __func__,
+                                           tracePath.string()));
+        }
+    }
+
+    std::optional<EventTraceRecord> EventTraceReader::next()
+    {
+        uint32_t type = 0;
+        if (!readValue(traceFile, type))
+        {
+            return std::nullopt;
+        }
+
+        EventTraceRecord record{};
+        record.type = static_cast<vmi_event_type_t>(type);
+        uint32_t numberOfPages = 0;
+        if (!readValue(traceFile, record.vcpuId) || !readValue(traceFile, record.gla) ||
+            !readValue(traceFile, record.gfn) || !readValue(traceFile, record.offset) ||
+            !readValue(traceFile, record.outAccess) || !readValue(traceFile, record.registerValue) ||
+            !readValue(traceFile, record.previousRegisterValue) || !readValue(traceFile, record.registers) ||
+            !readValue(traceFile, numberOfPages))
+        {
+            throw VmiException(fmt::format("{}: Event trace is truncated", __func__));
+        }
+
+        record.pages.resize(numberOfPages);
+        for (auto& page : record.pages)
+        {
+            page.content.resize(PagingDefinitions::pageSizeInBytes);
+            if (!readValue(traceFile, page.dtb) || !readValue(traceFile, page.pageAddress) ||
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                !traceFile.read(reinterpret_cast<char*>(page.content.data()),
+                                static_cast<std::streamsize>(page.content.size())))
+            {
+                throw VmiException(fmt::format("{}: Event trace is truncated", __func__));
+            }
+        }
+        return record;
+    }
+}
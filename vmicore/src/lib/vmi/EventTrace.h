@@ -0,0 +1,117 @@
+#ifndef VMICORE_EVENTTRACE_H
+#define VMICORE_EVENTTRACE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <libvmi/events.h>
+#include <optional>
+#include <set>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vmicore/types.h>
+
+namespace VmiCore
+{
+    /**
+     * Content of a guest page that has been read while handling an event. Pages read by their physical address are
+     * stored with a dtb of zero.
+     */
+    struct EventTracePage
+    {
+        addr_t dtb;
+        addr_t pageAddress;
+        std::vector<uint8_t> content;
+    };
+
+    /**
+     * Everything a callback may observe about a single libvmi event. Location and access fields are taken from the
+     * part of the event that matches its type.
+     */
+    struct EventTraceRecord
+    {
+        vmi_event_type_t type;
+        uint32_t vcpuId;
+        addr_t gla;
+        addr_t gfn;
+        addr_t offset;
+        uint32_t outAccess;
+        reg_t registerValue;
+        reg_t previousRegisterValue;
+        x86_registers_t registers;
+        std::vector<EventTracePage> pages;
+
+        [[nodiscard]] static EventTraceRecord fromEvent(const vmi_event_t& event);
+
+        // Writes the recorded state to an event that has been set up for the same type
+        void applyTo(vmi_event_t& event);
+    };
+
+    /**
+     * Binary trace files are written in host byte order and contain the register layout of the libvmi version used
+     * for recording. Replaying a trace with a different libvmi build is rejected.
+     */
+    class EventTraceWriter
+    {
+      public:
+        explicit EventTraceWriter(const std::filesystem::path& tracePath);
+
+        void write(const EventTraceRecord& record);
+
+        [[nodiscard]] uint64_t getNumberOfRecords() const;
+
+      private:
+        std::ofstream traceFile;
+        uint64_t numberOfRecords = 0;
+    };
+
+    /**
+     * Collects the guest pages accessed while an event is handled, in the state before the handler has written to any
+     * of them. Every page is read once, at its first access. Each thread records its own event, so accesses by other
+     * threads are not attributed to it. Not thread safe, callers have to serialize all calls.
+     */
+    class EventRecorder
+    {
+      public:
+        // Reads the whole page at the given address, which is physical for a dtb of zero
+        using PageReader = std::function<bool(addr_t dtb, addr_t pageAddress, std::span<uint8_t> content)>;
+
+        explicit EventRecorder(PageReader readPage);
+
+        [[nodiscard]] bool isRecording() const;
+
+        void begin(const vmi_event_t& event);
+
+        // Has to be called before guest memory is read or written on behalf of the event of the calling thread
+        void capture(addr_t dtb, addr_t address, std::size_t size);
+
+        [[nodiscard]] std::optional<EventTraceRecord> finish();
+
+      private:
+        struct ActiveRecord
+        {
+            EventTraceRecord record;
+            std::set<std::pair<addr_t, addr_t>> capturedPages;
+        };
+
+        PageReader readPage;
+        std::unordered_map<std::thread::id, ActiveRecord> activeRecords{};
+    };
+
+    class EventTraceReader
+    {
+      public:
+        explicit EventTraceReader(const std::filesystem::path& tracePath);
+
+        [[nodiscard]] std::optional<EventTraceRecord> next();
+
+      private:
+        std::ifstream traceFile;
+    };
+}
+
+#endif // VMICORE_EVENTTRACE_H
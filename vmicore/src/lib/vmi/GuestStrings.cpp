@@ -0,0 +1,158 @@
+#include "GuestStrings.h"
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace VmiCore::GuestStrings
+{
+    namespace
+    {
+        constexpr std::size_t codeUnitSize = sizeof(uint16_t);
+        // Worst case expansion, as code points outside of the BMP take two code units and four UTF-8 bytes
+        constexpr std::size_t maxUtf8BytesPerCodeUnit = 3;
+        constexpr char32_t replacementCharacter = 0xFFFD;
+
+        uint16_t readCodeUnit(const uint8_t* bytes)
+        {
+            return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+
+        bool isHighSurrogate(uint16_t codeUnit)
+        {
+            return codeUnit >= 0xD800 && codeUnit <= 0xDBFF;
+        }
+
+        bool isLowSurrogate(uint16_t codeUnit)
+        {
+            return codeUnit >= 0xDC00 && codeUnit <= 0xDFFF;
+        }
+
+        char* encodeUtf8(char32_t codePoint, char* destination)
+        {
+            // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (codePoint < 0x80)
+            {
+                *destination++ = static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                *destination++ = static_cast<char>(0xC0 | (codePoint >> 6));
+                *destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                *destination++ = static_cast<char>(0xE0 | (codePoint >> 12));
+                *destination++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                *destination++ = static_cast<char>(0xF0 | (codePoint >> 18));
+                *destination++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                *destination++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *destination++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return destination;
+        }
+    }
+
+    std::optional<std::size_t> findTerminator(std::span<const uint8_t> bytes)
+    {
+        // memchr is already vectorized by the C library
+        const auto* terminator = static_cast<const uint8_t*>(std::memchr(bytes.data(), 0, bytes.size()));
+        if (terminator == nullptr)
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>(terminator - bytes.data());
+    }
+
+    std::optional<std::size_t> findUtf16Terminator(std::span<const uint8_t> bytes)
+    {
+        const auto unitCount = bytes.size() / codeUnitSize;
+        std::size_t unit = 0;
+#ifdef __SSE2__
+        constexpr std::size_t unitsPerVector = sizeof(__m128i) / codeUnitSize;
+        const auto zero = _mm_setzero_si128();
+        for (; unit + unitsPerVector <= unitCount; unit += unitsPerVector)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            auto units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[unit * codeUnitSize]));
+            if (auto mask = _mm_movemask_epi8(_mm_cmpeq_epi16(units, zero)); mask != 0)
+            {
+                // Each matching code unit sets two adjacent mask bits
+                return unit * codeUnitSize + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+            }
+        }
+#endif
+        for (; unit < unitCount; unit++)
+        {
+            if (readCodeUnit(&bytes[unit * codeUnitSize]) == 0)
+            {
+                return unit * codeUnitSize;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void appendUtf16LeAsUtf8(std::span<const uint8_t> utf16le, std::string& destination)
+    {
+        const auto unitCount = utf16le.size() / codeUnitSize;
+        const auto initialSize = destination.size();
+        destination.resize(initialSize + unitCount * maxUtf8BytesPerCodeUnit);
+        auto* output = &destination[initialSize];
+
+        std::size_t unit = 0;
+        while (unit < unitCount)
+        {
+#ifdef __SSE2__
+            // ASCII fast path, narrows eight code units at once as long as all of them are below 0x80
+            constexpr std::size_t unitsPerVector = sizeof(__m128i) / codeUnitSize;
+            const auto nonAsciiBits = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+            const auto zero = _mm_setzero_si128();
+            for (; unit + unitsPerVector <= unitCount; unit += unitsPerVector)
+            {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                auto units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&utf16le[unit * codeUnitSize]));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, nonAsciiBits), zero)) != 0xFFFF)
+                {
+                    break;
+                }
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(units, units));
+                output += unitsPerVector; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            if (unit >= unitCount)
+            {
+                break;
+            }
+#endif
+            char32_t codePoint = readCodeUnit(&utf16le[unit * codeUnitSize]);
+            unit++;
+            if (isHighSurrogate(static_cast<uint16_t>(codePoint)))
+            {
+                if (unit < unitCount && isLowSurrogate(readCodeUnit(&utf16le[unit * codeUnitSize])))
+                {
+                    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+                                (readCodeUnit(&utf16le[unit * codeUnitSize]) - 0xDC00);
+                    unit++;
+                }
+                else
+                {
+                    codePoint = replacementCharacter;
+                }
+            }
+            else if (isLowSurrogate(static_cast<uint16_t>(codePoint)))
+            {
+                codePoint = replacementCharacter;
+            }
+            output = encodeUtf8(codePoint, output);
+        }
+
+        destination.resize(static_cast<std::size_t>(output - destination.data()));
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef VMICORE_GUESTSTRINGS_H
+#define VMICORE_GUESTSTRINGS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace VmiCore::GuestStrings
+{
+    /**
+     * @return Offset of the first zero byte or std::nullopt if there is none.
+     */
+    [[nodiscard]] std::optional<std::size_t> findTerminator(std::span<const uint8_t> bytes);
+
+    /**
+     * Searches for a zero UTF-16 code unit. Code units are expected to start at the beginning of the given span, a
+     * trailing odd byte is ignored.
+     *
+     * @return Byte offset of the terminating code unit or std::nullopt if there is none.
+     */
+    [[nodiscard]] std::optional<std::size_t> findUtf16Terminator(std::span<const uint8_t> bytes);
+
+    /**
+     * Converts little endian UTF-16 to UTF-8 and appends the result to the destination. Unpaired surrogates are
+     * replaced with U+FFFD instead of failing the whole conversion, a trailing odd byte is ignored.
+     */
+    void appendUtf16LeAsUtf8(std::span<const uint8_t> utf16le, std::string& destination);
+}
+
+#endif // VMICORE_GUESTSTRINGS_H
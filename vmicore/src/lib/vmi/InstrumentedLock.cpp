@@ -0,0 +1,76 @@
+#include "InstrumentedLock.h"
+
+namespace VmiCore
+{
+    namespace
+    {
+        void updateMaximum(std::atomic<uint64_t>& maximum, uint64_t value)
+        {
+            auto current = maximum.load(std::memory_order_relaxed);
+            while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        uint64_t toNanoseconds(std::chrono::steady_clock::duration duration)
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+    }
+
+    void LockSiteStatistics::record(uint64_t waitNs, uint64_t holdNs)
+    {
+        acquisitions.fetch_add(1, std::memory_order_relaxed);
+        totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+        totalHoldNs.fetch_add(holdNs, std::memory_order_relaxed);
+        updateMaximum(maxWaitNs, waitNs);
+        updateMaximum(maxHoldNs, holdNs);
+    }
+
+    std::size_t LockSiteHash::operator()(const LockSite& site) const
+    {
+        return std::hash<const char*>{}(site.functionName) ^ (std::hash<uint_least32_t>{}(site.line) << 1);
+    }
+
+    LockSiteStatistics& LockStatistics::getSite(const std::source_location& location)
+    {
+        LockSite key{location.function_name(), location.line()};
+        {
+            std::shared_lock lock(sitesLock);
+            if (auto site = sites.find(key); site != sites.end())
+            {
+                return site->second;
+            }
+        }
+
+        std::unique_lock lock(sitesLock);
+        return sites.try_emplace(key).first->second;
+    }
+
+    void LockStatistics::forEachSite(
+        const std::function<void(std::string_view, uint_least32_t, const LockSiteStatistics&)>& visitor) const
+    {
+        std::shared_lock lock(sitesLock);
+        for (const auto& [key, site] : sites)
+        {
+            visitor(key.functionName, key.line, site);
+        }
+    }
+
+    InstrumentedLockGuard::InstrumentedLockGuard(std::mutex& mutex,
+                                                 LockStatistics& statistics,
+                                                 const std::source_location& location)
+        : site(statistics.getSite(location)),
+          waitStart(std::chrono::steady_clock::now()),
+          lock(mutex),
+          acquired(std::chrono::steady_clock::now())
+    {
+    }
+
+    InstrumentedLockGuard::~InstrumentedLockGuard()
+    {
+        auto released = std::chrono::steady_clock::now();
+        lock.unlock();
+        site.record(toNanoseconds(acquired - waitStart), toNanoseconds(released - acquired));
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef VMICORE_INSTRUMENTEDLOCK_H
+#define VMICORE_INSTRUMENTEDLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <source_location>
+#include <string_view>
+#include <unordered_map>
+
+namespace VmiCore
+{
+    struct LockSiteStatistics
+    {
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> totalWaitNs{0};
+        std::atomic<uint64_t> maxWaitNs{0};
+        std::atomic<uint64_t> totalHoldNs{0};
+        std::atomic<uint64_t> maxHoldNs{0};
+
+        void record(uint64_t waitNs, uint64_t holdNs);
+    };
+
+    struct LockSite
+    {
+        // Function names are string literals, hence their addresses identify the function
+        const char* functionName;
+        uint_least32_t line;
+
+        bool operator==(const LockSite&) const = default;
+    };
+
+    struct LockSiteHash
+    {
+        std::size_t operator()(const LockSite& site) const;
+    };
+
+    /**
+     * Collects lock wait and hold times per call site. Known call sites are looked up under a shared lock and updated
+     * atomically, so recording does not serialize callers any further.
+     */
+    class LockStatistics
+    {
+      public:
+        LockSiteStatistics& getSite(const std::source_location& location);
+
+        void forEachSite(
+            const std::function<void(std::string_view, uint_least32_t, const LockSiteStatistics&)>& visitor) const;
+
+      private:
+        mutable std::shared_mutex sitesLock;
+        std::unordered_map<LockSite, LockSiteStatistics, LockSiteHash> sites;
+    };
+
+    /**
+     * Scoped lock that measures the time spent waiting for and holding the given mutex.
+     */
+    class InstrumentedLockGuard
+    {
+      public:
+        InstrumentedLockGuard(std::mutex& mutex,
+                              LockStatistics& statistics,
+                              const std::source_location& location = std::source_location::current());
+
+        ~InstrumentedLockGuard();
+
+        InstrumentedLockGuard(const InstrumentedLockGuard&) = delete;
+
+        InstrumentedLockGuard(const InstrumentedLockGuard&&) = delete;
+
+        InstrumentedLockGuard& operator=(const InstrumentedLockGuard&) = delete;
+
+        InstrumentedLockGuard& operator=(const InstrumentedLockGuard&&) = delete;
+
+      private:
+        LockSiteStatistics& site;
+        std::chrono::steady_clock::time_point waitStart;
+        std::unique_lock<std::mutex> lock;
+        std::chrono::steady_clock::time_point acquired;
+    };
+}
+
+#endif // VMICORE_INSTRUMENTEDLOCK_H
@@ -1,7 +1,11 @@
 #include "InterruptEventSupervisor.h"
 #include "Event.h"
-#include "InterruptGuard.h"
+#include "InterruptGuardManager.h"
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <span>
+#include <unordered_set>
 #include <vmicore/callback.h>
 #include <vmicore/filename.h>
 #include <vmicore/os/PagingDefinitions.h>
@@ -13,6 +17,129 @@ namespace VmiCore
     {
         InterruptEventSupervisor* interruptEventSupervisor = nullptr;
         constexpr auto loggerName = FILENAME_STEM;
+
+        // Pauses the guest for the lifetime of the object, so that it is resumed on every exit path
+        class ScopedVmPause
+        {
+          public:
+            explicit ScopedVmPause(ILibvmiInterface& vmiInterface) : vmiInterface(vmiInterface)
+            {
+                vmiInterface.pauseVm();
+            }
+
+            ~ScopedVmPause()
+            {
+                try
+                {
+                    vmiInterface.resumeVm();
+                }
+                catch (const std::exception& e)
+                {
+                    GlobalControl::logger()->error("Unable to resume guest", {{"exception", e.what()}});
+                }
+            }
+
+            ScopedVmPause(const ScopedVmPause&) = delete;
+
+            ScopedVmPause(const ScopedVmPause&&) = delete;
+
+            ScopedVmPause& operator=(const ScopedVmPause&) = delete;
+
+            ScopedVmPause& operator=(const ScopedVmPause&&) = delete;
+
+          private:
+            ILibvmiInterface& vmiInterface;
+        };
+
+        bool isInstructionPrefix(uint8_t value)
+        {
+            switch (value)
+            {
+                case 0x26:
+                case 0x2E:
+                case 0x36:
+                case 0x3E:
+                case 0x64:
+                case 0x65:
+                case 0x66:
+                case 0x67:
+                case 0xF0:
+                case 0xF2:
+                case 0xF3:
+                    return true;
+                default:
+                    // REX prefixes
+                    return (value & 0xF0) == 0x40;
+            }
+        }
+
+        // Instructions that access I/O ports, privileged state or the IDT are executed natively, because the emulator
+        // of the hypervisor either does not support them or must not repeat their side effects. The same applies to
+        // VEX and EVEX encoded vector instructions. Unrecognized encodings therefore only cost the single step.
+        bool isEmulatable(std::span<const uint8_t> instruction)
+        {
+            auto opcode = std::find_if_not(instruction.begin(), instruction.end(), isInstructionPrefix);
+            if (opcode == instruction.end())
+            {
+                return false;
+            }
+            switch (*opcode)
+            {
+                case 0x62:
+                case 0xC4:
+                case 0xC5:
+                case 0x6C:
+                case 0x6D:
+                case 0x6E:
+                case 0x6F:
+                case 0xE4:
+                case 0xE5:
+                case 0xE6:
+                case 0xE7:
+                case 0xEC:
+                case 0xED:
+                case 0xEE:
+                case 0xEF:
+                case 0xCC:
+                case 0xCD:
+                case 0xCE:
+                case 0xCF:
+                case 0xF1:
+                case 0xF4:
+                    return false;
+                case 0x0F:
+                {
+                    if (std::next(opcode) == instruction.end())
+                    {
+                        return false;
+                    }
+                    switch (*std::next(opcode))
+                    {
+                        case 0x00:
+                        case 0x01:
+                        case 0x05:
+                        case 0x06:
+                        case 0x07:
+                        case 0x08:
+                        case 0x09:
+                        case 0x0B:
+                        case 0x22:
+                        case 0x23:
+                        case 0x30:
+                        case 0x31:
+                        case 0x32:
+                        case 0x34:
+                        case 0x35:
+                        case 0xA2:
+                            return false;
+                        default:
+                            return true;
+                    }
+                }
+                default:
+                    return true;
+            }
+        }
     }
 
     InterruptEventSupervisor::InterruptEventSupervisor(
@@ -20,13 +147,16 @@ namespace VmiCore
         std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor,
         std::shared_ptr<IActiveProcessesSupervisor> activeProcessesSupervisor,
         std::shared_ptr<IRegisterEventSupervisor> registerEventSupervisor,
-        std::shared_ptr<ILogging> loggingLib)
+        std::shared_ptr<ILogging> loggingLib,
+        BreakpointMode breakpointMode)
         : vmiInterface(std::move(vmiInterface)),
           singleStepSupervisor(std::move(singleStepSupervisor)),
           activeProcessesSupervisor(std::move(activeProcessesSupervisor)),
           registerEventSupervisor(std::move(registerEventSupervisor)),
           loggingLib(std::move(loggingLib)),
-          logger(this->loggingLib->newNamedLogger(loggerName))
+          logger(this->loggingLib->newNamedLogger(loggerName)),
+          breakpointMode(breakpointMode),
+          guardManager(this->vmiInterface, this->loggingLib)
     {
         interruptEventSupervisor = this;
     }
@@ -42,14 +172,22 @@ namespace VmiCore
         event->interrupt_event.reinject = DONT_REINJECT_INTERRUPT;
         event->interrupt_event.insn_length = 1;
         vmiInterface->registerEvent(*event);
+        guardManager.initialize();
         singleStepSupervisor->initializeSingleStepEvents();
-        singleStepCallbackFunction = VMICORE_SETUP_SAFE_MEMBER_CALLBACK(singleStepCallback);
         contextSwitchCallbackFunction = VMICORE_SETUP_SAFE_MEMBER_CALLBACK(contextSwitchCallback);
         registerEventSupervisor->setContextSwitchCallback(contextSwitchCallbackFunction);
     }
 
     void InterruptEventSupervisor::teardown()
     {
+        if (emulatedHits + singleStepHits + filteredHits > 0)
+        {
+            logger->info("Breakpoint statistics",
+                         {{"emulatedHits", emulatedHits},
+                          {"singleStepHits", singleStepHits},
+                          {"filteredHits", filteredHits},
+                          {"deliveredHits", deliveredHits}});
+        }
         clearInterruptEventHandling();
         singleStepSupervisor->teardown();
         registerEventSupervisor->teardown();
@@ -61,11 +199,164 @@ namespace VmiCore
                                                const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
                                                bool global)
     {
-        auto processDtb = targetVA >= PagingDefinitions::kernelspaceLowerBoundary ? processInformation.processDtb
-                                                                                  : processInformation.processUserDtb;
+        return createBreakpoint(targetVA, processInformation, callbackFunction, global, std::nullopt);
+    }
+
+    std::shared_ptr<IBreakpoint>
+    InterruptEventSupervisor::createBreakpoint(uint64_t targetVA,
+                                               const ActiveProcessInformation& processInformation,
+                                               const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
+                                               bool global,
+                                               const std::optional<BreakpointFilter>& filter)
+    {
+        auto processDtb = getTranslationDtb(targetVA, processInformation);
+        // Only the address space of the target is refreshed, so that the breakpoint lands on the frame the page is
+        // currently mapped to while translations of all other address spaces stay warm
+        vmiInterface->flushV2PCache(processDtb);
         auto targetPA = vmiInterface->convertVAToPA(targetVA, processDtb);
         auto targetGFN = targetPA >> PagingDefinitions::numberOfPageIndexBits;
-        auto breakpoint = std::make_shared<Breakpoint>(
+        auto breakpoint = makeBreakpoint(targetPA, callbackFunction, processDtb, global, filter);
+
+        std::scoped_lock guard(lock);
+        auto& bpPage = getOrCreateBpPage(targetGFN, targetVA, processDtb);
+        try
+        {
+            guardManager.commitGuards();
+            registerBreakpoint(bpPage, breakpoint, processInformation);
+        }
+        catch (const std::exception&)
+        {
+            removePageIfUnused(targetGFN);
+            guardManager.commitGuards();
+            throw;
+        }
+        return breakpoint;
+    }
+
+    bool InterruptEventSupervisor::createBreakpoints(const ActiveProcessInformation& processInformation,
+                                                     std::span<BreakpointSpec> breakpointSpecs,
+                                                     bool global)
+    {
+        struct ResolvedBreakpoint
+        {
+            BreakpointSpec& spec;
+            addr_t processDtb;
+            std::shared_ptr<Breakpoint> breakpoint;
+        };
+
+        // Kernel and user space targets may require different address spaces, each of which is flushed only once
+        std::unordered_set<addr_t> flushedDtbs;
+        std::map<addr_t, std::vector<ResolvedBreakpoint>> resolvedBreakpointsByGFN;
+        bool allCreated = true;
+        for (auto& spec : breakpointSpecs)
+        {
+            try
+            {
+                auto processDtb = getTranslationDtb(spec.targetVA, processInformation);
+                if (flushedDtbs.insert(processDtb).second)
+                {
+                    vmiInterface->flushV2PCache(processDtb);
+                }
+                auto targetPA = vmiInterface->convertVAToPA(spec.targetVA, processDtb);
+                auto breakpoint = makeBreakpoint(targetPA, spec.callbackFunction, processDtb, global, spec.filter);
+                resolvedBreakpointsByGFN[targetPA >> PagingDefinitions::numberOfPageIndexBits].push_back(
+                    {spec, processDtb, std::move(breakpoint)});
+            }
+            catch (const std::exception& e)
+            {
+                spec.error = e.what();
+                allCreated = false;
+            }
+        }
+
+        auto setError = [&allCreated](std::vector<ResolvedBreakpoint>& resolvedBreakpoints, const char* error)
+        {
+            for (auto& resolvedBreakpoint : resolvedBreakpoints)
+            {
+                resolvedBreakpoint.spec.error = error;
+            }
+            allCreated = false;
+        };
+
+        {
+            ScopedVmPause pause(*vmiInterface);
+            std::scoped_lock guard(lock);
+            // All new pages are guarded at once before any INT3 is written to them
+            std::vector<addr_t> targetGFNs;
+            for (auto& [targetGFN, resolvedBreakpoints] : resolvedBreakpointsByGFN)
+            {
+                try
+                {
+                    const auto& firstBreakpoint = resolvedBreakpoints.front();
+                    getOrCreateBpPage(targetGFN, firstBreakpoint.spec.targetVA, firstBreakpoint.processDtb);
+                    targetGFNs.push_back(targetGFN);
+                }
+                catch (const std::exception& e)
+                {
+                    setError(resolvedBreakpoints, e.what());
+                }
+            }
+            try
+            {
+                guardManager.commitGuards();
+            }
+            catch (const std::exception& e)
+            {
+                // Pages without INT3s have just been added, so it is unknown whether they are guarded
+                for (auto targetGFN : targetGFNs)
+                {
+                    if (bpPagesByGFN.at(targetGFN).Int3Count == 0)
+                    {
+                        setError(resolvedBreakpointsByGFN.at(targetGFN), e.what());
+                        removePageIfUnused(targetGFN);
+                    }
+                }
+                std::erase_if(targetGFNs, [this](addr_t targetGFN) { return !bpPagesByGFN.contains(targetGFN); });
+            }
+
+            for (auto targetGFN : targetGFNs)
+            {
+                auto& bpPage = bpPagesByGFN.at(targetGFN);
+                for (auto& resolvedBreakpoint : resolvedBreakpointsByGFN.at(targetGFN))
+                {
+                    try
+                    {
+                        registerBreakpoint(bpPage, resolvedBreakpoint.breakpoint, processInformation);
+                        resolvedBreakpoint.spec.breakpoint = std::move(resolvedBreakpoint.breakpoint);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        resolvedBreakpoint.spec.error = e.what();
+                        allCreated = false;
+                    }
+                }
+                removePageIfUnused(targetGFN);
+            }
+            guardManager.commitGuards();
+        }
+
+        return allCreated;
+    }
+
+    addr_t InterruptEventSupervisor::getTranslationDtb(uint64_t targetVA,
+                                                       const ActiveProcessInformation& processInformation)
+    {
+        return targetVA >= PagingDefinitions::kernelspaceLowerBoundary ? processInformation.processDtb
+                                                                       : processInformation.processUserDtb;
+    }
+
+    std::shared_ptr<Breakpoint>
+    InterruptEventSupervisor::makeBreakpoint(addr_t targetPA,
+                                             const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
+                                             addr_t processDtb,
+                                             bool global,
+                                             const std::optional<BreakpointFilter>& filter)
+    {
+        if (filter)
+        {
+            validateFilter(*filter);
+        }
+        return std::make_shared<Breakpoint>(
             targetPA,
             [supervisor = weak_from_this()](Breakpoint* bp)
             {
@@ -76,43 +367,91 @@ namespace VmiCore
             },
             callbackFunction,
             processDtb,
-            global);
+            global,
+            filter);
+    }
 
-        std::scoped_lock guard(lock);
-        auto bpPage = breakpointsByGFN.find(targetGFN);
+    void InterruptEventSupervisor::validateFilter(const BreakpointFilter& filter)
+    {
+        if (filter.conditions.size() > BreakpointFilter::maxConditions)
+        {
+            throw VmiException(fmt::format("{}: Filter exceeds the maximum of {} conditions",
+                                           __func__,
+                                           BreakpointFilter::maxConditions));
+        }
+        for (const auto& condition : filter.conditions)
+        {
+            if (condition.memoryReadSize != 0 && condition.memoryReadSize != sizeof(uint8_t) &&
+                condition.memoryReadSize != sizeof(uint32_t) && condition.memoryReadSize != sizeof(uint64_t))
+            {
+                throw VmiException(
+                    fmt::format("{}: Unsupported filter memory read size {}", __func__, condition.memoryReadSize));
+            }
+        }
+    }
+
+    InterruptEventSupervisor::BpPage&
+    InterruptEventSupervisor::getOrCreateBpPage(uint64_t targetGFN, uint64_t targetVA, uint64_t processDtb)
+    {
+        auto bpPage = bpPagesByGFN.find(targetGFN);
         // Check if there already is an interrupt registered on this page
-        if (bpPage == breakpointsByGFN.end())
+        if (bpPage == bpPagesByGFN.end())
         {
-            bpPage =
-                breakpointsByGFN
-                    .insert({targetGFN,
-                             BpPage{.Breakpoints = {},
-                                    // One PageGuard guards a whole memory page on which several interrupts may reside
-                                    .PageGuard = createPageGuard(targetVA, processDtb, targetGFN)}})
-                    .first;
+            // One guard covers a whole memory page on which several interrupts may reside
+            guardManager.addGuard(targetGFN, targetVA, processDtb);
+            bpPage = bpPagesByGFN.emplace(targetGFN, BpPage{}).first;
         }
+        return bpPage->second;
+    }
 
+    void InterruptEventSupervisor::registerBreakpoint(BpPage& bpPage,
+                                                      const std::shared_ptr<Breakpoint>& breakpoint,
+                                                      const ActiveProcessInformation& processInformation)
+    {
+        auto targetPA = breakpoint->getTargetPA();
         // Register new INT3
-        if (!bpPage->second.Breakpoints.contains(targetPA))
+        if (breakpointTable.find(targetPA) == nullptr)
         {
-            vmiInterface->flushV2PCache(LibvmiInterface::flushAllPTs);
-            vmiInterface->flushPageCache();
-            storeOriginalValue(targetPA);
-            enableEvent(targetPA);
+            auto originalValue = readOriginalValue(targetPA);
+            auto& newRecord = breakpointTable.findOrInsert(targetPA).first;
+            newRecord.originalValue = originalValue;
+            if (breakpointMode == BreakpointMode::Emulate)
+            {
+                prepareEmulation(newRecord);
+            }
+            bpPage.Int3Count++;
+        }
 
-            bpPage->second.Breakpoints[targetPA] = std::vector<std::shared_ptr<Breakpoint>>{breakpoint};
+        auto& record = *breakpointTable.find(targetPA);
+        addBreakpointReference(record, breakpoint, processInformation);
+        try
+        {
+            // Either a new INT3 or an already registered one that is currently disabled for another process
+            if (record.state == BPStateResponse::Disable)
+            {
+                enableEvent(record);
+            }
         }
-        // If there is already an interrupt registered to that PA, simply add the event to management
-        else
+        catch (const std::exception&)
         {
-            bpPage->second.Breakpoints.at(targetPA).push_back(breakpoint);
-            // The already registered interrupt is for another process
-            if (paToBreakpointStatus.at(targetPA) == BPStateResponse::Disable)
+            removeBreakpointReference(record, *breakpoint);
+            if (!record.hasBreakpoints())
             {
-                enableEvent(targetPA);
+                breakpointTable.erase(targetPA);
+                bpPage.Int3Count--;
             }
+            throw;
+        }
+    }
+
+    void InterruptEventSupervisor::removePageIfUnused(uint64_t targetGFN)
+    {
+        auto bpPage = bpPagesByGFN.find(targetGFN);
+        if (bpPage != bpPagesByGFN.end() && bpPage->second.Int3Count == 0)
+        {
+            guardManager.removeGuard(targetGFN);
+            bpPagesByGFN.erase(bpPage);
         }
-        return breakpoint;
     }
 
     void InterruptEventSupervisor::deleteBreakpoint(IBreakpoint* breakpoint)
@@ -120,53 +459,168 @@ namespace VmiCore
         std::scoped_lock guard(lock);
 
         auto targetPA = breakpoint->getTargetPA();
-        auto breakpointsAtGFN = breakpointsByGFN.find(targetPA >> PagingDefinitions::numberOfPageIndexBits);
-        if (breakpointsAtGFN == breakpointsByGFN.end())
+        auto* record = breakpointTable.find(targetPA);
+        if (record == nullptr)
         {
             logger->warning("Breakpoint not found",
                             {{"Function", std::source_location::current().function_name()}, {"PA", targetPA}});
             vmiInterface->resumeVm();
             return;
         }
-        auto breakpointsAtPA = breakpointsAtGFN->second.Breakpoints.find(targetPA);
 
-        eraseBreakpointAtAddress(breakpointsAtPA->second, breakpoint);
-        if (breakpointsAtPA->second.empty())
+        // Every handle that is passed in has been created by this supervisor
+        auto removedBreakpoint = removeBreakpointReference(*record, dynamic_cast<const Breakpoint&>(*breakpoint));
+        if (record->hasBreakpoints())
         {
-            breakpointsAtGFN->second.Breakpoints.erase(breakpointsAtPA);
+            return;
+        }
 
-            if (vmiInterface->areEventsPending())
-            {
-                logger->debug(fmt::format("{}: Process pending events before removing breakpoint", __func__));
-                // Make sure that all pending events are processed, so we don't receive interrupt events for removed
-                // breakpoints
-                vmiInterface->eventsListen(0);
-            }
+        if (vmiInterface->areEventsPending())
+        {
+            logger->debug(fmt::format("{}: Process pending events before removing breakpoint", __func__));
+            // Make sure that all pending events are processed, so we don't receive interrupt events for removed
+            // breakpoints
+            vmiInterface->eventsListen(0);
+        }
 
-            removeInterrupt(targetPA);
-            if (breakpointsAtGFN->second.Breakpoints.empty())
-            {
-                breakpointsAtGFN->second.PageGuard->teardown();
-                breakpointsByGFN.erase(breakpointsAtGFN);
-            }
+        removeInterrupt(targetPA);
+        auto bpPage = bpPagesByGFN.find(targetPA >> PagingDefinitions::numberOfPageIndexBits);
+        if (--bpPage->second.Int3Count == 0)
+        {
+            guardManager.removeGuard(bpPage->first);
+            guardManager.commitGuards();
+            bpPagesByGFN.erase(bpPage);
+        }
+    }
+
+    void InterruptEventSupervisor::enableEvent(BreakpointRecord& record)
+    {
+        vmiInterface->write8PA(record.targetPA, INT3_BREAKPOINT);
+        record.state = BPStateResponse::Enable;
+        if (record.globalBreakpoints.empty())
+        {
+            trackEnabledPA(record);
+        }
+    }
+
+    void InterruptEventSupervisor::disableEvent(BreakpointRecord& record)
+    {
+        vmiInterface->write8PA(record.targetPA, record.originalValue);
+        record.state = BPStateResponse::Disable;
+        untrackEnabledPA(record);
+    }
+
+    void InterruptEventSupervisor::trackEnabledPA(BreakpointRecord& record)
+    {
+        if (record.enabledListIndex == BreakpointRecord::notListed)
+        {
+            record.enabledListIndex = enabledProcessSpecificPAs.size();
+            enabledProcessSpecificPAs.push_back(record.targetPA);
         }
     }
 
-    void InterruptEventSupervisor::enableEvent(addr_t targetPA)
+    void InterruptEventSupervisor::untrackEnabledPA(BreakpointRecord& record)
     {
-        vmiInterface->write8PA(targetPA, INT3_BREAKPOINT);
-        paToBreakpointStatus[targetPA] = BPStateResponse::Enable;
+        if (record.enabledListIndex == BreakpointRecord::notListed)
+        {
+            return;
+        }
+        // The last entry takes over the position of the removed one
+        auto lastPA = enabledProcessSpecificPAs.back();
+        enabledProcessSpecificPAs[record.enabledListIndex] = lastPA;
+        enabledProcessSpecificPAs.pop_back();
+        if (lastPA != record.targetPA)
+        {
+            breakpointTable.find(lastPA)->enabledListIndex = record.enabledListIndex;
+        }
+        record.enabledListIndex = BreakpointRecord::notListed;
     }
 
-    void InterruptEventSupervisor::disableEvent(addr_t targetPA)
+    void InterruptEventSupervisor::addBreakpointReference(BreakpointRecord& record,
+                                                          const std::shared_ptr<Breakpoint>& breakpoint,
+                                                          const ActiveProcessInformation& processInformation)
     {
-        vmiInterface->write8PA(targetPA, originalValuesByTargetPA[targetPA]);
-        paToBreakpointStatus[targetPA] = BPStateResponse::Disable;
+        breakpointChangeCount++;
+        if (breakpoint->isGlobal())
+        {
+            record.globalBreakpoints.push_back(breakpoint);
+            // INT3s that are shared with a global breakpoint are not toggled on context switches anymore
+            untrackEnabledPA(record);
+            return;
+        }
+
+        if (processInformation.processDtb != 0 && processInformation.processUserDtb != 0 &&
+            processInformation.processDtb != processInformation.processUserDtb)
+        {
+            kptiPeerDtbs[processInformation.processDtb] = processInformation.processUserDtb;
+            kptiPeerDtbs[processInformation.processUserDtb] = processInformation.processDtb;
+        }
+        // Context switches only need to be observed as long as there are process specific breakpoints
+        if (targetPAsByDtb.empty())
+        {
+            lastContextSwitchDtb.reset();
+            registerEventSupervisor->enableContextSwitchEvent();
+        }
+        auto& breakpointsOfDtb = record.breakpointsByDtb[breakpoint->getDtb()];
+        if (breakpointsOfDtb.empty())
+        {
+            targetPAsByDtb[breakpoint->getDtb()].push_back(record.targetPA);
+        }
+        breakpointsOfDtb.push_back(breakpoint);
+    }
+
+    std::shared_ptr<Breakpoint> InterruptEventSupervisor::removeBreakpointReference(BreakpointRecord& record,
+                                                                                    const Breakpoint& breakpoint)
+    {
+        breakpointChangeCount++;
+        auto dtb = breakpoint.getDtb();
+        if (breakpoint.isGlobal())
+        {
+            auto removedBreakpoint = eraseBreakpointAtAddress(record.globalBreakpoints, &breakpoint);
+            // Remaining process specific breakpoints at this PA are subject to context switches again
+            if (record.globalBreakpoints.empty() && record.state == BPStateResponse::Enable)
+            {
+                trackEnabledPA(record);
+            }
+            return removedBreakpoint;
+        }
+
+        auto breakpointsOfDtb = record.breakpointsByDtb.find(dtb);
+        auto removedBreakpoint = eraseBreakpointAtAddress(breakpointsOfDtb->second, &breakpoint);
+        if (!breakpointsOfDtb->second.empty())
+        {
+            return removedBreakpoint;
+        }
+        record.breakpointsByDtb.erase(breakpointsOfDtb);
+
+        auto targetPAsOfDtb = targetPAsByDtb.find(dtb);
+        auto targetPA = std::find(targetPAsOfDtb->second.begin(), targetPAsOfDtb->second.end(), record.targetPA);
+        *targetPA = targetPAsOfDtb->second.back();
+        targetPAsOfDtb->second.pop_back();
+        if (!targetPAsOfDtb->second.empty())
+        {
+            return removedBreakpoint;
+        }
+
+        targetPAsByDtb.erase(targetPAsOfDtb);
+        if (auto peerDtb = kptiPeerDtbs.find(dtb);
+            peerDtb != kptiPeerDtbs.end() && !targetPAsByDtb.contains(peerDtb->second))
+        {
+            kptiPeerDtbs.erase(peerDtb->second);
+            kptiPeerDtbs.erase(peerDtb);
+        }
+        if (targetPAsByDtb.empty())
+        {
+            registerEventSupervisor->disableContextSwitchEvent();
+        }
+        return removedBreakpoint;
     }
 
     event_response_t InterruptEventSupervisor::_defaultInterruptCallback([[maybe_unused]] vmi_instance_t vmi,
                                                                          vmi_event_t* event)
     {
+        static auto& callbackLatency = GlobalControl::latencyHistograms().get("callback.interrupt");
+        ScopedLatency measurement(callbackLatency);
         auto eventResponse = VMI_EVENT_RESPONSE_NONE;
         event->interrupt_event.reinject = REINJECT_INTERRUPT;
 
@@ -180,17 +634,10 @@ namespace VmiCore
             return eventResponse;
         }
 
-        auto breakpointsAtEventGFN =
-            interruptEventSupervisor->breakpointsByGFN.find(eventPA >> PagingDefinitions::numberOfPageIndexBits);
-        if (breakpointsAtEventGFN != interruptEventSupervisor->breakpointsByGFN.end())
+        if (interruptEventSupervisor->breakpointTable.find(eventPA) != nullptr)
         {
-            auto breakpointsAtEventPA = breakpointsAtEventGFN->second.Breakpoints.find(eventPA);
-            if (breakpointsAtEventPA != breakpointsAtEventGFN->second.Breakpoints.end())
-            {
-                event->interrupt_event.reinject = DONT_REINJECT_INTERRUPT;
-                return interruptEventSupervisor->interruptCallback(
-                    eventPA, event->vcpu_id, breakpointsAtEventPA->second);
-            }
+            event->interrupt_event.reinject = DONT_REINJECT_INTERRUPT;
+            return interruptEventSupervisor->interruptCallback(event, eventPA);
         }
 
         if (event->interrupt_event.reinject == REINJECT_INTERRUPT)
@@ -202,18 +649,84 @@ namespace VmiCore
         return eventResponse;
     }
 
-    event_response_t InterruptEventSupervisor::interruptCallback(
-        addr_t interruptPA, uint32_t vcpuId, const std::vector<std::shared_ptr<Breakpoint>>& breakpoints)
+    event_response_t InterruptEventSupervisor::interruptCallback(vmi_event_t* event, addr_t interruptPA)
     {
-        bool deactivateInterrupt = false;
+        static auto& emulatedHitLatency = GlobalControl::latencyHistograms().get("breakpoint.emulate");
+        static auto& singleStepHitLatency = GlobalControl::latencyHistograms().get("breakpoint.singleStep");
+        auto changeCountAtHit = breakpointChangeCount;
+        auto* record = breakpointTable.find(interruptPA);
+        // Hits are classified by the response that is actually returned, which is only known at the very end
+        ScopedLatency hitMeasurement(singleStepHitLatency);
+
+        auto dtb = interruptEvent.getCr3();
+
+        auto deactivateInterrupt = invokeBreakpointCallbacks(interruptPA, std::nullopt, &record->globalBreakpoints);
+        if (breakpointChangeCount != changeCountAtHit)
+        {
+            record = breakpointTable.find(interruptPA);
+            changeCountAtHit = breakpointChangeCount;
+        }
+        // Process specific breakpoints of other address spaces that share this page are not even looked at
+        if (record != nullptr && invokeBreakpointCallbacks(interruptPA, dtb, record->findBreakpointsOfDtb(dtb)))
+        {
+            deactivateInterrupt = true;
+        }
+        if (breakpointChangeCount != changeCountAtHit)
+        {
+            record = breakpointTable.find(interruptPA);
+        }
+        // The original instruction has already been restored if the callbacks have removed the INT3
+        if (record == nullptr)
+        {
+            return VMI_EVENT_RESPONSE_NONE;
+        }
+
+        if (!deactivateInterrupt)
+        {
+            if (record->emulatedInstruction)
+            {
+                emulatedHits++;
+                hitMeasurement.retarget(emulatedHitLatency);
+                // Libvmi consumes the instruction as part of the response, i.e. before the table can change again
+                event->emul_insn = &*record->emulatedInstruction;
+                // The instruction data alone is merely attached to the response, emulation has to be requested
+                // explicitly. Otherwise, the vCPU would resume on the INT3 again.
+                return VMI_EVENT_RESPONSE_EMULATE | VMI_EVENT_RESPONSE_SET_EMUL_INSN;
+            }
+            singleStepHits++;
+        }
 
-        vmiInterface->flushV2PCache(LibvmiInterface::flushAllPTs);
-        vmiInterface->flushPageCache();
+        disableEvent(*record);
 
-        for (auto& breakpoint : breakpoints)
+        if (!deactivateInterrupt)
         {
+            singleStepSupervisor->setSingleStepCallback(event->vcpu_id, _defaultSingleStepCallback, interruptPA);
+        }
+
+        return VMI_EVENT_RESPONSE_NONE;
+    }
+
+    bool InterruptEventSupervisor::invokeBreakpointCallbacks(addr_t interruptPA,
+                                                             std::optional<addr_t> dtb,
+                                                             std::vector<std::shared_ptr<Breakpoint>>* breakpoints)
+    {
+        static auto& pluginCallbackLatency = GlobalControl::latencyHistograms().get("plugin.breakpoint");
+        bool deactivateInterrupt = false;
+        for (std::size_t index = 0; breakpoints != nullptr && index < breakpoints->size();)
+        {
+            auto breakpoint = (*breakpoints)[index];
+            auto changeCount = breakpointChangeCount;
             try
             {
+                // Filters neither call into plugin code nor alter breakpoints, hence the list stays valid
+                if (const auto& filter = breakpoint->getFilter(); filter && !passesFilter(*filter))
+                {
+                    filteredHits++;
+                    index++;
+                    continue;
+                }
+                deliveredHits++;
+                ScopedLatency measurement(pluginCallbackLatency);
                 auto eventResponse = breakpoint->callback(interruptEvent);
                 if (eventResponse == BpResponse::Deactivate)
                 {
@@ -226,55 +739,243 @@ namespace VmiCore
                                                {{"logger", loggerName}, {"exception", e.what()}});
                 GlobalControl::eventStream()->sendErrorEvent(e.what());
             }
+
+            if (breakpointChangeCount == changeCount)
+            {
+                index++;
+                continue;
+            }
+            // The callback has created or removed breakpoints, which may have moved records within the table. A
+            // breakpoint that has removed itself is replaced by its successor at the same index.
+            breakpoints = findBreakpoints(interruptPA, dtb);
+            if (breakpoints != nullptr && index < breakpoints->size() && (*breakpoints)[index] == breakpoint)
+            {
+                index++;
+            }
         }
+        return deactivateInterrupt;
+    }
 
-        disableEvent(interruptPA);
+    bool InterruptEventSupervisor::passesFilter(const BreakpointFilter& filter)
+    {
+        for (const auto& condition : filter.conditions)
+        {
+            auto operand = readFilterOperand(condition);
+            // The hit is delivered if the filter cannot decide, so that the callback does not miss relevant ones
+            if (!operand)
+            {
+                return true;
+            }
+            if (!compareFilterOperand(condition.comparison, *operand & condition.mask, condition.value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
-        if (!deactivateInterrupt)
+    std::optional<uint64_t> InterruptEventSupervisor::readFilterOperand(const FilterCondition& condition)
+    {
+        auto registerContent = readFilterRegister(condition.reg);
+        auto address = registerContent + static_cast<uint64_t>(condition.offset);
+        switch (condition.memoryReadSize)
         {
-            singleStepSupervisor->setSingleStepCallback(vcpuId, singleStepCallbackFunction, interruptPA);
+            case 0:
+            {
+                return registerContent;
+            }
+            case sizeof(uint8_t):
+            {
+                return vmiInterface->tryRead8VA(address, interruptEvent.getCr3());
+            }
+            case sizeof(uint32_t):
+            {
+                return vmiInterface->tryRead32VA(address, interruptEvent.getCr3());
+            }
+            case sizeof(uint64_t):
+            {
+                return vmiInterface->tryRead64VA(address, interruptEvent.getCr3());
+            }
+            default:
+            {
+                // Already rejected when the breakpoint has been created
+                return std::nullopt;
+            }
         }
+    }
 
-        return VMI_EVENT_RESPONSE_NONE;
+    uint64_t InterruptEventSupervisor::readFilterRegister(FilterRegister reg) const
+    {
+        switch (reg)
+        {
+            case FilterRegister::Rax:
+            {
+                return interruptEvent.getRax();
+            }
+            case FilterRegister::Rbx:
+            {
+                return interruptEvent.getRbx();
+            }
+            case FilterRegister::Rcx:
+            {
+                return interruptEvent.getRcx();
+            }
+            case FilterRegister::Rdx:
+            {
+                return interruptEvent.getRdx();
+            }
+            case FilterRegister::Rdi:
+            {
+                return interruptEvent.getRdi();
+            }
+            case FilterRegister::R8:
+            {
+                return interruptEvent.getR8();
+            }
+            case FilterRegister::R9:
+            {
+                return interruptEvent.getR9();
+            }
+            case FilterRegister::Rip:
+            {
+                return interruptEvent.getRip();
+            }
+            case FilterRegister::Rsp:
+            {
+                return interruptEvent.getRsp();
+            }
+            case FilterRegister::Cr3:
+            {
+                return interruptEvent.getCr3();
+            }
+            case FilterRegister::Gs:
+            {
+                return interruptEvent.getGs();
+            }
+            default:
+            {
+                throw VmiException(
+                    fmt::format("{}: Unknown filter register {}", __func__, static_cast<int>(reg)));
+            }
+        }
+    }
+
+    bool InterruptEventSupervisor::compareFilterOperand(FilterComparison comparison, uint64_t operand, uint64_t value)
+    {
+        switch (comparison)
+        {
+            case FilterComparison::Equal:
+            {
+                return operand == value;
+            }
+            case FilterComparison::NotEqual:
+            {
+                return operand != value;
+            }
+            case FilterComparison::Below:
+            {
+                return operand < value;
+            }
+            case FilterComparison::AboveOrEqual:
+            {
+                return operand >= value;
+            }
+            default:
+            {
+                throw VmiException(
+                    fmt::format("{}: Unknown filter comparison {}", __func__, static_cast<int>(comparison)));
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<Breakpoint>>* InterruptEventSupervisor::findBreakpoints(addr_t targetPA,
+                                                                                       std::optional<addr_t> dtb)
+    {
+        auto* record = breakpointTable.find(targetPA);
+        if (record == nullptr)
+        {
+            return nullptr;
+        }
+        return dtb ? record->findBreakpointsOfDtb(*dtb) : &record->globalBreakpoints;
+    }
+
+    void InterruptEventSupervisor::_defaultSingleStepCallback(vmi_event_t* singleStepEvent)
+    {
+        if (interruptEventSupervisor == nullptr)
+        {
+            GlobalControl::logger()->error("Caught single step event with destroyed InterruptEventSupervisor",
+                                           {CxxLogField("logger", loggerName)});
+            return;
+        }
+        interruptEventSupervisor->singleStepCallback(singleStepEvent);
     }
 
     void InterruptEventSupervisor::singleStepCallback(vmi_event_t* singleStepEvent)
     {
-        enableEvent(reinterpret_cast<addr_t>(singleStepEvent->data));
+        // The INT3 may have been removed while the original instruction has been executed
+        if (auto* record = breakpointTable.find(reinterpret_cast<addr_t>(singleStepEvent->data)); record != nullptr)
+        {
+            enableEvent(*record);
+        }
     }
 
     void InterruptEventSupervisor::contextSwitchCallback(vmi_event_t* registerEvent)
     {
         auto newDtb = registerEvent->reg_event.value;
-
-        for (const auto& [_bpPageGFN, bpPage] : interruptEventSupervisor->breakpointsByGFN)
+        auto peerDtb = kptiPeerDtbs.find(newDtb);
+        auto isKptiSwitch = peerDtb != kptiPeerDtbs.end() && peerDtb->second == lastContextSwitchDtb;
+        lastContextSwitchDtb = newDtb;
+        // Switching between the kernel and user address space of the same process does not change the set of
+        // required INT3s, since breakpoints of both address spaces are enabled together
+        if (isKptiSwitch)
         {
-            for (const auto& [breakpointsPA, breakpoints] : bpPage.Breakpoints)
-            {
-                BPStateResponse currentBreakpointState = paToBreakpointStatus.at(breakpointsPA);
+            return;
+        }
 
-                auto newBreakpointState = getNewBreakpointState(newDtb, breakpoints);
+        auto requiredPeerDtb = peerDtb != kptiPeerDtbs.end() ? std::optional<addr_t>(peerDtb->second) : std::nullopt;
+        auto isRequired = [newDtb, requiredPeerDtb](const BreakpointRecord& record)
+        {
+            return record.hasBreakpointsOfDtb(newDtb) ||
+                   (requiredPeerDtb && record.hasBreakpointsOfDtb(*requiredPeerDtb));
+        };
 
-                if (newBreakpointState != currentBreakpointState)
-                {
-                    paToBreakpointStatus.at(breakpointsPA) = newBreakpointState;
-                    interruptEventSupervisor->updateBreakpointState(newBreakpointState, breakpointsPA);
-                }
+        // Apart from global breakpoints, only INT3s required by the previous address space are written at this point
+        for (std::size_t index = 0; index < enabledProcessSpecificPAs.size();)
+        {
+            auto& record = *breakpointTable.find(enabledProcessSpecificPAs[index]);
+            if (isRequired(record))
+            {
+                index++;
+                continue;
             }
+            // Moves the last entry to the current index
+            disableEvent(record);
+        }
+
+        enableRequiredEvents(newDtb);
+        if (requiredPeerDtb)
+        {
+            enableRequiredEvents(*requiredPeerDtb);
         }
     }
 
-    std::shared_ptr<InterruptGuard>
-    InterruptEventSupervisor::createPageGuard(uint64_t targetVA, uint64_t processDtb, uint64_t targetGFN)
+    void InterruptEventSupervisor::enableRequiredEvents(addr_t dtb)
     {
-        auto interruptGuard =
-            std::make_shared<InterruptGuard>(vmiInterface, loggingLib, targetVA, targetGFN, processDtb);
-        interruptGuard->initialize();
-
-        return interruptGuard;
+        auto requiredPAs = targetPAsByDtb.find(dtb);
+        if (requiredPAs == targetPAsByDtb.end())
+        {
+            return;
+        }
+        for (auto targetPA : requiredPAs->second)
+        {
+            if (auto& record = *breakpointTable.find(targetPA); record.state == BPStateResponse::Disable)
+            {
+                enableEvent(record);
+            }
+        }
     }
 
-    void InterruptEventSupervisor::storeOriginalValue(addr_t targetPA)
+    uint8_t InterruptEventSupervisor::readOriginalValue(addr_t targetPA)
     {
         auto originalValue = vmiInterface->read8PA(targetPA);
         GlobalControl::logger()->debug(
@@ -286,80 +987,72 @@ namespace VmiCore
                 fmt::format("{}: Breakpoint originalValue @ {:#x} is already an INT3 breakpoint.", __func__, targetPA));
         }
 
-        originalValuesByTargetPA[targetPA] = originalValue;
+        return originalValue;
     }
 
-    void InterruptEventSupervisor::clearInterruptEventHandling()
+    void InterruptEventSupervisor::prepareEmulation(BreakpointRecord& record)
     {
-        vmiInterface->pauseVm();
+        auto pageOffset = record.targetPA & PagingDefinitions::pageOffsetMask;
+        // The guard only knows the original content of its own page, while the following page may already contain
+        // INT3s of other breakpoints
+        if (pageOffset + MAX_INSTRUCTION_LENGTH > PagingDefinitions::pageSizeInBytes)
+        {
+            return;
+        }
 
-        for (const auto& [_gfn, breakpointsAtGfn] : breakpointsByGFN)
+        emul_insn_t instruction{};
+        instruction.dont_free = 1;
+        auto instructionBytes = std::span(instruction.data).first(MAX_INSTRUCTION_LENGTH);
+        guardManager.copyOriginalBytes(
+            record.targetPA >> PagingDefinitions::numberOfPageIndexBits, pageOffset, instructionBytes);
+        instructionBytes[0] = record.originalValue;
+        if (!isEmulatable(instructionBytes))
         {
-            for (const auto& [breakpointPA, _breakpointsAtPa] : breakpointsAtGfn.Breakpoints)
-            {
-                removeInterrupt(breakpointPA);
-            }
-            breakpointsAtGfn.PageGuard->teardown();
+            logger->debug("Instruction cannot be emulated, falling back to single step",
+                          {{"targetPA", fmt::format("{:#x}", record.targetPA)},
+                           {"opcode", fmt::format("{:#x}", instructionBytes[0])}});
+            return;
         }
+        record.emulatedInstruction = instruction;
+    }
 
-        breakpointsByGFN.clear();
+    void InterruptEventSupervisor::clearInterruptEventHandling()
+    {
+        vmiInterface->pauseVm();
+
+        breakpointTable.forEach([this](const BreakpointRecord& record)
+                                { vmiInterface->write8PA(record.targetPA, record.originalValue); });
+        guardManager.teardown();
+
+        breakpointChangeCount++;
+        breakpointTable.clear();
+        bpPagesByGFN.clear();
+        targetPAsByDtb.clear();
+        enabledProcessSpecificPAs.clear();
+        kptiPeerDtbs.clear();
         vmiInterface->clearEvent(*event, false);
 
         vmiInterface->resumeVm();
     }
 
-    void
+    std::shared_ptr<Breakpoint>
     InterruptEventSupervisor::eraseBreakpointAtAddress(std::vector<std::shared_ptr<Breakpoint>>& breakpointsAtAddress,
                                                        const IBreakpoint* breakpoint)
     {
-        breakpointsAtAddress.erase(std::find_if(breakpointsAtAddress.cbegin(),
-                                                breakpointsAtAddress.cend(),
-                                                [breakpoint](auto sharedInterruptEventPtr)
-                                                { return sharedInterruptEventPtr.get() == breakpoint; }));
+        auto erasedBreakpoint = std::find_if(breakpointsAtAddress.begin(),
+                                             breakpointsAtAddress.end(),
+                                             [breakpoint](const auto& sharedInterruptEventPtr)
+                                             { return sharedInterruptEventPtr.get() == breakpoint; });
+        auto erasedBreakpointShared = std::move(*erasedBreakpoint);
+        breakpointsAtAddress.erase(erasedBreakpoint);
+        return erasedBreakpointShared;
     }
 
     void InterruptEventSupervisor::removeInterrupt(addr_t targetPA)
     {
-        auto originalValue = originalValuesByTargetPA.extract(targetPA);
-        vmiInterface->write8PA(targetPA, originalValue.mapped());
-        paToBreakpointStatus.erase(targetPA);
-    }
-
-    BPStateResponse
-    InterruptEventSupervisor::getNewBreakpointState(reg_t newDtb,
-                                                    const std::vector<std::shared_ptr<Breakpoint>>& breakpoints)
-    {
-        using enum BPStateResponse;
-        for (const auto& breakpoint : breakpoints)
-        {
-            auto newState = breakpoint->getNewBreakpointState(newDtb);
-            if (newState == Enable) // if at least one bp needs to be enabled, enable it
-            {
-                return Enable;
-            }
-        }
-        return Disable;
-    }
-
-    void InterruptEventSupervisor::updateBreakpointState(BPStateResponse state, uint64_t targetPA) const
-    {
-        using enum BPStateResponse;
-        switch (state)
-        {
-            case Enable:
-            {
-                interruptEventSupervisor->enableEvent(targetPA);
-                break;
-            }
-            case Disable:
-            {
-                interruptEventSupervisor->disableEvent(targetPA);
-                break;
-            }
-            default:
-            {
-                throw VmiException(fmt::format("Invalid breakpoint state"));
-            }
-        }
+        auto& record = *breakpointTable.find(targetPA);
+        vmiInterface->write8PA(targetPA, record.originalValue);
+        untrackEnabledPA(record);
+        breakpointTable.erase(targetPA);
     }
 }
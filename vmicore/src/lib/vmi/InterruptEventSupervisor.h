@@ -5,16 +5,21 @@
 #include "../io/ILogging.h"
 #include "../os/IActiveProcessesSupervisor.h"
 #include "Breakpoint.h"
+#include "BreakpointMode.h"
+#include "BreakpointTable.h"
 #include "Event.h"
-#include "InterruptGuard.h"
+#include "InterruptGuardManager.h"
 #include "LibvmiInterface.h"
 #include "RegisterEventSupervisor.h"
 #include "SingleStepSupervisor.h"
-#include <map>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <unordered_map>
+#include <vector>
 #include <vmicore/io/ILogger.h>
+#include <vmicore/vmi/BreakpointFilter.h>
+#include <vmicore/vmi/BreakpointSpec.h>
 #include <vmicore/vmi/events/IInterruptEvent.h>
 
 namespace VmiCore
@@ -34,6 +39,27 @@ namespace VmiCore
                          const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
                          bool global) = 0;
 
+        /**
+         * Creates a breakpoint whose hits are only delivered to the callback if the given filter holds. The filter is
+         * evaluated within the interrupt handling, so that filtered hits never reach plugin code.
+         */
+        [[nodiscard]] virtual std::shared_ptr<IBreakpoint>
+        createBreakpoint(uint64_t targetVA,
+                         const ActiveProcessInformation& processInformation,
+                         const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
+                         bool global,
+                         const std::optional<BreakpointFilter>& filter) = 0;
+
+        /**
+         * Creates all given breakpoints with a single flush of the involved address spaces and a single pause of the
+         * VM. The breakpoint or the error of each entry is set accordingly.
+         *
+         * @return True if all breakpoints have been created, false otherwise.
+         */
+        virtual bool createBreakpoints(const ActiveProcessInformation& processInformation,
+                                       std::span<BreakpointSpec> breakpointSpecs,
+                                       bool global) = 0;
+
         virtual void deleteBreakpoint(IBreakpoint* breakpoint) = 0;
 
       protected:
@@ -48,7 +74,8 @@ namespace VmiCore
                                           std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor,
                                           std::shared_ptr<IActiveProcessesSupervisor> activeProcessesSupervisor,
                                           std::shared_ptr<IRegisterEventSupervisor> registerEventSupervisor,
-                                          std::shared_ptr<ILogging> loggingLib);
+                                          std::shared_ptr<ILogging> loggingLib,
+                                          BreakpointMode breakpointMode);
 
         ~InterruptEventSupervisor() noexcept override;
 
@@ -62,13 +89,24 @@ namespace VmiCore
                          const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
                          bool global) override;
 
+        [[nodiscard]] std::shared_ptr<IBreakpoint>
+        createBreakpoint(uint64_t targetVA,
+                         const ActiveProcessInformation& processInformation,
+                         const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
+                         bool global,
+                         const std::optional<BreakpointFilter>& filter) override;
+
+        bool createBreakpoints(const ActiveProcessInformation& processInformation,
+                               std::span<BreakpointSpec> breakpointSpecs,
+                               bool global) override;
+
         void deleteBreakpoint(IBreakpoint* breakpoint) override;
 
         static event_response_t _defaultInterruptCallback(vmi_instance_t vmi, vmi_event_t* event);
 
-        [[nodiscard]] event_response_t interruptCallback(addr_t interruptPA,
-                                                         uint32_t vcpuId,
-                                                         const std::vector<std::shared_ptr<Breakpoint>>& breakpoints);
+        [[nodiscard]] event_response_t interruptCallback(vmi_event_t* event, addr_t interruptPA);
+
+        static void _defaultSingleStepCallback(vmi_event_t* singleStepEvent);
 
         void singleStepCallback(__attribute__((unused)) vmi_event_t* singleStepEvent);
 
@@ -77,13 +115,13 @@ namespace VmiCore
       private:
         struct BpPage
         {
-            std::map<addr_t, std::vector<std::shared_ptr<Breakpoint>>> Breakpoints;
-            std::shared_ptr<InterruptGuard> PageGuard;
+            std::size_t Int3Count = 0;
         };
 
         static constexpr uint8_t DONT_REINJECT_INTERRUPT = 0;
         static constexpr uint8_t REINJECT_INTERRUPT = 1;
         static constexpr uint8_t INT3_BREAKPOINT = 0xCC;
+        static constexpr std::size_t MAX_INSTRUCTION_LENGTH = 15;
 
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor;
@@ -91,11 +129,31 @@ namespace VmiCore
         std::shared_ptr<IRegisterEventSupervisor> registerEventSupervisor;
         std::shared_ptr<ILogging> loggingLib;
         std::unique_ptr<ILogger> logger;
-
-        std::unordered_map<addr_t, uint8_t> originalValuesByTargetPA;
-        std::unordered_map<addr_t, BpPage> breakpointsByGFN{};
-        std::unordered_map<addr_t, BPStateResponse> paToBreakpointStatus{};
-        std::function<void(vmi_event_t*)> singleStepCallbackFunction;
+        BreakpointMode breakpointMode;
+
+        uint64_t emulatedHits = 0;
+        uint64_t singleStepHits = 0;
+        // Hits of single breakpoints, i.e. an INT3 that is shared by several breakpoints may count more than once
+        uint64_t filteredHits = 0;
+        uint64_t deliveredHits = 0;
+        // Requires a single lookup per interrupt event. The indices below merely refer to PAs within this table.
+        BreakpointTable breakpointTable{};
+        // Incremented whenever breakpoints are added or removed, so that interrupt handling only needs to look up the
+        // breakpoints at the interrupted PA again if one of the callbacks has done so
+        uint64_t breakpointChangeCount = 0;
+        // Pages with at least one INT3, each of which is guarded once
+        std::unordered_map<addr_t, BpPage> bpPagesByGFN{};
+        InterruptGuardManager guardManager;
+        // PAs of the INT3s of each address space with process specific breakpoints, so that a context switch only
+        // needs to look at the breakpoints of the involved address spaces
+        std::unordered_map<addr_t, std::vector<addr_t>> targetPAsByDtb{};
+        // INT3s that are currently written for process specific breakpoints only. Records know their position within
+        // this list, so that they can be removed in constant time.
+        std::vector<addr_t> enabledProcessSpecificPAs{};
+        // Kernel and user DTBs of processes with process specific breakpoints are mapped onto each other, so that
+        // switching between them due to KPTI is not treated as a context switch
+        std::unordered_map<addr_t, addr_t> kptiPeerDtbs{};
+        std::optional<addr_t> lastContextSwitchDtb{};
         std::function<void(vmi_event_t*)> contextSwitchCallbackFunction;
         // Event needs to be allocated separately in order to avoid invalidating references (e.g. in libvmi) when the
         // enclosing object is moved or copied. Therefore, it is wrapped in a unique pointer.
@@ -104,24 +162,87 @@ namespace VmiCore
         std::mutex lock{};
         std::unique_ptr<vmi_event_t> contextSwitchEvent = std::make_unique<vmi_event_t>();
 
-        std::shared_ptr<InterruptGuard> createPageGuard(uint64_t targetVA, uint64_t processDtb, uint64_t targetGFN);
+        [[nodiscard]] static addr_t getTranslationDtb(uint64_t targetVA,
+                                                      const ActiveProcessInformation& processInformation);
+
+        [[nodiscard]] std::shared_ptr<Breakpoint>
+        makeBreakpoint(addr_t targetPA,
+                       const std::function<BpResponse(IInterruptEvent&)>& callbackFunction,
+                       addr_t processDtb,
+                       bool global,
+                       const std::optional<BreakpointFilter>& filter);
+
+        static void validateFilter(const BreakpointFilter& filter);
+
+        // Expects lock to be held by the caller. New pages are only guarded once the guards have been committed.
+        BpPage& getOrCreateBpPage(uint64_t targetGFN, uint64_t targetVA, uint64_t processDtb);
 
-        void storeOriginalValue(addr_t targetPA);
+        // Expects lock to be held by the caller
+        void registerBreakpoint(BpPage& bpPage,
+                                const std::shared_ptr<Breakpoint>& breakpoint,
+                                const ActiveProcessInformation& processInformation);
+
+        // Expects lock to be held by the caller
+        void removePageIfUnused(uint64_t targetGFN);
+
+        [[nodiscard]] uint8_t readOriginalValue(addr_t targetPA);
+
+        void prepareEmulation(BreakpointRecord& record);
 
         void clearInterruptEventHandling();
 
-        static void eraseBreakpointAtAddress(std::vector<std::shared_ptr<Breakpoint>>& breakpointsAtAddress,
-                                             const IBreakpoint* breakpoint);
+        /**
+         * Invokes either the global breakpoints at the given PA or the process specific ones of the given address
+         * space, starting with the given list of them. The list is only looked up again if a callback has added or
+         * removed breakpoints.
+         *
+         * @return True if any of the callbacks has requested to deactivate the INT3.
+         */
+        bool invokeBreakpointCallbacks(addr_t interruptPA,
+                                       std::optional<addr_t> dtb,
+                                       std::vector<std::shared_ptr<Breakpoint>>* breakpoints);
 
-        void enableEvent(addr_t targetPA);
+        /**
+         * Evaluates the filter against the registers and the address space of the current interrupt event.
+         *
+         * @return False if any of the conditions does not hold.
+         */
+        [[nodiscard]] bool passesFilter(const BreakpointFilter& filter);
 
-        void disableEvent(addr_t targetPA);
+        /**
+         * @return The register content or the guest memory referred to by the condition, std::nullopt if the latter
+         * is not accessible.
+         */
+        [[nodiscard]] std::optional<uint64_t> readFilterOperand(const FilterCondition& condition);
 
-        void removeInterrupt(addr_t targetPA);
+        [[nodiscard]] uint64_t readFilterRegister(FilterRegister reg) const;
+
+        [[nodiscard]] static bool compareFilterOperand(FilterComparison comparison, uint64_t operand, uint64_t value);
+
+        [[nodiscard]] std::vector<std::shared_ptr<Breakpoint>>* findBreakpoints(addr_t targetPA,
+                                                                                std::optional<addr_t> dtb);
+
+        static std::shared_ptr<Breakpoint>
+        eraseBreakpointAtAddress(std::vector<std::shared_ptr<Breakpoint>>& breakpointsAtAddress,
+                                 const IBreakpoint* breakpoint);
+
+        void addBreakpointReference(BreakpointRecord& record,
+                                    const std::shared_ptr<Breakpoint>& breakpoint,
+                                    const ActiveProcessInformation& processInformation);
 
-        static BPStateResponse getNewBreakpointState(reg_t newDtb,
-                                                     const std::vector<std::shared_ptr<Breakpoint>>& breakpoints);
-        void updateBreakpointState(BPStateResponse state, uint64_t targetPA) const;
+        std::shared_ptr<Breakpoint> removeBreakpointReference(BreakpointRecord& record, const Breakpoint& breakpoint);
+
+        void enableRequiredEvents(addr_t dtb);
+
+        void enableEvent(BreakpointRecord& record);
+
+        void disableEvent(BreakpointRecord& record);
+
+        void trackEnabledPA(BreakpointRecord& record);
+
+        void untrackEnabledPA(BreakpointRecord& record);
+
+        void removeInterrupt(addr_t targetPA);
     };
 }
 
@@ -0,0 +1,258 @@
+#include "InterruptGuardManager.h"
+#include "../GlobalControl.h"
+#include <algorithm>
+#include <fmt/core.h>
+#include <utility>
+#include <vmicore/filename.h>
+#include <vmicore/vmi/BatchReadEntry.h>
+#include <vmicore/vmi/VmiException.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr auto loggerName = FILENAME_STEM;
+    }
+
+    InterruptGuardManager::InterruptGuardManager(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                                                 const std::shared_ptr<ILogging>& logging)
+        : vmiInterface(std::move(vmiInterface)), logger(logging->newNamedLogger(loggerName))
+    {
+    }
+
+    void InterruptGuardManager::initialize()
+    {
+        // setting simple read events is unsupported by EPT
+        SETUP_MEM_EVENT(&guardEvent, ~0ULL, VMI_MEMACCESS_RW, &InterruptGuardManager::_guardCallback, true);
+        guardEvent.data = this;
+
+        // This will never change so we initialize this here once
+        emulateReadData.dont_free = true;
+        emulateReadData.size = emulatedReadSize;
+
+        vmiInterface->registerEvent(guardEvent);
+    }
+
+    void InterruptGuardManager::teardown()
+    {
+        if (guardEvent.type == VMI_EVENT_INVALID)
+        {
+            logger->debug("Guard not initialized. Skipping teardown.");
+            return;
+        }
+
+        logHitStatistics();
+        // Removals that have not been committed yet are included, as their pages are still restricted
+        std::vector<addr_t> restrictedGfns = std::move(pendingUnguards);
+        for (const auto& [gfn, _page] : pagesByGfn)
+        {
+            if (std::ranges::find(pendingGuards, gfn) == pendingGuards.end())
+            {
+                restrictedGfns.push_back(gfn);
+            }
+        }
+        if (!restrictedGfns.empty())
+        {
+            vmiInterface->setMemAccess(restrictedGfns, VMI_MEMACCESS_N);
+        }
+        vmiInterface->clearEvent(guardEvent, false);
+
+        guardEvent = {};
+        pagesByGfn.clear();
+        shadowChunks.clear();
+        freeShadowSlots.clear();
+        pendingGuards.clear();
+        pendingUnguards.clear();
+    }
+
+    void InterruptGuardManager::addGuard(addr_t gfn, addr_t pageVA, addr_t dtb)
+    {
+        if (pagesByGfn.contains(gfn))
+        {
+            throw VmiException(fmt::format("{}: Page with gfn {:#x} is already guarded", __func__, gfn));
+        }
+
+        auto shadowSlot = allocateShadowSlot();
+        auto shadowPage = getShadowPage(shadowSlot);
+        auto pageBaseVA = pageVA & PagingDefinitions::stripPageOffsetMask;
+        // we need a small buffer of data from the subsequent page because memory reads may be overlapping
+        std::array<BatchReadEntry, 2> reads{
+            BatchReadEntry{.virtualAddress = pageBaseVA,
+                           .dtb = dtb,
+                           .size = PagingDefinitions::pageSizeInBytes,
+                           .destination = shadowPage.data()},
+            BatchReadEntry{.virtualAddress = pageBaseVA + PagingDefinitions::pageSizeInBytes,
+                           .dtb = dtb,
+                           .size = emulatedReadSize,
+                           .destination = shadowPage.last<emulatedReadSize>().data()}};
+        if (!vmiInterface->readBatch(reads))
+        {
+            if (!reads[0].success)
+            {
+                freeShadowSlots.push_back(shadowSlot);
+                throw VmiException(fmt::format(
+                    "{}: Unable to create Interrupt @ {:#x} in system with cr3 {:#x}", __func__, pageBaseVA, dtb));
+            }
+            std::ranges::fill(shadowPage.last<emulatedReadSize>(), 0);
+            logger->warning(fmt::format(
+                "{}: Unable to read over page bounds from page: {} with dtb: {}", __func__, pageBaseVA, dtb));
+        }
+
+        pagesByGfn.emplace(gfn, GuardedPage{.shadowSlot = shadowSlot});
+        pendingGuards.push_back(gfn);
+        logger->debug("Interrupt guard: Register RW event on gfn", {{"targetGFN", fmt::format("{:#x}", gfn)}});
+    }
+
+    void InterruptGuardManager::removeGuard(addr_t gfn)
+    {
+        auto page = pagesByGfn.find(gfn);
+        if (page == pagesByGfn.end())
+        {
+            return;
+        }
+
+        if (page->second.hits > 0)
+        {
+            logger->debug("Remove frequently read guard",
+                          {{"targetGFN", fmt::format("{:#x}", gfn)}, {"hits", page->second.hits}});
+        }
+        freeShadowSlots.push_back(page->second.shadowSlot);
+        pagesByGfn.erase(page);
+        // A page that has not been committed yet has never been restricted
+        if (std::erase(pendingGuards, gfn) == 0)
+        {
+            pendingUnguards.push_back(gfn);
+        }
+    }
+
+    void InterruptGuardManager::commitGuards()
+    {
+        auto unguards = std::move(pendingUnguards);
+        auto guards = std::move(pendingGuards);
+        pendingUnguards.clear();
+        pendingGuards.clear();
+        // Pages that have been removed and added again since the last commit stay restricted
+        std::erase_if(unguards, [this](addr_t gfn) { return pagesByGfn.contains(gfn); });
+
+        if (!unguards.empty())
+        {
+            vmiInterface->setMemAccess(unguards, VMI_MEMACCESS_N);
+        }
+        if (!guards.empty())
+        {
+            vmiInterface->setMemAccess(guards, VMI_MEMACCESS_RW);
+        }
+    }
+
+    bool InterruptGuardManager::isGuarded(addr_t gfn) const
+    {
+        return pagesByGfn.contains(gfn);
+    }
+
+    void InterruptGuardManager::copyOriginalBytes(addr_t gfn, uint64_t pageOffset, std::span<uint8_t> bytes) const
+    {
+        auto page = pagesByGfn.find(gfn);
+        if (page == pagesByGfn.end())
+        {
+            throw VmiException(fmt::format("{}: Page with gfn {:#x} is not guarded", __func__, gfn));
+        }
+        if (pageOffset + bytes.size() > shadowPageSize)
+        {
+            throw VmiException(fmt::format("{}: Range @ page offset {:#x} exceeds shadow page", __func__, pageOffset));
+        }
+        std::ranges::copy(getShadowPage(page->second.shadowSlot).subspan(pageOffset, bytes.size()), bytes.begin());
+    }
+
+    uint64_t InterruptGuardManager::getHitCount(addr_t gfn) const
+    {
+        auto page = pagesByGfn.find(gfn);
+        return page != pagesByGfn.end() ? page->second.hits : 0;
+    }
+
+    std::span<uint8_t, InterruptGuardManager::shadowPageSize>
+    InterruptGuardManager::getShadowPage(std::size_t shadowSlot) const
+    {
+        auto& chunk = *shadowChunks[shadowSlot / shadowPagesPerChunk];
+        return std::span(chunk).subspan((shadowSlot % shadowPagesPerChunk) * shadowPageSize).first<shadowPageSize>();
+    }
+
+    std::size_t InterruptGuardManager::allocateShadowSlot()
+    {
+        if (freeShadowSlots.empty())
+        {
+            auto firstSlot = shadowChunks.size() * shadowPagesPerChunk;
+            shadowChunks.push_back(std::make_unique<ShadowChunk>());
+            // Slots are handed out in ascending order, so that the arena is filled front to back
+            for (auto slot = firstSlot + shadowPagesPerChunk; slot > firstSlot; slot--)
+            {
+                freeShadowSlots.push_back(slot - 1);
+            }
+        }
+        auto shadowSlot = freeShadowSlots.back();
+        freeShadowSlots.pop_back();
+        return shadowSlot;
+    }
+
+    void InterruptGuardManager::logHitStatistics() const
+    {
+        logger->info("Interrupt guard statistics",
+                     {{"guardedPages", static_cast<uint64_t>(pagesByGfn.size())}, {"hits", totalHits}});
+
+        std::vector<std::pair<addr_t, uint64_t>> hitsByGfn;
+        for (const auto& [gfn, page] : pagesByGfn)
+        {
+            if (page.hits > 0)
+            {
+                hitsByGfn.emplace_back(gfn, page.hits);
+            }
+        }
+        auto reportedPages = std::min(hitsByGfn.size(), reportedPageCount);
+        std::ranges::partial_sort(hitsByGfn,
+                                  hitsByGfn.begin() + static_cast<std::ptrdiff_t>(reportedPages),
+                                  [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+        for (const auto& [gfn, hits] : std::span(hitsByGfn).first(reportedPages))
+        {
+            logger->info("Frequently read guarded page", {{"targetGFN", fmt::format("{:#x}", gfn)}, {"hits", hits}});
+        }
+    }
+
+    event_response_t InterruptGuardManager::_guardCallback(__attribute__((unused)) vmi_instance_t vmiInstance,
+                                                           vmi_event_t* event)
+    {
+        static auto& callbackLatency = GlobalControl::latencyHistograms().get("callback.guard");
+        ScopedLatency measurement(callbackLatency);
+        event_response_t eventResponse = VMI_EVENT_RESPONSE_NONE;
+        try
+        {
+            eventResponse = reinterpret_cast<InterruptGuardManager*>(event->data)->guardCallback(event);
+        }
+        catch (const std::exception& e)
+        {
+            GlobalControl::requestShutdown();
+            GlobalControl::logger()->error("Unexpected exception", {{"logger", loggerName}, {"exception", e.what()}});
+            GlobalControl::eventStream()->sendErrorEvent(e.what());
+        }
+        return eventResponse;
+    }
+
+    event_response_t InterruptGuardManager::guardCallback(vmi_event_t* event)
+    {
+        auto page = pagesByGfn.find(event->mem_event.gfn);
+        // The guard has been removed together with all INT3s on the page, hence the access may simply be retried
+        if (page == pagesByGfn.end())
+        {
+            return VMI_EVENT_RESPONSE_NONE;
+        }
+
+        if (totalHits++ == 0)
+        {
+            logger->warning("Interrupt guard hit, check if patch guard is active");
+        }
+        page->second.hits++;
+        event->emul_read = &emulateReadData;
+        // we are allowed to provide more data than actually needed
+        std::ranges::copy(getShadowPage(page->second.shadowSlot).subspan(event->mem_event.offset, emulatedReadSize),
+                          std::begin(emulateReadData.data));
+        return VMI_EVENT_RESPONSE_SET_EMUL_READ_DATA;
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef VMICORE_INTERRUPTGUARDMANAGER_H
+#define VMICORE_INTERRUPTGUARDMANAGER_H
+
+#include "../io/ILogging.h"
+#include "LibvmiInterface.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <libvmi/events.h>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <vmicore/io/ILogger.h>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore/types.h>
+
+namespace VmiCore
+{
+    /**
+     * Hides INT3s from the guest by restricting access to the pages they reside on and serving guest reads of those
+     * pages from shadow copies taken before any INT3 has been written. All guarded pages share a single generic memory
+     * event, whose violations are dispatched by GFN.
+     */
+    class InterruptGuardManager
+    {
+      public:
+        InterruptGuardManager(std::shared_ptr<ILibvmiInterface> vmiInterface, const std::shared_ptr<ILogging>& logging);
+
+        // This object has to be non-copyable and non-movable because we store a self reference in a vmi event that we
+        // pass to libvmi. Therefore, we need to avoid invalidating this reference.
+        InterruptGuardManager(const InterruptGuardManager&) = delete;
+
+        InterruptGuardManager(const InterruptGuardManager&&) = delete;
+
+        InterruptGuardManager& operator=(const InterruptGuardManager&) = delete;
+
+        InterruptGuardManager& operator=(const InterruptGuardManager&&) = delete;
+
+        void initialize();
+
+        /**
+         * Lifts all guards and unregisters the guard event.
+         */
+        void teardown();
+
+        /**
+         * Captures the current content of the page, which has to be free of INT3s. The page is only guarded once the
+         * guards have been committed.
+         *
+         * @param pageVA Any virtual address within the page, used for reading it and the beginning of the next one.
+         */
+        void addGuard(addr_t gfn, addr_t pageVA, addr_t dtb);
+
+        /**
+         * The page is unguarded once the guards have been committed. Reads that are still pending until then are not
+         * emulated anymore, which requires the INT3s to have been removed beforehand.
+         */
+        void removeGuard(addr_t gfn);
+
+        /**
+         * Applies all additions and removals since the last commit in a single batch each.
+         */
+        void commitGuards();
+
+        [[nodiscard]] bool isGuarded(addr_t gfn) const;
+
+        /**
+         * Copies the content of the guarded page from before any INT3 has been written to it, starting at the given
+         * page offset. Bytes past the end of the page are only valid if the next page has been readable when the
+         * guard has been added.
+         */
+        void copyOriginalBytes(addr_t gfn, uint64_t pageOffset, std::span<uint8_t> bytes) const;
+
+        /**
+         * @return Number of guest accesses to the given page since it has been guarded.
+         */
+        [[nodiscard]] uint64_t getHitCount(addr_t gfn) const;
+
+      private:
+        // Empirically, no more than 16 bytes are read at a time, also at the end of a page
+        static constexpr std::size_t emulatedReadSize = 16;
+        static constexpr std::size_t shadowPageSize = PagingDefinitions::pageSizeInBytes + emulatedReadSize;
+        // Shadow pages are never moved once captured, hence the arena grows by whole chunks
+        static constexpr std::size_t shadowPagesPerChunk = 64;
+        static constexpr std::size_t reportedPageCount = 10;
+
+        using ShadowChunk = std::array<uint8_t, shadowPageSize * shadowPagesPerChunk>;
+
+        struct GuardedPage
+        {
+            std::size_t shadowSlot;
+            uint64_t hits = 0;
+        };
+
+        std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::unique_ptr<ILogger> logger;
+        vmi_event_t guardEvent{}; // This is okay because the enclosing object is non-copyable and non-movable
+        emul_read_t emulateReadData{};
+        std::unordered_map<addr_t, GuardedPage> pagesByGfn{};
+        std::vector<std::unique_ptr<ShadowChunk>> shadowChunks{};
+        std::vector<std::size_t> freeShadowSlots{};
+        std::vector<addr_t> pendingGuards{};
+        std::vector<addr_t> pendingUnguards{};
+        uint64_t totalHits = 0;
+
+        [[nodiscard]] std::span<uint8_t, shadowPageSize> getShadowPage(std::size_t shadowSlot) const;
+
+        std::size_t allocateShadowSlot();
+
+        void logHitStatistics() const;
+
+        static event_response_t _guardCallback(vmi_instance_t vmiInstance, vmi_event_t* event);
+
+        event_response_t guardCallback(vmi_event_t* event);
+    };
+}
+
+#endif // VMICORE_INTERRUPTGUARDMANAGER_H
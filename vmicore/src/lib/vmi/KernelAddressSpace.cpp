@@ -0,0 +1,54 @@
+#include "KernelAddressSpace.h"
+
+namespace VmiCore
+{
+    KernelAddressSpace::KernelAddressSpace(std::shared_ptr<ILibvmiInterface> vmiInterface, addr_t kernelDtb)
+        : vmiInterface(std::move(vmiInterface)), kernelDtb(kernelDtb)
+    {
+    }
+
+    addr_t KernelAddressSpace::getDtb() const
+    {
+        return kernelDtb;
+    }
+
+    uint8_t KernelAddressSpace::read8(addr_t virtualAddress) const
+    {
+        return vmiInterface->read8VA(virtualAddress, kernelDtb);
+    }
+
+    uint32_t KernelAddressSpace::read32(addr_t virtualAddress) const
+    {
+        return vmiInterface->read32VA(virtualAddress, kernelDtb);
+    }
+
+    uint64_t KernelAddressSpace::read64(addr_t virtualAddress) const
+    {
+        return vmiInterface->read64VA(virtualAddress, kernelDtb);
+    }
+
+    std::optional<uint64_t> KernelAddressSpace::tryRead64(addr_t virtualAddress) const
+    {
+        return vmiInterface->tryRead64VA(virtualAddress, kernelDtb);
+    }
+
+    addr_t KernelAddressSpace::convertToPA(addr_t virtualAddress) const
+    {
+        return vmiInterface->convertVAToPA(virtualAddress, kernelDtb);
+    }
+
+    std::unique_ptr<std::string> KernelAddressSpace::extractString(addr_t virtualAddress) const
+    {
+        return vmiInterface->extractStringAtVA(virtualAddress, kernelDtb);
+    }
+
+    std::optional<std::string> KernelAddressSpace::tryExtractString(addr_t virtualAddress) const
+    {
+        return vmiInterface->tryExtractStringAtVA(virtualAddress, kernelDtb);
+    }
+
+    std::unique_ptr<std::string> KernelAddressSpace::extractUnicodeString(addr_t virtualAddress) const
+    {
+        return vmiInterface->extractUnicodeStringAtVA(virtualAddress, kernelDtb);
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef VMICORE_KERNELADDRESSSPACE_H
+#define VMICORE_KERNELADDRESSSPACE_H
+
+#include "LibvmiInterface.h"
+#include "StructView.h"
+#include <array>
+#include <cstdint>
+#include <fmt/core.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vmicore/types.h>
+#include <vmicore/vmi/BatchReadEntry.h>
+#include <vmicore/vmi/VmiException.h>
+
+namespace VmiCore
+{
+    /**
+     * Reader for the kernel address space. The kernel directory table base is resolved once on construction, which
+     * has to happen after the introspection library has been initialized. Kernel structure walkers should use this
+     * reader instead of resolving the kernel DTB for every single read.
+     *
+     * The reader does not keep translations of its own. Reads are still translated by libvmi with its page table
+     * cache for the kernel DTB, and only convertToPA is served from the TranslationCache of the libvmi interface.
+     */
+    class KernelAddressSpace
+    {
+      public:
+        KernelAddressSpace(std::shared_ptr<ILibvmiInterface> vmiInterface, addr_t kernelDtb);
+
+        [[nodiscard]] addr_t getDtb() const;
+
+        [[nodiscard]] uint8_t read8(addr_t virtualAddress) const;
+
+        [[nodiscard]] uint32_t read32(addr_t virtualAddress) const;
+
+        [[nodiscard]] uint64_t read64(addr_t virtualAddress) const;
+
+        [[nodiscard]] std::optional<uint64_t> tryRead64(addr_t virtualAddress) const;
+
+        [[nodiscard]] addr_t convertToPA(addr_t virtualAddress) const;
+
+        [[nodiscard]] std::unique_ptr<std::string> extractString(addr_t virtualAddress) const;
+
+        [[nodiscard]] std::optional<std::string> tryExtractString(addr_t virtualAddress) const;
+
+        [[nodiscard]] std::unique_ptr<std::string> extractUnicodeString(addr_t virtualAddress) const;
+
+        /**
+         * Reads a whole structure with a single guest memory access.
+         *
+         * @param structSize Size of the structure as reported by the kernel profile.
+         * @return The structure or std::nullopt if it could not be read.
+         * @throws VmiException If the structure exceeds the given capacity.
+         */
+        template <std::size_t Capacity>
+        [[nodiscard]] std::optional<StructView<Capacity>> tryReadStruct(addr_t virtualAddress,
+                                                                        std::size_t structSize) const
+        {
+            StructView<Capacity> view(structSize);
+            std::array entries{BatchReadEntry{virtualAddress, kernelDtb, structSize, view.data().data()}};
+            if (!vmiInterface->readBatch(entries))
+            {
+                return std::nullopt;
+            }
+            return view;
+        }
+
+        /**
+         * Throwing variant of tryReadStruct.
+         *
+         * @throws VmiException If the structure could not be read or exceeds the given capacity.
+         */
+        template <std::size_t Capacity>
+        [[nodiscard]] StructView<Capacity> readStruct(addr_t virtualAddress, std::size_t structSize) const
+        {
+            auto view = tryReadStruct<Capacity>(virtualAddress, structSize);
+            if (!view)
+            {
+                throw VmiException(
+                    fmt::format("{}: Unable to read {} bytes from VA {:#x}", __func__, structSize, virtualAddress));
+            }
+            return *view;
+        }
+
+      private:
+        std::shared_ptr<ILibvmiInterface> vmiInterface;
+        addr_t kernelDtb;
+    };
+}
+
+#endif // VMICORE_KERNELADDRESSSPACE_H
@@ -0,0 +1,196 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fmt/core.h>
+#include <fstream>
+#include <mutex>
+#include <vmicore/vmi/VmiException.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr std::array<double, 5> summaryPercentiles{50.0, 90.0, 99.0, 99.9, 99.99};
+    }
+
+    std::size_t LatencyHistogram::getBucketIndex(uint64_t valueNs)
+    {
+        if (valueNs < subBucketCount)
+        {
+            return valueNs;
+        }
+        // The top bits below the most significant one select the sub bucket within the power of two
+        auto shift = static_cast<std::size_t>(std::bit_width(valueNs)) - 1 - subBucketBits;
+        return (shift + 1) * subBucketCount + static_cast<std::size_t>((valueNs >> shift) - subBucketCount);
+    }
+
+    uint64_t LatencyHistogram::getBucketLowerBound(std::size_t index)
+    {
+        if (index < subBucketCount)
+        {
+            return index;
+        }
+        auto shift = index / subBucketCount - 1;
+        return (subBucketCount + index % subBucketCount) << shift;
+    }
+
+    uint64_t LatencyHistogram::getBucketUpperBound(std::size_t index)
+    {
+        if (index + 1 == bucketCount)
+        {
+            return UINT64_MAX;
+        }
+        return getBucketLowerBound(index + 1) - 1;
+    }
+
+    void LatencyHistogram::record(uint64_t valueNs)
+    {
+        counts[getBucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        totalNs.fetch_add(valueNs, std::memory_order_relaxed);
+        auto currentMax = maxNs.load(std::memory_order_relaxed);
+        while (valueNs > currentMax && !maxNs.compare_exchange_weak(currentMax, valueNs, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    uint64_t LatencyHistogram::getCount() const
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t LatencyHistogram::getMax() const
+    {
+        return maxNs.load(std::memory_order_relaxed);
+    }
+
+    double LatencyHistogram::getMean() const
+    {
+        auto currentCount = getCount();
+        return currentCount == 0
+                   ? 0.0
+                   : static_cast<double>(totalNs.load(std::memory_order_relaxed)) / static_cast<double>(currentCount);
+    }
+
+    uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const
+    {
+        // Buckets are summed up instead of relying on count, which may be ahead of them while values are recorded
+        uint64_t total = 0;
+        for (const auto& bucket : counts)
+        {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        if (total == 0)
+        {
+            return 0;
+        }
+
+        auto rank =
+            std::max(uint64_t{1}, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total))));
+        uint64_t cumulative = 0;
+        for (std::size_t index = 0; index < bucketCount; index++)
+        {
+            cumulative += counts[index].load(std::memory_order_relaxed);
+            if (cumulative >= rank)
+            {
+                return std::min(getBucketUpperBound(index), getMax());
+            }
+        }
+        return getMax();
+    }
+
+    void LatencyHistogram::forEachBucket(
+        const std::function<void(uint64_t lowerBoundNs, uint64_t upperBoundNs, uint64_t count)>& visitor) const
+    {
+        for (std::size_t index = 0; index < bucketCount; index++)
+        {
+            if (auto bucketValues = counts[index].load(std::memory_order_relaxed); bucketValues > 0)
+            {
+                visitor(getBucketLowerBound(index), getBucketUpperBound(index), bucketValues);
+            }
+        }
+    }
+
+    void LatencyHistograms::setEnabled(bool isEnabled)
+    {
+        enabled.store(isEnabled, std::memory_order_relaxed);
+    }
+
+    bool LatencyHistograms::isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    LatencyHistogram& LatencyHistograms::get(std::string_view name)
+    {
+        {
+            std::shared_lock lock(histogramsLock);
+            if (auto histogram = histograms.find(name); histogram != histograms.end())
+            {
+                return *histogram->second;
+            }
+        }
+
+        std::unique_lock lock(histogramsLock);
+        auto [histogram, _inserted] = histograms.try_emplace(std::string(name), nullptr);
+        if (!histogram->second)
+        {
+            histogram->second = std::make_unique<LatencyHistogram>(enabled);
+        }
+        return *histogram->second;
+    }
+
+    void LatencyHistograms::forEach(const std::function<void(std::string_view, const LatencyHistogram&)>& visitor) const
+    {
+        std::shared_lock lock(histogramsLock);
+        for (const auto& [name, histogram] : histograms)
+        {
+            visitor(name, *histogram);
+        }
+    }
+
+    void LatencyHistograms::writeTo(const std::filesystem::path& path) const
+    {
+        auto temporaryPath = path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream output(temporaryPath, std::ios::trunc);
+            if (!output)
+            {
+                throw VmiException(fmt::format("{}: Unable to create {}", __func__, temporaryPath.string()));
+            }
+
+            output << "# name count mean_ns p50_ns p90_ns p99_ns p99.9_ns p99.99_ns max_ns\n";
+            forEach(
+                [&output](std::string_view name, const LatencyHistogram& histogram)
+                {
+                    if (histogram.getCount() == 0)
+                    {
+                        return;
+                    }
+                    output << fmt::format("{} {} {:.0f}", name, histogram.getCount(), histogram.getMean());
+                    for (auto percentile : summaryPercentiles)
+                    {
+                        output << ' ' << histogram.getValueAtPercentile(percentile);
+                    }
+                    output << ' ' << histogram.getMax() << '\n';
+                });
+
+            output << "\n# name lower_bound_ns upper_bound_ns count\n";
+            forEach(
+                [&output](std::string_view name, const LatencyHistogram& histogram)
+                {
+                    histogram.forEachBucket(
+                        [&output, name](uint64_t lowerBoundNs, uint64_t upperBoundNs, uint64_t count)
+                        { output << fmt::format("{} {} {} {}\n", name, lowerBoundNs, upperBoundNs, count); });
+                });
+
+            if (!output.flush())
+            {
+                throw VmiException(fmt::format("{}: Unable to write {}", __func__, temporaryPath.string()));
+            }
+        }
+        std::filesystem::rename(temporaryPath, path);
+    }
+}
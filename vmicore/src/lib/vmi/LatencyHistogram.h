@@ -0,0 +1,144 @@
+#ifndef VMICORE_LATENCYHISTOGRAM_H
+#define VMICORE_LATENCYHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+namespace VmiCore
+{
+    /**
+     * Histogram of durations in nanoseconds with logarithmic buckets that are linearly subdivided, similar to HDR
+     * histograms. Values are exact up to 31ns and have a relative error of at most 1/16 beyond that. Recording is
+     * wait-free, so a histogram may be shared by all event handling and worker threads.
+     */
+    class LatencyHistogram
+    {
+      public:
+        explicit LatencyHistogram(const std::atomic<bool>& enabled) : enabled(enabled) {}
+
+        [[nodiscard]] bool isEnabled() const
+        {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        void record(uint64_t valueNs);
+
+        [[nodiscard]] uint64_t getCount() const;
+
+        [[nodiscard]] uint64_t getMax() const;
+
+        [[nodiscard]] double getMean() const;
+
+        /**
+         * @return Upper bound of the bucket containing the value at the given percentile or zero if the histogram is
+         * empty.
+         */
+        [[nodiscard]] uint64_t getValueAtPercentile(double percentile) const;
+
+        void forEachBucket(const std::function<void(uint64_t lowerBoundNs, uint64_t upperBoundNs, uint64_t count)>&
+                               visitor) const;
+
+      private:
+        static constexpr std::size_t subBucketBits = 4;
+        static constexpr std::size_t subBucketCount = std::size_t{1} << subBucketBits;
+        static constexpr std::size_t bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+
+        const std::atomic<bool>& enabled;
+        std::array<std::atomic<uint64_t>, bucketCount> counts{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> maxNs{0};
+
+        [[nodiscard]] static std::size_t getBucketIndex(uint64_t valueNs);
+
+        [[nodiscard]] static uint64_t getBucketLowerBound(std::size_t index);
+
+        [[nodiscard]] static uint64_t getBucketUpperBound(std::size_t index);
+    };
+
+    /**
+     * Named latency histograms that are only recorded to while enabled. Histograms are never removed, so references
+     * may be cached by callers, e.g. in function local statics on hot paths.
+     */
+    class LatencyHistograms
+    {
+      public:
+        void setEnabled(bool isEnabled);
+
+        [[nodiscard]] bool isEnabled() const;
+
+        LatencyHistogram& get(std::string_view name);
+
+        void forEach(const std::function<void(std::string_view, const LatencyHistogram&)>& visitor) const;
+
+        /**
+         * Writes a summary of all non-empty histograms followed by their buckets. The file is replaced atomically, so
+         * it may be read while the analysis is still running.
+         */
+        void writeTo(const std::filesystem::path& path) const;
+
+      private:
+        std::atomic<bool> enabled = false;
+        mutable std::shared_mutex histogramsLock;
+        std::map<std::string, std::unique_ptr<LatencyHistogram>, std::less<>> histograms;
+    };
+
+    /**
+     * Records the lifetime of the scope into the given histogram. Does not even read the clock while histograms are
+     * disabled.
+     */
+    class ScopedLatency
+    {
+      public:
+        explicit ScopedLatency(LatencyHistogram& histogram)
+            : histogram(histogram.isEnabled() ? &histogram : nullptr),
+              start(this->histogram ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{})
+        {
+        }
+
+        ~ScopedLatency()
+        {
+            if (histogram)
+            {
+                histogram->record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                        .count()));
+            }
+        }
+
+        /**
+         * Records into the given histogram instead, for measurements that are only classified by their outcome.
+         */
+        void retarget(LatencyHistogram& newHistogram)
+        {
+            if (histogram)
+            {
+                histogram = &newHistogram;
+            }
+        }
+
+        ScopedLatency(const ScopedLatency&) = delete;
+
+        ScopedLatency(const ScopedLatency&&) = delete;
+
+        ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+        ScopedLatency& operator=(const ScopedLatency&&) = delete;
+
+      private:
+        LatencyHistogram* histogram;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+
+#endif // VMICORE_LATENCYHISTOGRAM_H
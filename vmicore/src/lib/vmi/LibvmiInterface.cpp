@@ -1,10 +1,16 @@
 #include "LibvmiInterface.h"
 #include "../GlobalControl.h"
+#include "GuestStrings.h"
 #include "VmiInitData.h"
 #include "VmiInitError.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
 #include <source_location>
 #include <utility>
 #include <vmicore/filename.h>
+#include <vmicore/os/PagingDefinitions.h>
 #include <vmicore/vmi/VmiException.h>
 
 namespace VmiCore
@@ -30,6 +36,12 @@ namespace VmiCore
 
     LibvmiInterface::~LibvmiInterface()
     {
+        logLockStatistics();
+        logTranslationCacheStatistics();
+        if (eventTraceWriter)
+        {
+            logger->info("Recorded events", {{"events", eventTraceWriter->getNumberOfRecords()}});
+        }
         vmi_resume_vm(vmiInstance);
         vmi_destroy(vmiInstance);
         libvmiInterfaceInstance = nullptr;
@@ -39,15 +51,26 @@ namespace VmiCore
     {
         logger->info("Initialize libvmi", {{"domain", configInterface->getVmName()}});
 
-        auto configString = createConfigString(configInterface->getOffsetsFile());
         auto initData = VmiInitData(configInterface->getSocketPath());
+        initializeInstance(configInterface->getVmName(), VMI_INIT_DOMAINNAME | VMI_INIT_EVENTS, initData.data);
+
+        if (auto tracePath = configInterface->getEventRecordingPath(); !tracePath.empty())
+        {
+            logger->info("Record events", {{"path", tracePath.string()}});
+            eventTraceWriter = std::make_unique<EventTraceWriter>(tracePath);
+        }
+    }
+
+    void LibvmiInterface::initializeInstance(const std::string& domain, uint64_t initFlags, vmi_init_data_t* initData)
+    {
+        auto configString = createConfigString(configInterface->getOffsetsFile());
         vmi_init_error initError;
 
-        std::lock_guard<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         if (vmi_init_complete(&vmiInstance,
-                              reinterpret_cast<const void*>(configInterface->getVmName().c_str()),
-                              VMI_INIT_DOMAINNAME | VMI_INIT_EVENTS,
-                              initData.data,
+                              reinterpret_cast<const void*>(domain.c_str()),
+                              initFlags,
+                              initData,
                               VMI_CONFIG_STRING,
                               reinterpret_cast<void*>(const_cast<char*>(configString->c_str())),
                               &initError) == VMI_FAILURE)
@@ -56,6 +79,42 @@ namespace VmiCore
         }
 
         numberOfVCPUs = vmi_get_num_vcpus(vmiInstance);
+        addressWidth = vmi_get_address_width(vmiInstance);
+        // Both values are immutable for the lifetime of the instance, so they are served without locking later on
+        osType = toOperatingSystem(vmi_get_ostype(vmiInstance));
+        if (osType == OperatingSystem::WINDOWS)
+        {
+            windowsBuild = vmi_get_win_buildnumber(vmiInstance);
+        }
+    }
+
+    void LibvmiInterface::logLockStatistics() const
+    {
+        lockStatistics.forEachSite(
+            [this](std::string_view site, uint_least32_t line, const LockSiteStatistics& statistics)
+            {
+                logger->info("Lock statistics",
+                             {{"site", site},
+                              {"line", static_cast<uint64_t>(line)},
+                              {"acquisitions", statistics.acquisitions.load()},
+                              {"totalWaitNs", statistics.totalWaitNs.load()},
+                              {"maxWaitNs", statistics.maxWaitNs.load()},
+                              {"totalHoldNs", statistics.totalHoldNs.load()},
+                              {"maxHoldNs", statistics.maxHoldNs.load()}});
+            });
+    }
+
+    void LibvmiInterface::logTranslationCacheStatistics() const
+    {
+        auto statistics = translationCache.getStatistics();
+        if (statistics.hits == 0 && statistics.misses == 0)
+        {
+            return;
+        }
+        logger->info("Translation cache statistics",
+                     {{"hits", statistics.hits},
+                      {"misses", statistics.misses},
+                      {"invalidations", statistics.invalidations}});
     }
 
     std::unique_ptr<std::string> LibvmiInterface::createConfigString(const std::string& offsetsFile)
@@ -77,7 +136,8 @@ namespace VmiCore
 
     void LibvmiInterface::clearEvent(vmi_event_t& event, bool deallocate)
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        recordedCallbacks.erase(&event);
         if (vmi_clear_event(vmiInstance, &event, deallocate ? &LibvmiInterface::freeEvent : nullptr) != VMI_SUCCESS)
         {
             throw VmiException(fmt::format("{}: Unable to clear event.", __func__));
@@ -88,8 +148,8 @@ namespace VmiCore
     {
         uint8_t extractedValue = 0;
         auto accessContext = createPhysicalAddressAccessContext(physicalAddress);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_read_8(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (!readGuestMemory(accessContext, sizeof(extractedValue), &extractedValue))
         {
             throw VmiException(fmt::format("{}: Unable to read one byte from PA: {:#x}", __func__, physicalAddress));
         }
@@ -100,8 +160,8 @@ namespace VmiCore
     {
         uint64_t extractedValue = 0;
         auto accessContext = createPhysicalAddressAccessContext(physicalAddress);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_read_64(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (!readGuestMemory(accessContext, sizeof(extractedValue), &extractedValue))
         {
             throw VmiException(fmt::format("{}: Unable to read 8 bytes from PA: {:#x}", __func__, physicalAddress));
         }
@@ -109,37 +169,67 @@ namespace VmiCore
     }
 
     uint8_t LibvmiInterface::read8VA(addr_t virtualAddress, addr_t cr3)
+    {
+        auto extractedValue = tryRead8VA(virtualAddress, cr3);
+        if (!extractedValue)
+        {
+            throw VmiException(fmt::format("{}: Unable to read one byte from VA: {:#x}", __func__, virtualAddress));
+        }
+        return *extractedValue;
+    }
+
+    std::optional<uint8_t> LibvmiInterface::tryRead8VA(addr_t virtualAddress, addr_t cr3)
     {
         uint8_t extractedValue = 0;
         auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_read_8(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (!readGuestMemory(accessContext, sizeof(extractedValue), &extractedValue))
         {
-            throw VmiException(fmt::format("{}: Unable to read one byte from VA: {:#x}", __func__, virtualAddress));
+            return std::nullopt;
         }
         return extractedValue;
     }
 
     uint32_t LibvmiInterface::read32VA(addr_t virtualAddress, addr_t cr3)
+    {
+        auto extractedValue = tryRead32VA(virtualAddress, cr3);
+        if (!extractedValue)
+        {
+            throw VmiException(fmt::format("{}: Unable to read 4 bytes from VA {:#x}", __func__, virtualAddress));
+        }
+        return *extractedValue;
+    }
+
+    std::optional<uint32_t> LibvmiInterface::tryRead32VA(addr_t virtualAddress, addr_t cr3)
     {
         uint32_t extractedValue = 0;
         auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_read_32(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (!readGuestMemory(accessContext, sizeof(extractedValue), &extractedValue))
         {
-            throw VmiException(fmt::format("{}: Unable to read 4 bytes from VA {:#x}", __func__, virtualAddress));
+            return std::nullopt;
         }
         return extractedValue;
     }
 
     uint64_t LibvmiInterface::read64VA(addr_t virtualAddress, addr_t cr3)
+    {
+        auto extractedValue = tryRead64VA(virtualAddress, cr3);
+        if (!extractedValue)
+        {
+            throw VmiException(fmt::format("{}: Unable to read 8 bytes from VA {:#x}", __func__, virtualAddress));
+        }
+        return *extractedValue;
+    }
+
+    std::optional<uint64_t> LibvmiInterface::tryRead64VA(addr_t virtualAddress, addr_t cr3)
     {
         uint64_t extractedValue = 0;
         auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_read_64(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (!readGuestMemory(accessContext, sizeof(extractedValue), &extractedValue))
         {
-            throw VmiException(fmt::format("{}: Unable to read 8 bytes from VA {:#x}", __func__, virtualAddress));
+            return std::nullopt;
         }
         return extractedValue;
     }
@@ -154,8 +244,8 @@ namespace VmiCore
 
         uint64_t result = 0;
         auto accessContext = createVirtualAddressAccessContext(virtualAddress, dtb);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_read(vmiInstance, &accessContext, size, &result, nullptr) != VMI_SUCCESS)
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (!readGuestMemory(accessContext, size, &result))
         {
             throw VmiException(fmt::format("{}: Unable to read {} bytes from VA {:#x}",
                                            std::source_location::current().function_name(),
@@ -175,29 +265,205 @@ namespace VmiCore
         }
 
         auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_read(vmiInstance, &accessContext, size, content.data(), nullptr) != VMI_SUCCESS)
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        return readGuestMemory(accessContext, size, content.data());
+    }
+
+    bool LibvmiInterface::readBatch(std::span<BatchReadEntry> entries)
+    {
+        std::vector<std::size_t> order(entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order,
+                          [&entries](std::size_t lhs, std::size_t rhs)
+                          {
+                              return std::tie(entries[lhs].dtb, entries[lhs].virtualAddress) <
+                                     std::tie(entries[rhs].dtb, entries[rhs].virtualAddress);
+                          });
+
+        std::vector<uint8_t> groupBuffer{};
+        bool allSuccessful = true;
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        for (auto groupBegin = order.cbegin(); groupBegin != order.cend();)
         {
-            return false;
+            const auto& first = entries[*groupBegin];
+            auto page = first.virtualAddress & PagingDefinitions::stripPageOffsetMask;
+            auto groupEnd = std::find_if(groupBegin,
+                                         order.cend(),
+                                         [&entries, &first, page](std::size_t index)
+                                         {
+                                             return entries[index].dtb != first.dtb ||
+                                                    (entries[index].virtualAddress &
+                                                     PagingDefinitions::stripPageOffsetMask) != page;
+                                         });
+            allSuccessful = readBatchGroup(entries, {groupBegin, groupEnd}, groupBuffer) && allSuccessful;
+            groupBegin = groupEnd;
         }
-        return true;
+
+        return allSuccessful;
     }
 
-    mapped_regions_t LibvmiInterface::mmapGuest(addr_t baseVA, addr_t dtb, std::size_t numberOfPages)
+    bool LibvmiInterface::readBatchGroup(std::span<BatchReadEntry> entries,
+                                         std::span<const std::size_t> group,
+                                         std::vector<uint8_t>& groupBuffer)
     {
-        mapped_regions_t regions{};
-        auto accessContext = createVirtualAddressAccessContext(baseVA, dtb);
-        std::lock_guard lock(libvmiLock);
-        if (vmi_mmap_guest_2(vmiInstance, &accessContext, numberOfPages, PROT_READ, &regions) != VMI_SUCCESS)
+        // Entries are sorted by address, so the first one marks the start of the range covered by this group
+        auto rangeBegin = entries[group.front()].virtualAddress;
+        auto rangeEnd = rangeBegin;
+        for (auto index : group)
+        {
+            rangeEnd = std::max(rangeEnd, entries[index].virtualAddress + entries[index].size);
+        }
+
+        if (group.size() > 1)
+        {
+            groupBuffer.resize(rangeEnd - rangeBegin);
+            auto accessContext = createVirtualAddressAccessContext(rangeBegin, entries[group.front()].dtb);
+            if (readGuestMemory(accessContext, groupBuffer.size(), groupBuffer.data()))
+            {
+                for (auto index : group)
+                {
+                    auto& entry = entries[index];
+                    std::memcpy(entry.destination,
+                                std::span(groupBuffer).subspan(entry.virtualAddress - rangeBegin).data(),
+                                entry.size);
+                    entry.success = true;
+                }
+                return true;
+            }
+        }
+
+        // Either there is nothing to combine or the combined range is not fully accessible, e.g. because one entry
+        // crosses into a paged out page. Read each entry on its own in order to determine the individual status.
+        bool allSuccessful = true;
+        for (auto index : group)
+        {
+            auto& entry = entries[index];
+            auto accessContext = createVirtualAddressAccessContext(entry.virtualAddress, entry.dtb);
+            entry.success = readGuestMemory(accessContext, entry.size, entry.destination);
+            allSuccessful = entry.success && allSuccessful;
+        }
+
+        return allSuccessful;
+    }
+
+    std::vector<mapped_regions_t> LibvmiInterface::mmapGuest(addr_t baseVA, addr_t dtb, std::size_t numberOfPages)
+    {
+        // Consecutive 4 KiB pages are left to libvmi, whereas physically contiguous large pages are collected into
+        // chunks that are mapped without any further page walk
+        struct Chunk
+        {
+            addr_t beginVA;
+            addr_t endVA;
+            std::optional<addr_t> beginPA;
+        };
+        std::vector<Chunk> chunks;
+        const auto endVA = baseVA + numberOfPages * PagingDefinitions::pageSizeInBytes;
+
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        for (auto currentVA = baseVA; currentVA < endVA;)
+        {
+            page_info_t pageInfo{};
+            auto isMapped = vmi_pagetable_lookup_extended(vmiInstance, dtb, currentVA, &pageInfo) == VMI_SUCCESS;
+            // A 4 KiB page implies that the whole page table it belongs to does not contain any large pages
+            auto stride = isMapped ? std::max<addr_t>(pageInfo.size, VMI_PS_2MB) : PagingDefinitions::pageSizeInBytes;
+            auto nextVA = std::min(endVA, (currentVA & ~(stride - 1)) + stride);
+            std::optional<addr_t> currentPA{};
+            if (isMapped && pageInfo.size > VMI_PS_4KB)
+            {
+                currentPA = pageInfo.paddr;
+            }
+
+            if (!chunks.empty() && chunks.back().beginPA.has_value() == currentPA.has_value() &&
+                (!currentPA || *chunks.back().beginPA + (currentVA - chunks.back().beginVA) == *currentPA))
+            {
+                chunks.back().endVA = nextVA;
+            }
+            else
+            {
+                chunks.push_back({currentVA, nextVA, currentPA});
+            }
+            currentVA = nextVA;
+        }
+
+        std::vector<mapped_regions_t> mappedChunks;
+        for (const auto& chunk : chunks)
+        {
+            auto chunkPages = (chunk.endVA - chunk.beginVA) / PagingDefinitions::pageSizeInBytes;
+            if (auto regions = mmapGuestChunk(chunk.beginVA, dtb, chunk.beginPA, chunkPages))
+            {
+                mappedChunks.push_back(*regions);
+            }
+            else
+            {
+                logger->warning("Unable to map guest memory chunk",
+                                {{"VA", fmt::format("{:#x}", chunk.beginVA)},
+                                 {"Size", fmt::format("{:#x}", chunk.endVA - chunk.beginVA)}});
+            }
+        }
+        if (mappedChunks.empty())
         {
             throw VmiException(fmt::format("{}: Unable to create memory mapping for VA {:#x} with number of pages {}",
                                            std::source_location::current().function_name(),
                                            baseVA,
                                            numberOfPages));
         }
+        return mappedChunks;
+    }
+
+    std::optional<mapped_regions_t> LibvmiInterface::mmapGuestChunk(addr_t baseVA,
+                                                                    addr_t dtb,
+                                                                    std::optional<addr_t> basePA,
+                                                                    std::size_t numberOfPages)
+    {
+        mapped_regions_t regions{};
+        if (basePA)
+        {
+            auto accessContext = createPhysicalAddressAccessContext(*basePA);
+            if (vmi_mmap_guest_2(vmiInstance, &accessContext, numberOfPages, PROT_READ, &regions) == VMI_SUCCESS)
+            {
+                if (relocateMappedRegions(regions, *basePA, baseVA, numberOfPages))
+                {
+                    return regions;
+                }
+                logger->warning("Unexpected regions in physical mapping, falling back to virtual mapping",
+                                {{"VA", fmt::format("{:#x}", baseVA)}, {"PA", fmt::format("{:#x}", *basePA)}});
+                vmi_free_mapped_regions(vmiInstance, &regions);
+                regions = {};
+            }
+        }
+
+        auto accessContext = createVirtualAddressAccessContext(baseVA, dtb);
+        if (vmi_mmap_guest_2(vmiInstance, &accessContext, numberOfPages, PROT_READ, &regions) != VMI_SUCCESS)
+        {
+            return std::nullopt;
+        }
         return regions;
     }
 
+    bool LibvmiInterface::relocateMappedRegions(mapped_regions_t& regions,
+                                                addr_t basePA,
+                                                addr_t baseVA,
+                                                std::size_t numberOfPages)
+    {
+        auto regionSpan = std::span(regions.regions, regions.size);
+        const auto endPA = basePA + numberOfPages * PagingDefinitions::pageSizeInBytes;
+        auto isWithinRequestedRange = [basePA, endPA](const mapped_region_t& region)
+        {
+            return region.start_va >= basePA &&
+                   region.start_va + region.num_pages * PagingDefinitions::pageSizeInBytes <= endPA;
+        };
+        if (!std::ranges::all_of(regionSpan, isWithinRequestedRange))
+        {
+            return false;
+        }
+
+        for (auto& region : regionSpan)
+        {
+            region.start_va = baseVA + (region.start_va - basePA);
+        }
+        return true;
+    }
+
     void LibvmiInterface::freeMappedRegions(const mapped_regions_t& mappedRegions)
     {
         vmi_free_mapped_regions(vmiInstance, &mappedRegions);
@@ -206,13 +472,77 @@ namespace VmiCore
     void LibvmiInterface::write8PA(addr_t physicalAddress, uint8_t value)
     {
         auto accessContext = createPhysicalAddressAccessContext(physicalAddress);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (eventRecorder.isRecording())
+        {
+            eventRecorder.capture(0, physicalAddress, sizeof(value));
+        }
         if (vmi_write_8(vmiInstance, &accessContext, &value) == VMI_FAILURE)
         {
             throw VmiException(fmt::format("{}: Unable to write {:#x} to PA {:#x}", __func__, value, physicalAddress));
         }
     }
 
+    bool LibvmiInterface::readGuestMemory(access_context_t& accessContext, std::size_t size, void* buffer)
+    {
+        if (eventRecorder.isRecording())
+        {
+            auto dtb = accessContext.translate_mechanism == VMI_TM_NONE ? 0 : accessContext.page_table;
+            eventRecorder.capture(dtb, accessContext.addr, size);
+        }
+        return vmi_read(vmiInstance, &accessContext, size, buffer, nullptr) == VMI_SUCCESS;
+    }
+
+    event_response_t LibvmiInterface::recordingCallback(vmi_instance_t vmi, vmi_event_t* event)
+    {
+        return libvmiInterfaceInstance->recordEvent(vmi, event);
+    }
+
+    event_response_t LibvmiInterface::recordEvent(vmi_instance_t vmi, vmi_event_t* event)
+    {
+        event_callback_t callback = nullptr;
+        {
+            InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+            if (auto original = recordedCallbacks.find(event); original != recordedCallbacks.end())
+            {
+                callback = original->second;
+            }
+            if (callback != nullptr && eventTraceWriter)
+            {
+                eventRecorder.begin(*event);
+            }
+        }
+        if (callback == nullptr)
+        {
+            return VMI_EVENT_RESPONSE_NONE;
+        }
+
+        auto eventResponse = callback(vmi, event);
+
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (auto record = eventRecorder.finish(); record && eventTraceWriter)
+        {
+            try
+            {
+                eventTraceWriter->write(*record);
+            }
+            catch (const std::exception& e)
+            {
+                logger->error("Stop recording events", {{"exception", e.what()}});
+                eventTraceWriter.reset();
+            }
+        }
+        return eventResponse;
+    }
+
+    bool LibvmiInterface::readRecordedPage(addr_t dtb, addr_t pageAddress, std::span<uint8_t> content)
+    {
+        // Pages are read by the recorder right before their first access, hence prior to any write of the callback
+        auto accessContext = dtb == 0 ? createPhysicalAddressAccessContext(pageAddress)
+                                      : createVirtualAddressAccessContext(pageAddress, dtb);
+        return vmi_read(vmiInstance, &accessContext, content.size(), content.data(), nullptr) == VMI_SUCCESS;
+    }
+
     access_context_t LibvmiInterface::createPhysicalAddressAccessContext(addr_t physicalAddress)
     {
         access_context_t accessContext{};
@@ -234,7 +564,7 @@ namespace VmiCore
 
     void LibvmiInterface::eventsListen(uint32_t timeout)
     {
-        std::scoped_lock<std::mutex> lock(eventsListenLock);
+        InstrumentedLockGuard lock(eventsListenLock, lockStatistics);
         auto status = vmi_events_listen(vmiInstance, timeout);
         if (status != VMI_SUCCESS)
         {
@@ -242,6 +572,20 @@ namespace VmiCore
         }
     }
 
+    void LibvmiInterface::setMemAccess(std::span<const addr_t> gfns, vmi_mem_access_t access)
+    {
+        // Libvmi only changes a single frame at a time, so batching merely spares acquiring the lock for each one
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        for (auto gfn : gfns)
+        {
+            if (vmi_set_mem_event(vmiInstance, gfn, access, 0) != VMI_SUCCESS)
+            {
+                throw VmiException(
+                    fmt::format("{}: Unable to set access permissions of gfn {:#x} to {}", __func__, gfn, access));
+            }
+        }
+    }
+
     std::string eventTypeToString(vmi_event_type_t eventType)
     {
         std::string typeAsString;
@@ -268,7 +612,13 @@ namespace VmiCore
 
     void LibvmiInterface::registerEvent(vmi_event_t& event)
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        if (eventTraceWriter && event.callback != &LibvmiInterface::recordingCallback)
+        {
+            // Events are redirected to the recorder, which forwards them to the callback they have been set up with
+            recordedCallbacks[&event] = event.callback;
+            event.callback = &LibvmiInterface::recordingCallback;
+        }
         if (vmi_register_event(vmiInstance, &event) == VMI_FAILURE)
         {
             throw VmiException(
@@ -278,7 +628,7 @@ namespace VmiCore
 
     uint64_t LibvmiInterface::getCurrentVmId()
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         return vmi_get_vmid(vmiInstance);
     }
 
@@ -290,7 +640,7 @@ namespace VmiCore
     addr_t LibvmiInterface::translateKernelSymbolToVA(const std::string& kernelSymbolName)
     {
         addr_t kernelSymbolAddress = 0;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         if (vmi_translate_ksym2v(vmiInstance, kernelSymbolName.c_str(), &kernelSymbolAddress) != VMI_SUCCESS)
         {
             throw VmiException(fmt::format("{}: Unable to find kernel symbol {}", __func__, kernelSymbolName));
@@ -304,7 +654,7 @@ namespace VmiCore
     {
         auto ctx = createVirtualAddressAccessContext(moduleBaseAddress, dtb);
         addr_t userlandSymbolVA = 0;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         if (vmi_translate_sym2v(vmiInstance, &ctx, userlandSymbolName.c_str(), &userlandSymbolVA) != VMI_SUCCESS)
         {
             throw VmiException(
@@ -320,20 +670,30 @@ namespace VmiCore
 
     addr_t LibvmiInterface::convertVAToPA(addr_t virtualAddress, addr_t processCr3)
     {
+        if (auto cachedPhysicalAddress = translationCache.lookup(processCr3, virtualAddress))
+        {
+            return *cachedPhysicalAddress;
+        }
+
         addr_t physicalAddress = 0;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_pagetable_lookup(vmiInstance, processCr3, virtualAddress, &physicalAddress) != VMI_SUCCESS)
         {
-            throw VmiException(fmt::format(
-                "{}: Conversion of address {:#x} with cr3 {:#x} not possible.", __func__, virtualAddress, processCr3));
+            InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+            if (vmi_pagetable_lookup(vmiInstance, processCr3, virtualAddress, &physicalAddress) != VMI_SUCCESS)
+            {
+                throw VmiException(fmt::format("{}: Conversion of address {:#x} with cr3 {:#x} not possible.",
+                                               __func__,
+                                               virtualAddress,
+                                               processCr3));
+            }
         }
+        translationCache.insert(processCr3, virtualAddress, physicalAddress);
         return physicalAddress;
     }
 
     addr_t LibvmiInterface::convertPidToDtb(pid_t processID)
     {
         addr_t dtb = 0;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         if (vmi_pid_to_dtb(vmiInstance, processID, &dtb) != VMI_SUCCESS)
         {
             throw VmiException(fmt::format("Unable to obtain the dtb for pid {}", processID));
@@ -344,7 +704,7 @@ namespace VmiCore
     pid_t LibvmiInterface::convertDtbToPid(addr_t dtb)
     {
         vmi_pid_t pid = 0;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         if (vmi_dtb_to_pid(vmiInstance, dtb, &pid) != VMI_SUCCESS)
         {
             throw VmiException(fmt::format("Unable obtain the pid for dtb {:#x}", dtb));
@@ -354,7 +714,7 @@ namespace VmiCore
 
     void LibvmiInterface::pauseVm()
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         auto status = vmi_pause_vm(vmiInstance);
         if (status != VMI_SUCCESS)
         {
@@ -364,7 +724,7 @@ namespace VmiCore
 
     void LibvmiInterface::resumeVm()
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         auto status = vmi_resume_vm(vmiInstance);
         if (status != VMI_SUCCESS)
         {
@@ -375,7 +735,7 @@ namespace VmiCore
     bool LibvmiInterface::areEventsPending()
     {
         bool pending = false;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         auto areEventsPendingReturn = vmi_are_events_pending(vmiInstance);
         if (areEventsPendingReturn == -1)
         {
@@ -397,72 +757,120 @@ namespace VmiCore
         {
             throw VmiException(fmt::format("{}: Unable to convert unicode string", __func__));
         }
-        return std::move(extractedString.value());
+        return std::make_unique<std::string>(std::move(*extractedString));
     }
 
     std::optional<std::string> LibvmiInterface::extractWStringAtVA(addr_t stringVA, addr_t cr3)
     {
-        auto accessContext = createVirtualAddressAccessContext(stringVA, cr3);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        auto* extractedWString = vmi_read_w_str(vmiInstance, &accessContext);
-        auto convertedUnicodeString = unicode_string_t{};
-        auto success = vmi_convert_str_encoding(extractedWString, &convertedUnicodeString, "UTF-8");
-        vmi_free_unicode_str(extractedWString);
-        if (success != VMI_SUCCESS)
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        auto length = readTerminatedString(stringVA, cr3, sizeof(uint16_t));
+        if (!length)
         {
             return std::nullopt;
         }
-        auto* result = reinterpret_cast<char*>(convertedUnicodeString.contents);
-        free(convertedUnicodeString.contents); // NOLINT(cppcoreguidelines-owning-memory, cppcoreguidelines-no-malloc)
+        std::string result;
+        GuestStrings::appendUtf16LeAsUtf8(std::span(stringBuffer).first(*length), result);
         return result;
     }
 
-    std::optional<std::unique_ptr<std::string>> LibvmiInterface::tryExtractUnicodeStringAtVA(addr_t stringVA,
-                                                                                             addr_t cr3)
+    std::optional<std::string> LibvmiInterface::tryExtractUnicodeStringAtVA(addr_t stringVA, addr_t cr3)
     {
+        // _UNICODE_STRING: USHORT Length, USHORT MaximumLength, followed by the pointer sized Buffer
+        std::array<uint8_t, 2 * sizeof(uint64_t)> header{};
+        const std::size_t bufferOffset = addressWidth == sizeof(uint32_t) ? sizeof(uint32_t) : sizeof(uint64_t);
+        const std::size_t headerSize = bufferOffset + addressWidth;
+
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         auto accessContext = createVirtualAddressAccessContext(stringVA, cr3);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        auto* extractedUnicodeString = vmi_read_unicode_str(vmiInstance, &accessContext);
-        auto convertedUnicodeString = unicode_string_t{};
-        auto success = vmi_convert_str_encoding(extractedUnicodeString, &convertedUnicodeString, "UTF-8");
-        vmi_free_unicode_str(extractedUnicodeString);
-        if (success != VMI_SUCCESS)
+        if (!readGuestMemory(accessContext, headerSize, header.data()))
         {
             return std::nullopt;
         }
-        auto result = std::make_unique<std::string>(reinterpret_cast<char*>(convertedUnicodeString.contents),
-                                                    convertedUnicodeString.length);
-        free(convertedUnicodeString.contents); // NOLINT(cppcoreguidelines-owning-memory, cppcoreguidelines-no-malloc)
+        uint16_t length = 0;
+        addr_t buffer = 0;
+        std::memcpy(&length, header.data(), sizeof(length));
+        std::memcpy(&buffer, std::span(header).subspan(bufferOffset).data(), addressWidth);
+
+        stringBuffer.resize(length);
+        accessContext = createVirtualAddressAccessContext(buffer, cr3);
+        if (length > 0 && !readGuestMemory(accessContext, stringBuffer.size(), stringBuffer.data()))
+        {
+            return std::nullopt;
+        }
+        std::string result;
+        GuestStrings::appendUtf16LeAsUtf8(stringBuffer, result);
         return result;
     }
 
     std::unique_ptr<std::string> LibvmiInterface::extractStringAtVA(addr_t virtualAddress, addr_t cr3)
     {
-        auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        auto* rawString = vmi_read_str(vmiInstance, &accessContext);
-        if (rawString == nullptr)
+        auto extractedString = tryExtractStringAtVA(virtualAddress, cr3);
+        if (!extractedString)
         {
             throw VmiException(fmt::format("{}: Unable to read string at VA {:#x}", __func__, virtualAddress));
         }
-        auto result = std::make_unique<std::string>(rawString);
-        free(rawString);
-        return result;
+        return std::make_unique<std::string>(std::move(*extractedString));
+    }
+
+    std::optional<std::string> LibvmiInterface::tryExtractStringAtVA(addr_t virtualAddress, addr_t cr3)
+    {
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+        auto length = readTerminatedString(virtualAddress, cr3, sizeof(char));
+        if (!length)
+        {
+            return std::nullopt;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return std::string(reinterpret_cast<const char*>(stringBuffer.data()), *length);
+    }
+
+    std::optional<std::size_t>
+    LibvmiInterface::readTerminatedString(addr_t virtualAddress, addr_t cr3, std::size_t characterSize)
+    {
+        // Read page-wise, as the terminator is usually located within the first page and the following pages might
+        // not even be mapped
+        stringBuffer.clear();
+        std::size_t searchedBytes = 0;
+        auto currentAddress = virtualAddress;
+        while (stringBuffer.size() < maxStringLength)
+        {
+            auto chunkSize =
+                PagingDefinitions::pageSizeInBytes - (currentAddress & PagingDefinitions::pageOffsetMask);
+            auto chunkOffset = stringBuffer.size();
+            stringBuffer.resize(chunkOffset + chunkSize);
+            auto accessContext = createVirtualAddressAccessContext(currentAddress, cr3);
+            if (!readGuestMemory(accessContext, chunkSize, &stringBuffer[chunkOffset]))
+            {
+                return std::nullopt;
+            }
+            currentAddress += chunkSize;
+
+            auto unsearched = std::span(stringBuffer).subspan(searchedBytes);
+            auto terminator = characterSize == sizeof(char) ? GuestStrings::findTerminator(unsearched)
+                                                            : GuestStrings::findUtf16Terminator(unsearched);
+            if (terminator)
+            {
+                return searchedBytes + *terminator;
+            }
+            // A code unit may be split across pages, in which case it is searched again with the next chunk
+            searchedBytes = stringBuffer.size() - (stringBuffer.size() % characterSize);
+        }
+
+        return std::nullopt;
     }
 
     void LibvmiInterface::stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId)
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         if (vmi_stop_single_step_vcpu(vmiInstance, event, vcpuId) != VMI_SUCCESS)
         {
             throw VmiException(fmt::format("Failed to stop single stepping for vcpu {}", vcpuId));
         }
     }
 
-    OperatingSystem LibvmiInterface::getOsType()
+    OperatingSystem LibvmiInterface::toOperatingSystem(os_t libvmiOsType)
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        switch (vmi_get_ostype(vmiInstance))
+        switch (libvmiOsType)
         {
             case VMI_OS_LINUX:
                 return OperatingSystem::LINUX;
@@ -473,45 +881,67 @@ namespace VmiCore
         }
     }
 
+    OperatingSystem LibvmiInterface::getOsType()
+    {
+        return osType;
+    }
+
     addr_t LibvmiInterface::getOffset(const std::string& name)
     {
-        addr_t offset = 0;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_get_offset(vmiInstance, name.c_str(), &offset) != VMI_SUCCESS)
-        {
-            throw VmiException(fmt::format("{}: Unable to find offset {}", __func__, name));
-        }
-        return offset;
+        return lookupCached(offsetCache,
+                            name,
+                            [this, &name, caller = __func__]()
+                            {
+                                addr_t offset = 0;
+                                InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+                                if (vmi_get_offset(vmiInstance, name.c_str(), &offset) != VMI_SUCCESS)
+                                {
+                                    throw VmiException(fmt::format("{}: Unable to find offset {}", caller, name));
+                                }
+                                return offset;
+                            });
     }
 
     addr_t LibvmiInterface::getKernelStructOffset(const std::string& structName, const std::string& member)
     {
-        addr_t memberAddress = 0;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_get_kernel_struct_offset(vmiInstance, structName.c_str(), member.c_str(), &memberAddress) !=
-            VMI_SUCCESS)
-        {
-            throw VmiException(
-                fmt::format("Failed to get offset of kernel struct {} with member {}", structName, member));
-        }
-        return memberAddress;
+        return lookupCached(
+            kernelStructOffsetCache,
+            std::make_pair(structName, member),
+            [this, &structName, &member]()
+            {
+                addr_t memberAddress = 0;
+                InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+                if (vmi_get_kernel_struct_offset(vmiInstance, structName.c_str(), member.c_str(), &memberAddress) !=
+                    VMI_SUCCESS)
+                {
+                    throw VmiException(
+                        fmt::format("Failed to get offset of kernel struct {} with member {}", structName, member));
+                }
+                return memberAddress;
+            });
     }
 
     size_t LibvmiInterface::getStructSizeFromJson(const std::string& struct_name)
     {
-        size_t size = 0;
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        if (vmi_get_struct_size_from_json(vmiInstance, vmi_get_kernel_json(vmiInstance), struct_name.c_str(), &size) !=
-            VMI_SUCCESS)
-        {
-            throw VmiException(fmt::format("{}: Unable to extract struct size of {}", __func__, struct_name));
-        }
-        return size;
+        return lookupCached(
+            structSizeCache,
+            struct_name,
+            [this, &struct_name, caller = __func__]()
+            {
+                size_t size = 0;
+                InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+                if (vmi_get_struct_size_from_json(
+                        vmiInstance, vmi_get_kernel_json(vmiInstance), struct_name.c_str(), &size) != VMI_SUCCESS)
+                {
+                    throw VmiException(fmt::format("{}: Unable to extract struct size of {}", caller, struct_name));
+                }
+                return size;
+            });
     }
 
     uint16_t LibvmiInterface::getWindowsBuild()
     {
-        return vmi_get_win_buildnumber(vmiInstance);
+        return windowsBuild;
     }
 
     bool LibvmiInterface::isInitialized() const
@@ -522,37 +952,61 @@ namespace VmiCore
     std::tuple<addr_t, size_t, size_t>
     LibvmiInterface::getBitfieldOffsetAndSizeFromJson(const std::string& structName, const std::string& structMember)
     {
-        addr_t offset{};
-        size_t startBit{};
-        size_t endBit{};
-
-        std::scoped_lock<std::mutex> lock(libvmiLock);
-        auto ret = vmi_get_bitfield_offset_and_size_from_json(vmiInstance,
-                                                              vmi_get_kernel_json(vmiInstance),
-                                                              structName.c_str(),
-                                                              structMember.c_str(),
-                                                              &offset,
-                                                              &startBit,
-                                                              &endBit);
-        if (ret != VMI_SUCCESS)
-        {
-            throw VmiException(fmt::format("{}: Unable extract offset and size from struct {} with member {}",
-                                           __func__,
-                                           structName,
-                                           structMember));
-        }
-        return std::make_tuple(offset, startBit, endBit);
+        return lookupCached(
+            bitfieldCache,
+            std::make_pair(structName, structMember),
+            [this, &structName, &structMember, caller = __func__]()
+            {
+                addr_t offset{};
+                size_t startBit{};
+                size_t endBit{};
+
+                InstrumentedLockGuard lock(libvmiLock, lockStatistics);
+                auto ret = vmi_get_bitfield_offset_and_size_from_json(vmiInstance,
+                                                                      vmi_get_kernel_json(vmiInstance),
+                                                                      structName.c_str(),
+                                                                      structMember.c_str(),
+                                                                      &offset,
+                                                                      &startBit,
+                                                                      &endBit);
+                if (ret != VMI_SUCCESS)
+                {
+                    throw VmiException(fmt::format("{}: Unable extract offset and size from struct {} with member {}",
+                                                   caller,
+                                                   structName,
+                                                   structMember));
+                }
+                return std::make_tuple(offset, startBit, endBit);
+            });
     }
 
     void LibvmiInterface::flushV2PCache(addr_t pt)
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        if (pt == flushAllPTs)
+        {
+            translationCache.clear();
+        }
+        else
+        {
+            translationCache.invalidateDtb(pt);
+        }
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         vmi_v2pcache_flush(vmiInstance, pt);
     }
 
     void LibvmiInterface::flushPageCache()
     {
-        std::scoped_lock<std::mutex> lock(libvmiLock);
+        InstrumentedLockGuard lock(libvmiLock, lockStatistics);
         vmi_pagecache_flush(vmiInstance);
     }
+
+    void LibvmiInterface::invalidateTranslationsToGfn(addr_t gfn)
+    {
+        translationCache.invalidateGfn(gfn);
+    }
+
+    TranslationCacheStatistics LibvmiInterface::getTranslationCacheStatistics() const
+    {
+        return translationCache.getStatistics();
+    }
 }
@@ -4,11 +4,20 @@
 #include "../config/IConfigParser.h"
 #include "../io/IEventStream.h"
 #include "../io/ILogging.h"
+#include "EventTrace.h"
+#include "InstrumentedLock.h"
+#include "TranslationCache.h"
 #include <fmt/core.h>
 #include <libvmi/events.h>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <vmicore/io/ILogger.h>
 #include <vmicore/os/OperatingSystem.h>
@@ -33,7 +42,13 @@ namespace VmiCore
 
         virtual void clearEvent(vmi_event_t& event, bool deallocate) = 0;
 
-        virtual mapped_regions_t mmapGuest(addr_t baseVA, addr_t dtb, std::size_t numberOfPages) = 0;
+        /**
+         * Maps the given guest virtual range. Parts that are backed by large guest pages are mapped by their
+         * physical address, which avoids walking the page tables for each 4 KiB page within them.
+         *
+         * @return One or more chunks, which have to be freed individually via freeMappedRegions.
+         */
+        virtual std::vector<mapped_regions_t> mmapGuest(addr_t baseVA, addr_t dtb, std::size_t numberOfPages) = 0;
 
         virtual void freeMappedRegions(const mapped_regions_t& mappedRegions) = 0;
 
@@ -43,6 +58,12 @@ namespace VmiCore
 
         virtual void registerEvent(vmi_event_t& event) = 0;
 
+        /**
+         * Sets the access permissions of several guest frames at once. Violations are reported to the generic memory
+         * event registered for the respective access type. VMI_MEMACCESS_N lifts all restrictions again.
+         */
+        virtual void setMemAccess(std::span<const addr_t> gfns, vmi_mem_access_t access) = 0;
+
         virtual void pauseVm() = 0;
 
         virtual void resumeVm() = 0;
@@ -51,6 +72,15 @@ namespace VmiCore
 
         virtual void stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId) = 0;
 
+        /**
+         * Drops all cached translations that resolve to the given guest frame, regardless of the address space. Only
+         * required if the frame itself has changed its role, e.g. a page table frame that has been freed. Writes to the
+         * content of a frame leave translations to it intact.
+         */
+        virtual void invalidateTranslationsToGfn(addr_t gfn) = 0;
+
+        [[nodiscard]] virtual TranslationCacheStatistics getTranslationCacheStatistics() const = 0;
+
       protected:
         ILibvmiInterface() = default;
     };
@@ -80,10 +110,27 @@ namespace VmiCore
 
         [[nodiscard]] uint64_t readVA(addr_t virtualAddress, addr_t dtb, std::size_t size) override;
 
+        [[nodiscard]] std::optional<uint8_t> tryRead8VA(addr_t virtualAddress, addr_t cr3) override;
+
+        [[nodiscard]] std::optional<uint32_t> tryRead32VA(addr_t virtualAddress, addr_t cr3) override;
+
+        [[nodiscard]] std::optional<uint64_t> tryRead64VA(addr_t virtualAddress, addr_t cr3) override;
+
         [[nodiscard]] bool
         readXVA(addr_t virtualAddress, addr_t cr3, std::vector<uint8_t>& content, std::size_t size) override;
 
-        mapped_regions_t mmapGuest(addr_t baseVA, addr_t dtb, std::size_t numberOfPages) override;
+        [[nodiscard]] bool readBatch(std::span<BatchReadEntry> entries) override;
+
+        std::vector<mapped_regions_t> mmapGuest(addr_t baseVA, addr_t dtb, std::size_t numberOfPages) override;
+
+        /**
+         * vmi_mmap_guest_2 reports the start of each region in the address space of the access context, i.e. as a
+         * physical address when mapping without translation. Moves the regions of such a mapping to the virtual base
+         * the caller asked for. Leaves the regions untouched and returns false if any of them lies outside of the
+         * requested physical range.
+         */
+        [[nodiscard]] static bool
+        relocateMappedRegions(mapped_regions_t& regions, addr_t basePA, addr_t baseVA, std::size_t numberOfPages);
 
         void freeMappedRegions(const mapped_regions_t& mappedRegions) override;
 
@@ -93,6 +140,8 @@ namespace VmiCore
 
         void registerEvent(vmi_event_t& event) override;
 
+        void setMemAccess(std::span<const addr_t> gfns, vmi_mem_access_t access) override;
+
         [[nodiscard]] uint64_t getCurrentVmId() override;
 
         [[nodiscard]] uint getNumberOfVCPUs() const override;
@@ -119,13 +168,18 @@ namespace VmiCore
 
         [[nodiscard]] std::optional<std::string> extractWStringAtVA(addr_t stringVA, addr_t cr3) override;
 
-        [[nodiscard]] std::optional<std::unique_ptr<std::string>> tryExtractUnicodeStringAtVA(addr_t stringVA,
-                                                                                              addr_t cr3) override;
+        [[nodiscard]] std::optional<std::string> tryExtractUnicodeStringAtVA(addr_t stringVA, addr_t cr3) override;
 
         [[nodiscard]] std::unique_ptr<std::string> extractStringAtVA(addr_t virtualAddress, addr_t cr3) override;
 
+        [[nodiscard]] std::optional<std::string> tryExtractStringAtVA(addr_t virtualAddress, addr_t cr3) override;
+
         void stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId) override;
 
+        void invalidateTranslationsToGfn(addr_t gfn) override;
+
+        [[nodiscard]] TranslationCacheStatistics getTranslationCacheStatistics() const override;
+
         [[nodiscard]] OperatingSystem getOsType() override;
 
         [[nodiscard]] uint16_t getWindowsBuild() override;
@@ -134,7 +188,7 @@ namespace VmiCore
         {
             auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
             auto exctractedValue = std::make_unique<T>();
-            std::lock_guard<std::mutex> lock(libvmiLock);
+            InstrumentedLockGuard lock(libvmiLock, lockStatistics);
             if (vmi_read(vmiInstance, &accessContext, sizeof(T), exctractedValue.get(), nullptr) != VMI_SUCCESS)
             {
                 throw VmiException(fmt::format("{}: Unable to read {} bytes from VA {:#x} with cr3 {:#x}",
@@ -157,23 +211,103 @@ namespace VmiCore
         [[nodiscard]] std::tuple<addr_t, std::size_t, std::size_t>
         getBitfieldOffsetAndSizeFromJson(const std::string& structName, const std::string& structMember) override;
 
+      protected:
+        /**
+         * Creates the libvmi instance for the given domain and caches guest properties that never change afterwards.
+         */
+        void initializeInstance(const std::string& domain, uint64_t initFlags, vmi_init_data_t* initData);
+
+        /**
+         * Single point through which all reads of guest memory pass. Expects libvmiLock to be held by the caller.
+         */
+        [[nodiscard]] virtual bool readGuestMemory(access_context_t& accessContext, std::size_t size, void* buffer);
+
       private:
+        // Guest strings exceeding this length are considered to be unterminated
+        static constexpr std::size_t maxStringLength = 0x10000;
+
         uint numberOfVCPUs{};
         std::shared_ptr<IConfigParser> configInterface;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<IEventStream> eventStream;
         vmi_instance_t vmiInstance{};
+        OperatingSystem osType = OperatingSystem::INVALID;
+        uint16_t windowsBuild{};
+        uint8_t addressWidth{};
+        // libvmi caches are not thread safe, hence every operation reaching libvmi has to be serialized
         std::mutex libvmiLock{};
         std::mutex eventsListenLock{};
+        LockStatistics lockStatistics{};
+        // Profile lookups never change after initialization and are served from these caches without libvmiLock
+        std::shared_mutex lookupCacheLock{};
+        std::unordered_map<std::string, addr_t> offsetCache{};
+        std::map<std::pair<std::string, std::string>, addr_t> kernelStructOffsetCache{};
+        std::unordered_map<std::string, std::size_t> structSizeCache{};
+        std::map<std::pair<std::string, std::string>, std::tuple<addr_t, std::size_t, std::size_t>> bitfieldCache{};
+        // Translations handed out by convertVAToPA, invalidated together with the libvmi v2p cache
+        TranslationCache translationCache{};
+        // Reused for all guest string reads, guarded by libvmiLock
+        std::vector<uint8_t> stringBuffer{};
+        // Event recording state, guarded by libvmiLock
+        std::unique_ptr<EventTraceWriter> eventTraceWriter{};
+        std::unordered_map<vmi_event_t*, event_callback_t> recordedCallbacks{};
+        EventRecorder eventRecorder{[this](addr_t dtb, addr_t pageAddress, std::span<uint8_t> content)
+                                    { return readRecordedPage(dtb, pageAddress, content); }};
 
         [[nodiscard]] static std::unique_ptr<std::string> createConfigString(const std::string& offsetsFile);
 
         static void freeEvent(vmi_event_t* event, status_t rc);
 
+        static event_response_t recordingCallback(vmi_instance_t vmi, vmi_event_t* event);
+
+        // Forwards the event to its original callback and records it together with the guest pages the
+        // handling thread accesses meanwhile
+        event_response_t recordEvent(vmi_instance_t vmi, vmi_event_t* event);
+
+        // Expects libvmiLock to be held by the caller
+        bool readRecordedPage(addr_t dtb, addr_t pageAddress, std::span<uint8_t> content);
+
+        [[nodiscard]] static OperatingSystem toOperatingSystem(os_t libvmiOsType);
+
+        template <typename Cache, typename Key, typename Resolver>
+        typename Cache::mapped_type lookupCached(Cache& cache, const Key& key, Resolver resolve)
+        {
+            {
+                std::shared_lock lock(lookupCacheLock);
+                if (auto entry = cache.find(key); entry != cache.end())
+                {
+                    return entry->second;
+                }
+            }
+
+            auto value = resolve();
+            std::unique_lock lock(lookupCacheLock);
+            cache.try_emplace(key, value);
+            return value;
+        }
+
+        void logLockStatistics() const;
+
+        void logTranslationCacheStatistics() const;
+
         [[nodiscard]] static access_context_t createPhysicalAddressAccessContext(addr_t physicalAddress);
 
         [[nodiscard]] static access_context_t createVirtualAddressAccessContext(addr_t virtualAddress, addr_t cr3);
 
+        // Expects libvmiLock to be held by the caller. Large pages are mapped by their physical address if given.
+        [[nodiscard]] std::optional<mapped_regions_t>
+        mmapGuestChunk(addr_t baseVA, addr_t dtb, std::optional<addr_t> basePA, std::size_t numberOfPages);
+
+        // Expects libvmiLock to be held by the caller
+        [[nodiscard]] std::optional<std::size_t> readTerminatedString(addr_t virtualAddress,
+                                                                      addr_t cr3,
+                                                                      std::size_t characterSize);
+
+        // Expects libvmiLock to be held by the caller
+        [[nodiscard]] bool readBatchGroup(std::span<BatchReadEntry> entries,
+                                          std::span<const std::size_t> group,
+                                          std::vector<uint8_t>& groupBuffer);
+
         void flushV2PCache(addr_t pt) override;
 
         void flushPageCache() override;
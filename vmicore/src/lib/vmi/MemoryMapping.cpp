@@ -1,23 +1,23 @@
 #include "MemoryMapping.h"
 #include <vmicore/filename.h>
 
-// Currently implemented in GNU libstdc++ but missing in LLVM libc++.
-#ifdef __cpp_lib_is_layout_compatible
-#include <type_traits>
-
-static_assert(std::is_layout_compatible_v<mapped_region, VmiCore::MappedRegion>,
-              "Layout of libvmi mapped_region not compatible with VmiCore MappedRegion");
-#endif
-
 namespace VmiCore
 {
     MemoryMapping::MemoryMapping(const std::shared_ptr<ILogging>& logging,
                                  std::shared_ptr<ILibvmiInterface> vmiInterface,
-                                 mapped_regions_t mappedRegions)
+                                 std::vector<mapped_regions_t> mappedRegions)
         : logger(logging->newNamedLogger(FILENAME_STEM)),
           vmiInterface(std::move(vmiInterface)),
-          libvmiMappings(mappedRegions)
+          libvmiMappings(std::move(mappedRegions))
     {
+        // A region may have been mapped in several chunks, e.g. because parts of it are backed by large pages
+        for (const auto& chunk : libvmiMappings)
+        {
+            for (const auto& region : std::span(chunk.regions, chunk.size))
+            {
+                this->mappedRegions.emplace_back(region.start_va, region.num_pages, region.access_ptr);
+            }
+        }
     }
 
     MemoryMapping::~MemoryMapping()
@@ -35,14 +35,17 @@ namespace VmiCore
             throw MemoryMappingError("Cannot retrieve mappings for regions that have already been unmapped");
         }
 
-        return {std::bit_cast<MappedRegion*>(libvmiMappings.regions), libvmiMappings.size};
+        return mappedRegions;
     }
 
     void MemoryMapping::unmap()
     {
         if (isMapped)
         {
-            vmiInterface->freeMappedRegions(libvmiMappings);
+            for (const auto& chunk : libvmiMappings)
+            {
+                vmiInterface->freeMappedRegions(chunk);
+            }
 
             isMapped = false;
         }
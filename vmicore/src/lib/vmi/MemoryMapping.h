@@ -3,6 +3,7 @@
 
 #include "../io/ILogging.h"
 #include "LibvmiInterface.h"
+#include <vector>
 #include <vmicore/vmi/IMemoryMapping.h>
 
 namespace VmiCore
@@ -12,7 +13,7 @@ namespace VmiCore
       public:
         MemoryMapping(const std::shared_ptr<ILogging>& logging,
                       std::shared_ptr<ILibvmiInterface> vmiInterface,
-                      mapped_regions_t mappedRegions);
+                      std::vector<mapped_regions_t> mappedRegions);
 
         ~MemoryMapping() override;
 
@@ -31,7 +32,8 @@ namespace VmiCore
       private:
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<ILibvmiInterface> vmiInterface;
-        mapped_regions_t libvmiMappings;
+        std::vector<mapped_regions_t> libvmiMappings;
+        std::vector<MappedRegion> mappedRegions;
         bool isMapped = true;
     };
 }
@@ -0,0 +1,140 @@
+#include "MemoryMappingPool.h"
+#include <vmicore/filename.h>
+#include <vmicore/os/PagingDefinitions.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        /**
+         * Handle to a mapping that may be shared with the pool and other handles.
+         */
+        class PooledMemoryMapping final : public IMemoryMapping
+        {
+          public:
+            explicit PooledMemoryMapping(std::shared_ptr<MemoryMapping> mapping) : mapping(std::move(mapping)) {}
+
+            [[nodiscard]] std::span<const MappedRegion> getMappedRegions() const override
+            {
+                if (!mapping)
+                {
+                    throw MemoryMappingError("Cannot retrieve mappings for regions that have already been unmapped");
+                }
+
+                return mapping->getMappedRegions();
+            }
+
+            void unmap() override
+            {
+                mapping.reset();
+            }
+
+          private:
+            std::shared_ptr<MemoryMapping> mapping;
+        };
+    }
+
+    MemoryMappingPool::MemoryMappingPool(const std::shared_ptr<ILogging>& logging,
+                                         std::shared_ptr<ILibvmiInterface> vmiInterface,
+                                         std::size_t budgetInBytes)
+        : logging(logging),
+          logger(logging->newNamedLogger(FILENAME_STEM)),
+          vmiInterface(std::move(vmiInterface)),
+          budgetInBytes(budgetInBytes)
+    {
+    }
+
+    MemoryMappingPool::~MemoryMappingPool()
+    {
+        if (hits + misses > 0)
+        {
+            logger->info("Mapping pool statistics", {{"hits", hits}, {"misses", misses}});
+        }
+    }
+
+    std::size_t MemoryMappingPool::RegionKeyHash::operator()(const RegionKey& key) const
+    {
+        // Base addresses are page aligned, hence the lower bits are free to distinguish address spaces and sizes
+        return std::hash<addr_t>{}(key.baseVA ^ (key.dtb >> PagingDefinitions::numberOfPageIndexBits) ^
+                                   (key.numberOfPages << (2 * PagingDefinitions::numberOfPageIndexBits)));
+    }
+
+    std::size_t MemoryMappingPool::getSizeInBytes(const RegionKey& key)
+    {
+        return key.numberOfPages * PagingDefinitions::pageSizeInBytes;
+    }
+
+    std::unique_ptr<IMemoryMapping> MemoryMappingPool::map(addr_t baseVA, addr_t dtb, std::size_t numberOfPages)
+    {
+        const RegionKey key{.dtb = dtb, .baseVA = baseVA, .numberOfPages = numberOfPages};
+        if (getSizeInBytes(key) > budgetInBytes)
+        {
+            return std::make_unique<MemoryMapping>(
+                logging, vmiInterface, vmiInterface->mmapGuest(baseVA, dtb, numberOfPages));
+        }
+
+        {
+            std::scoped_lock lock(poolLock);
+            if (auto entry = mappingsByRegion.find(key); entry != mappingsByRegion.end())
+            {
+                hits++;
+                lruMappings.splice(lruMappings.begin(), lruMappings, entry->second);
+                return std::make_unique<PooledMemoryMapping>(entry->second->second);
+            }
+            misses++;
+        }
+
+        // Mapping is expensive, so it is done without blocking other lookups
+        auto mapping =
+            std::make_shared<MemoryMapping>(logging, vmiInterface, vmiInterface->mmapGuest(baseVA, dtb, numberOfPages));
+
+        LruList evictedMappings;
+        std::scoped_lock lock(poolLock);
+        if (auto entry = mappingsByRegion.find(key); entry != mappingsByRegion.end())
+        {
+            // The same region has been mapped concurrently, so our own mapping is simply released again
+            evictedMappings.emplace_back(key, std::move(mapping));
+            return std::make_unique<PooledMemoryMapping>(entry->second->second);
+        }
+
+        while (pooledBytes + getSizeInBytes(key) > budgetInBytes)
+        {
+            evict(std::prev(lruMappings.end()), evictedMappings);
+        }
+        lruMappings.emplace_front(key, mapping);
+        mappingsByRegion.emplace(key, lruMappings.begin());
+        pooledBytes += getSizeInBytes(key);
+
+        return std::make_unique<PooledMemoryMapping>(std::move(mapping));
+    }
+
+    void MemoryMappingPool::invalidateDtb(addr_t dtb)
+    {
+        LruList evictedMappings;
+        std::scoped_lock lock(poolLock);
+        for (auto entry = lruMappings.begin(); entry != lruMappings.end();)
+        {
+            auto current = entry++;
+            if (current->first.dtb == dtb)
+            {
+                evict(current, evictedMappings);
+            }
+        }
+    }
+
+    void MemoryMappingPool::clear()
+    {
+        LruList evictedMappings;
+        std::scoped_lock lock(poolLock);
+        evictedMappings.splice(evictedMappings.end(), lruMappings);
+        mappingsByRegion.clear();
+        pooledBytes = 0;
+    }
+
+    void MemoryMappingPool::evict(LruList::iterator entry, LruList& evictedMappings)
+    {
+        mappingsByRegion.erase(entry->first);
+        pooledBytes -= getSizeInBytes(entry->first);
+        evictedMappings.splice(evictedMappings.end(), lruMappings, entry);
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef VMICORE_MEMORYMAPPINGPOOL_H
+#define VMICORE_MEMORYMAPPINGPOOL_H
+
+#include "../io/ILogging.h"
+#include "LibvmiInterface.h"
+#include "MemoryMapping.h"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vmicore/io/ILogger.h>
+#include <vmicore/types.h>
+#include <vmicore/vmi/IMemoryMapping.h>
+
+namespace VmiCore
+{
+    class IMemoryMappingPool
+    {
+      public:
+        virtual ~IMemoryMappingPool() = default;
+
+        /**
+         * Returns a mapping of the given region. Mappings of a previous request for the exact same region are handed
+         * out again as long as they have not been evicted. Unmapping the returned handle only releases its reference,
+         * the region itself is unmapped as soon as neither the pool nor any other handle refers to it anymore.
+         */
+        [[nodiscard]] virtual std::unique_ptr<IMemoryMapping>
+        map(addr_t baseVA, addr_t dtb, std::size_t numberOfPages) = 0;
+
+        /**
+         * Evicts all mappings of the given address space, e.g. because the owning process has terminated.
+         */
+        virtual void invalidateDtb(addr_t dtb) = 0;
+
+        virtual void clear() = 0;
+
+      protected:
+        IMemoryMappingPool() = default;
+    };
+
+    /**
+     * Keeps recently used mappings alive up to a budget of mapped bytes and evicts the least recently used ones
+     * beyond that. A budget of zero disables pooling. Note that a pooled mapping reflects the page tables at the time
+     * it has been created, so pages that are swapped in afterwards are only visible once the mapping has been evicted.
+     */
+    class MemoryMappingPool final : public IMemoryMappingPool
+    {
+      public:
+        MemoryMappingPool(const std::shared_ptr<ILogging>& logging,
+                          std::shared_ptr<ILibvmiInterface> vmiInterface,
+                          std::size_t budgetInBytes);
+
+        ~MemoryMappingPool() override;
+
+        MemoryMappingPool(const MemoryMappingPool&) = delete;
+
+        MemoryMappingPool(const MemoryMappingPool&&) = delete;
+
+        MemoryMappingPool& operator=(const MemoryMappingPool&) = delete;
+
+        MemoryMappingPool& operator=(const MemoryMappingPool&&) = delete;
+
+        [[nodiscard]] std::unique_ptr<IMemoryMapping>
+        map(addr_t baseVA, addr_t dtb, std::size_t numberOfPages) override;
+
+        void invalidateDtb(addr_t dtb) override;
+
+        void clear() override;
+
+      private:
+        struct RegionKey
+        {
+            addr_t dtb;
+            addr_t baseVA;
+            std::size_t numberOfPages;
+
+            bool operator==(const RegionKey&) const = default;
+        };
+
+        struct RegionKeyHash
+        {
+            std::size_t operator()(const RegionKey& key) const;
+        };
+
+        using LruList = std::list<std::pair<RegionKey, std::shared_ptr<MemoryMapping>>>;
+
+        std::shared_ptr<ILogging> logging;
+        std::unique_ptr<ILogger> logger;
+        std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::size_t budgetInBytes;
+        std::mutex poolLock{};
+        // Most recently used mappings are kept at the front
+        LruList lruMappings{};
+        std::unordered_map<RegionKey, LruList::iterator, RegionKeyHash> mappingsByRegion{};
+        std::size_t pooledBytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+
+        [[nodiscard]] static std::size_t getSizeInBytes(const RegionKey& key);
+
+        // Expects poolLock to be held by the caller. Evicted mappings are moved to the given list, so that they can be
+        // unmapped after the lock has been released.
+        void evict(LruList::iterator entry, LruList& evictedMappings);
+    };
+}
+
+#endif // VMICORE_MEMORYMAPPINGPOOL_H
@@ -0,0 +1,65 @@
+#include "OfflineLibvmiInterface.h"
+#include "../GlobalControl.h"
+#include <cstdlib>
+#include <vmicore/filename.h>
+
+namespace VmiCore
+{
+    OfflineLibvmiInterface::OfflineLibvmiInterface(std::shared_ptr<IConfigParser> configInterface,
+                                                   std::shared_ptr<ILogging> loggingLib,
+                                                   std::shared_ptr<IEventStream> eventStream)
+        : LibvmiInterface(configInterface, loggingLib, std::move(eventStream)),
+          configInterface(std::move(configInterface)),
+          logger(loggingLib->newNamedLogger(FILENAME_STEM))
+    {
+    }
+
+    void OfflineLibvmiInterface::initializeVmi()
+    {
+        logger->info("Initialize libvmi from memory dump", {{"path", configInterface->getMemoryDumpPath().string()}});
+
+        // Libvmi selects its file driver for any domain name that refers to an existing file
+        initializeInstance(configInterface->getMemoryDumpPath().string(), VMI_INIT_DOMAINNAME, nullptr);
+    }
+
+    void OfflineLibvmiInterface::clearEvent(vmi_event_t& event, bool deallocate)
+    {
+        // Events are never registered with libvmi, so only their memory has to be released
+        if (deallocate)
+        {
+            free(&event); // NOLINT(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+        }
+    }
+
+    void OfflineLibvmiInterface::write8PA(addr_t physicalAddress, uint8_t value)
+    {
+        logger->debug("Discard write to memory dump",
+                      {{"PA", fmt::format("{:#x}", physicalAddress)}, {"value", fmt::format("{:#x}", value)}});
+    }
+
+    void OfflineLibvmiInterface::eventsListen([[maybe_unused]] uint32_t timeout)
+    {
+        GlobalControl::requestShutdown();
+    }
+
+    void OfflineLibvmiInterface::registerEvent([[maybe_unused]] vmi_event_t& event) {}
+
+    void OfflineLibvmiInterface::setMemAccess([[maybe_unused]] std::span<const addr_t> gfns,
+                                              [[maybe_unused]] vmi_mem_access_t access)
+    {
+    }
+
+    void OfflineLibvmiInterface::pauseVm() {}
+
+    void OfflineLibvmiInterface::resumeVm() {}
+
+    bool OfflineLibvmiInterface::areEventsPending()
+    {
+        return false;
+    }
+
+    void OfflineLibvmiInterface::stopSingleStepForVcpu([[maybe_unused]] vmi_event_t* event,
+                                                       [[maybe_unused]] uint vcpuId)
+    {
+    }
+}
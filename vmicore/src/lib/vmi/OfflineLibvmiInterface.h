@@ -0,0 +1,47 @@
+#ifndef VMICORE_OFFLINELIBVMIINTERFACE_H
+#define VMICORE_OFFLINELIBVMIINTERFACE_H
+
+#include "LibvmiInterface.h"
+
+namespace VmiCore
+{
+    /**
+     * Introspects a raw physical memory dump instead of a running VM. Symbols and structure offsets are resolved
+     * with the regular offsets file, hence plugins can be run against a dump without any changes. As a dump never
+     * produces events, the analysis ends right after all plugins have been initialized, which leaves their final
+     * scans to run on the unchanged memory image. Writes are discarded in order to keep the dump intact.
+     */
+    class OfflineLibvmiInterface : public LibvmiInterface
+    {
+      public:
+        OfflineLibvmiInterface(std::shared_ptr<IConfigParser> configInterface,
+                               std::shared_ptr<ILogging> loggingLib,
+                               std::shared_ptr<IEventStream> eventStream);
+
+        void initializeVmi() override;
+
+        void clearEvent(vmi_event_t& event, bool deallocate) override;
+
+        void write8PA(addr_t physicalAddress, uint8_t value) override;
+
+        void eventsListen(uint32_t timeout) override;
+
+        void registerEvent(vmi_event_t& event) override;
+
+        void setMemAccess(std::span<const addr_t> gfns, vmi_mem_access_t access) override;
+
+        void pauseVm() override;
+
+        void resumeVm() override;
+
+        [[nodiscard]] bool areEventsPending() override;
+
+        void stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId) override;
+
+      private:
+        std::shared_ptr<IConfigParser> configInterface;
+        std::unique_ptr<ILogger> logger;
+    };
+}
+
+#endif // VMICORE_OFFLINELIBVMIINTERFACE_H
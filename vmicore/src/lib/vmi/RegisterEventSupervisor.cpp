@@ -1,4 +1,5 @@
 #include "RegisterEventSupervisor.h"
+#include "../GlobalControl.h"
 #include <bit>
 #include <source_location>
 #include <vmicore/filename.h>
@@ -14,10 +15,7 @@ namespace VmiCore
 
     void RegisterEventSupervisor::teardown()
     {
-        if (contextSwitchEvent)
-        {
-            vmiInterface->clearEvent(*contextSwitchEvent, false);
-        }
+        disableContextSwitchEvent();
     }
 
     void RegisterEventSupervisor::setContextSwitchCallback(const std::function<void(vmi_event_t*)>& eventCallback)
@@ -29,12 +27,42 @@ namespace VmiCore
         }
         callback = eventCallback;
         initializeRegisterEvent();
+    }
+
+    void RegisterEventSupervisor::enableContextSwitchEvent()
+    {
+        if (contextSwitchEventEnabled)
+        {
+            return;
+        }
+        if (!contextSwitchEvent)
+        {
+            throw VmiException(fmt::format("{}: No context switch callback has been set.", __func__));
+        }
         vmiInterface->registerEvent(*contextSwitchEvent);
+        contextSwitchEventEnabled = true;
+    }
+
+    void RegisterEventSupervisor::disableContextSwitchEvent()
+    {
+        if (!contextSwitchEventEnabled)
+        {
+            return;
+        }
+        vmiInterface->clearEvent(*contextSwitchEvent, false);
+        contextSwitchEventEnabled = false;
+    }
+
+    bool RegisterEventSupervisor::isContextSwitchEventEnabled() const
+    {
+        return contextSwitchEventEnabled;
     }
 
     event_response_t RegisterEventSupervisor::_defaultRegisterCallback([[maybe_unused]] vmi_instance_t vmi,
                                                                        vmi_event_t* event)
     {
+        static auto& callbackLatency = GlobalControl::latencyHistograms().get("callback.register");
+        ScopedLatency measurement(callbackLatency);
         return std::bit_cast<RegisterEventSupervisor*>(event->data)->registerCallback(event);
     }
 
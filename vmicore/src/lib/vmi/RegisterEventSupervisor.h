@@ -16,8 +16,18 @@ namespace VmiCore
 
         virtual void teardown() = 0;
 
+        /**
+         * Sets the callback for CR3 writes. The event itself is only registered with libvmi while enabled, because
+         * every context switch of the guest causes a VM exit otherwise.
+         */
         virtual void setContextSwitchCallback(const std::function<void(vmi_event_t*)>& eventCallback) = 0;
 
+        virtual void enableContextSwitchEvent() = 0;
+
+        virtual void disableContextSwitchEvent() = 0;
+
+        [[nodiscard]] virtual bool isContextSwitchEventEnabled() const = 0;
+
       protected:
         IRegisterEventSupervisor() = default;
     };
@@ -36,12 +46,19 @@ namespace VmiCore
 
         void setContextSwitchCallback(const std::function<void(vmi_event_t*)>& eventCallback) override;
 
+        void enableContextSwitchEvent() override;
+
+        void disableContextSwitchEvent() override;
+
+        [[nodiscard]] bool isContextSwitchEventEnabled() const override;
+
         static event_response_t _defaultRegisterCallback([[maybe_unused]] vmi_instance_t vmi, vmi_event_t* event);
 
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::unique_ptr<vmi_event_t> contextSwitchEvent;
         std::function<void(vmi_event_t*)> callback{};
+        bool contextSwitchEventEnabled = false;
         std::unique_ptr<ILogger> logger;
 
         event_response_t registerCallback(vmi_event_t* event) const;
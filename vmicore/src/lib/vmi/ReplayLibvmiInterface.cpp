@@ -0,0 +1,244 @@
+#include "ReplayLibvmiInterface.h"
+#include "../GlobalControl.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fmt/core.h>
+#include <span>
+#include <string_view>
+#include <vmicore/filename.h>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore/vmi/VmiException.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        std::string_view eventTypeName(vmi_event_type_t type)
+        {
+            switch (type)
+            {
+                case VMI_EVENT_INTERRUPT:
+                    return "interrupt";
+                case VMI_EVENT_SINGLESTEP:
+                    return "singlestep";
+                case VMI_EVENT_MEMORY:
+                    return "memory";
+                case VMI_EVENT_REGISTER:
+                    return "register";
+                default:
+                    return "other";
+            }
+        }
+
+        uint64_t elapsedNs(std::chrono::steady_clock::time_point start)
+        {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    ReplayLibvmiInterface::ReplayLibvmiInterface(std::shared_ptr<IConfigParser> configInterface,
+                                                 std::shared_ptr<ILogging> loggingLib,
+                                                 std::shared_ptr<IEventStream> eventStream)
+        : OfflineLibvmiInterface(configInterface, loggingLib, std::move(eventStream)),
+          configInterface(std::move(configInterface)),
+          logger(loggingLib->newNamedLogger(FILENAME_STEM))
+    {
+    }
+
+    void ReplayLibvmiInterface::initializeVmi()
+    {
+        if (configInterface->getMemoryDumpPath().empty())
+        {
+            throw VmiException(fmt::format(
+                "{}: Replaying events requires a memory dump taken at the start of the recording", __func__));
+        }
+        OfflineLibvmiInterface::initializeVmi();
+    }
+
+    void ReplayLibvmiInterface::registerEvent(vmi_event_t& event)
+    {
+        switch (event.type)
+        {
+            case VMI_EVENT_INTERRUPT:
+                interruptEvent = &event;
+                break;
+            case VMI_EVENT_REGISTER:
+                registerAccessEvent = &event;
+                break;
+            case VMI_EVENT_SINGLESTEP:
+                for (uint32_t vcpuId = 0; vcpuId < sizeof(event.ss_event.vcpus) * 8; vcpuId++)
+                {
+                    if ((event.ss_event.vcpus & (1U << vcpuId)) != 0)
+                    {
+                        singleStepEvents[vcpuId] = &event;
+                    }
+                }
+                break;
+            case VMI_EVENT_MEMORY:
+                if (event.mem_event.generic)
+                {
+                    genericMemoryEvent = &event;
+                    break;
+                }
+                memoryEvents[event.mem_event.gfn] = &event;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void ReplayLibvmiInterface::clearEvent(vmi_event_t& event, bool deallocate)
+    {
+        if (interruptEvent == &event)
+        {
+            interruptEvent = nullptr;
+        }
+        if (registerAccessEvent == &event)
+        {
+            registerAccessEvent = nullptr;
+        }
+        if (genericMemoryEvent == &event)
+        {
+            genericMemoryEvent = nullptr;
+        }
+        std::erase_if(singleStepEvents, [&event](const auto& entry) { return entry.second == &event; });
+        std::erase_if(memoryEvents, [&event](const auto& entry) { return entry.second == &event; });
+        OfflineLibvmiInterface::clearEvent(event, deallocate);
+    }
+
+    void ReplayLibvmiInterface::setMemAccess(std::span<const addr_t> gfns, vmi_mem_access_t access)
+    {
+        for (auto gfn : gfns)
+        {
+            if (access == VMI_MEMACCESS_N)
+            {
+                restrictedGfns.erase(gfn);
+            }
+            else
+            {
+                restrictedGfns.insert(gfn);
+            }
+        }
+    }
+
+    void ReplayLibvmiInterface::stopSingleStepForVcpu([[maybe_unused]] vmi_event_t* event, uint vcpuId)
+    {
+        singleStepEvents.erase(vcpuId);
+    }
+
+    vmi_event_t* ReplayLibvmiInterface::findRegisteredEvent(const EventTraceRecord& record) const
+    {
+        switch (record.type)
+        {
+            case VMI_EVENT_INTERRUPT:
+                return interruptEvent;
+            case VMI_EVENT_REGISTER:
+                return registerAccessEvent;
+            case VMI_EVENT_SINGLESTEP:
+                if (auto event = singleStepEvents.find(record.vcpuId); event != singleStepEvents.end())
+                {
+                    return event->second;
+                }
+                return nullptr;
+            case VMI_EVENT_MEMORY:
+                if (auto event = memoryEvents.find(record.gfn); event != memoryEvents.end())
+                {
+                    return event->second;
+                }
+                return restrictedGfns.contains(record.gfn) ? genericMemoryEvent : nullptr;
+            default:
+                return nullptr;
+        }
+    }
+
+    void ReplayLibvmiInterface::eventsListen([[maybe_unused]] uint32_t timeout)
+    {
+        logger->info("Replay events", {{"path", configInterface->getEventReplayPath().string()}});
+
+        EventTraceReader reader(configInterface->getEventReplayPath());
+        uint64_t skippedEvents = 0;
+        auto replayStart = std::chrono::steady_clock::now();
+        while (auto record = reader.next())
+        {
+            auto* event = findRegisteredEvent(*record);
+            if (event == nullptr || event->callback == nullptr)
+            {
+                // The recorded event has no counterpart, e.g. because a plugin behaved differently during the replay
+                skippedEvents++;
+                continue;
+            }
+            replay(*record, *event);
+        }
+        replayedPages.clear();
+
+        logStatistics(skippedEvents, elapsedNs(replayStart));
+        GlobalControl::requestShutdown();
+    }
+
+    void ReplayLibvmiInterface::replay(EventTraceRecord& record, vmi_event_t& event)
+    {
+        replayedPages.clear();
+        for (const auto& page : record.pages)
+        {
+            replayedPages.emplace(std::pair(page.dtb, page.pageAddress), &page.content);
+        }
+        record.applyTo(event);
+
+        auto callbackStart = std::chrono::steady_clock::now();
+        // The event must not be accessed afterwards, as the callback is free to clear and deallocate it
+        event.callback(nullptr, &event);
+        auto latencyNs = elapsedNs(callbackStart);
+
+        auto& typeStatistics = statistics[record.type];
+        typeStatistics.events++;
+        typeStatistics.totalLatencyNs += latencyNs;
+        typeStatistics.maxLatencyNs = std::max(typeStatistics.maxLatencyNs, latencyNs);
+    }
+
+    bool ReplayLibvmiInterface::readGuestMemory(access_context_t& accessContext, std::size_t size, void* buffer)
+    {
+        auto dtb = accessContext.translate_mechanism == VMI_TM_NONE ? 0 : accessContext.page_table;
+        auto* destination = static_cast<uint8_t*>(buffer);
+        auto address = accessContext.addr;
+        auto remaining = size;
+        while (remaining > 0)
+        {
+            auto page = replayedPages.find({dtb, address & PagingDefinitions::stripPageOffsetMask});
+            if (page == replayedPages.end())
+            {
+                // Pages that have not been read during the recorded callback are taken from the dump
+                return OfflineLibvmiInterface::readGuestMemory(accessContext, size, buffer);
+            }
+            auto pageOffset = address & PagingDefinitions::pageOffsetMask;
+            auto chunkSize = std::min(remaining, PagingDefinitions::pageSizeInBytes - pageOffset);
+            std::memcpy(destination, std::span(*page->second).subspan(pageOffset).data(), chunkSize);
+            destination += chunkSize; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            address += chunkSize;
+            remaining -= chunkSize;
+        }
+        return true;
+    }
+
+    void ReplayLibvmiInterface::logStatistics(uint64_t skippedEvents, uint64_t durationNs) const
+    {
+        uint64_t replayedEvents = 0;
+        for (const auto& [type, typeStatistics] : statistics)
+        {
+            replayedEvents += typeStatistics.events;
+            logger->info("Replay latency",
+                         {{"type", eventTypeName(type)},
+                          {"events", typeStatistics.events},
+                          {"meanLatencyNs", typeStatistics.totalLatencyNs / typeStatistics.events},
+                          {"maxLatencyNs", typeStatistics.maxLatencyNs}});
+        }
+        auto durationSeconds = static_cast<double>(durationNs) / 1e9;
+        logger->info("Replay finished",
+                     {{"events", replayedEvents},
+                      {"skippedEvents", skippedEvents},
+                      {"durationNs", durationNs},
+                      {"eventsPerSecond",
+                       durationSeconds > 0 ? static_cast<double>(replayedEvents) / durationSeconds : 0.0}});
+    }
+}
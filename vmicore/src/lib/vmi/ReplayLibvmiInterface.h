@@ -0,0 +1,71 @@
+#ifndef VMICORE_REPLAYLIBVMIINTERFACE_H
+#define VMICORE_REPLAYLIBVMIINTERFACE_H
+
+#include "EventTrace.h"
+#include "OfflineLibvmiInterface.h"
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace VmiCore
+{
+    /**
+     * Feeds a recorded event trace back through the registered callbacks as fast as possible. Plugins and supervisors
+     * are initialized from a memory dump taken at the start of the recording, while reads during a replayed callback
+     * are served from the pages captured with the event. Translations and mappings of guest memory are always
+     * resolved against the dump. Throughput and per-callback latencies are logged once the trace has been replayed.
+     */
+    class ReplayLibvmiInterface final : public OfflineLibvmiInterface
+    {
+      public:
+        ReplayLibvmiInterface(std::shared_ptr<IConfigParser> configInterface,
+                              std::shared_ptr<ILogging> loggingLib,
+                              std::shared_ptr<IEventStream> eventStream);
+
+        void initializeVmi() override;
+
+        void clearEvent(vmi_event_t& event, bool deallocate) override;
+
+        void eventsListen(uint32_t timeout) override;
+
+        void registerEvent(vmi_event_t& event) override;
+
+        void setMemAccess(std::span<const addr_t> gfns, vmi_mem_access_t access) override;
+
+        void stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId) override;
+
+      protected:
+        [[nodiscard]] bool readGuestMemory(access_context_t& accessContext, std::size_t size, void* buffer) override;
+
+      private:
+        struct ReplayStatistics
+        {
+            uint64_t events = 0;
+            uint64_t totalLatencyNs = 0;
+            uint64_t maxLatencyNs = 0;
+        };
+
+        std::shared_ptr<IConfigParser> configInterface;
+        std::unique_ptr<ILogger> logger;
+        vmi_event_t* interruptEvent = nullptr;
+        vmi_event_t* registerAccessEvent = nullptr;
+        std::unordered_map<uint32_t, vmi_event_t*> singleStepEvents{};
+        std::unordered_map<addr_t, vmi_event_t*> memoryEvents{};
+        // Receives violations of all frames whose access permissions have been restricted
+        vmi_event_t* genericMemoryEvent = nullptr;
+        std::unordered_set<addr_t> restrictedGfns{};
+        // Pages captured with the event that is currently replayed, keyed by dtb and page address
+        std::map<std::pair<addr_t, addr_t>, const std::vector<uint8_t>*> replayedPages{};
+        std::map<vmi_event_type_t, ReplayStatistics> statistics{};
+
+        [[nodiscard]] vmi_event_t* findRegisteredEvent(const EventTraceRecord& record) const;
+
+        void replay(EventTraceRecord& record, vmi_event_t& event);
+
+        void logStatistics(uint64_t skippedEvents, uint64_t durationNs) const;
+    };
+}
+
+#endif // VMICORE_REPLAYLIBVMIINTERFACE_H
@@ -1,6 +1,5 @@
 #include "SingleStepSupervisor.h"
 #include "../GlobalControl.h"
-#include <cmath>
 #include <vmicore/filename.h>
 #include <vmicore/vmi/VmiException.h>
 
@@ -34,73 +33,84 @@ namespace VmiCore
     {
         auto numberOfVCPUs = vmiInterface->getNumberOfVCPUs();
         SingleStepSupervisor::logger->debug("initialize callbacks", {{"vcpus", static_cast<uint64_t>(numberOfVCPUs)}});
-        singleStepEvents = std::vector<vmi_event_t>(numberOfVCPUs);
-        callbacks = std::vector<std::function<void(vmi_event_t*)>>(numberOfVCPUs);
+        slots = std::vector<SingleStepSlot>(numberOfVCPUs);
+        for (auto& slot : slots)
+        {
+            // Only the vCPU mask has to be set again before each registration, as libvmi clears it when stopping
+            SETUP_SINGLESTEP_EVENT(&slot.event, 0, _defaultSingleStepCallback, true);
+        }
     }
 
     void SingleStepSupervisor::teardown()
     {
-        for (auto& event : singleStepEvents)
+        for (std::size_t vcpuId = 0; vcpuId < slots.size(); vcpuId++)
         {
-            if (event.ss_event.enable)
+            auto& slot = slots[vcpuId];
+            if (slot.requestCount == 0)
+            {
+                continue;
+            }
+            slot.requestCount = 0;
+            try
             {
-                auto vcpu_index = static_cast<uint32_t>(log2(event.ss_event.vcpus));
-                callbacks[vcpu_index] = nullptr;
-                event.callback = nullptr;
-                try
-                {
-                    vmiInterface->stopSingleStepForVcpu(&event, vcpu_index);
-                }
-                catch (const VmiException& e)
-                {
-                    SingleStepSupervisor::logger->error("Unable to clear single step event during teardown",
-                                                        {{"exception", e.what()}});
-                }
-                event.ss_event.enable = false;
+                vmiInterface->stopSingleStepForVcpu(&slot.event, static_cast<uint>(vcpuId));
+            }
+            catch (const VmiException& e)
+            {
+                SingleStepSupervisor::logger->error("Unable to clear single step event during teardown",
+                                                    {{"exception", e.what()}});
             }
         }
     }
 
     event_response_t SingleStepSupervisor::singleStepCallback(vmi_event_t* event)
     {
-        try
+        auto& slot = slots[event->vcpu_id];
+        if (slot.requestCount == 0)
         {
-            callbacks[event->vcpu_id](event);
+            throw VmiException(
+                fmt::format("{}: No single step has been requested for the current VCPU. VCPU_ID = {}",
+                            __func__,
+                            event->vcpu_id));
         }
-        catch (const std::runtime_error& e)
+        auto request = slot.requests[slot.firstRequest];
+        slot.firstRequest = (slot.firstRequest + 1) % maxQueuedRequests;
+        slot.requestCount--;
+
+        // Queued requests are served by the following steps, hence the vCPU keeps single stepping until the last one
+        if (slot.requestCount == 0)
         {
-            throw VmiException(fmt::format(
-                "{}: Callback target for the current single step event does not exist anymore. VCPU_ID = {}",
-                __func__,
-                event->vcpu_id));
+            vmiInterface->stopSingleStepForVcpu(event, event->vcpu_id);
         }
-        callbacks[event->vcpu_id] = nullptr;
-        event->callback = nullptr;
-        vmiInterface->stopSingleStepForVcpu(event, event->vcpu_id);
-        event->ss_event.enable = false;
+        event->data = reinterpret_cast<void*>(request.data);
+        request.callback(event);
         return VMI_EVENT_RESPONSE_NONE;
     }
 
-    void SingleStepSupervisor::setSingleStepCallback(uint vcpuId,
-                                                     const std::function<void(vmi_event_t*)>& eventCallback,
-                                                     uint64_t data)
+    void SingleStepSupervisor::setSingleStepCallback(uint vcpuId, SingleStepCallback eventCallback, uint64_t data)
     {
-        if (callbacks[vcpuId])
+        auto& slot = slots[vcpuId];
+        if (slot.requestCount == maxQueuedRequests)
         {
-            throw VmiException(
-                fmt::format("{}: Registering a second callback to the current VCPU is not allowed.", __func__));
+            throw VmiException(fmt::format(
+                "{}: Too many pending single steps for the current VCPU. VCPU_ID = {}", __func__, vcpuId));
+        }
+        slot.requests[(slot.firstRequest + slot.requestCount) % maxQueuedRequests] = {.callback = eventCallback,
+                                                                                      .data = data};
+        if (slot.requestCount == 0)
+        {
+            SET_VCPU_SINGLESTEP(slot.event.ss_event, vcpuId);
+            vmiInterface->registerEvent(slot.event);
         }
-        callbacks[vcpuId] = eventCallback;
-        SETUP_SINGLESTEP_EVENT(&singleStepEvents[vcpuId], 0, _defaultSingleStepCallback, true);
-        SET_VCPU_SINGLESTEP(singleStepEvents[vcpuId].ss_event, vcpuId);
-        singleStepEvents[vcpuId].data = reinterpret_cast<void*>(data);
-        vmiInterface->registerEvent(singleStepEvents[vcpuId]);
+        slot.requestCount++;
     }
 
     event_response_t
     SingleStepSupervisor::_defaultSingleStepCallback(__attribute__((unused)) vmi_instance_t vmiInstance,
                                                      vmi_event_t* event)
     {
+        static auto& callbackLatency = GlobalControl::latencyHistograms().get("callback.singleStep");
+        ScopedLatency measurement(callbackLatency);
         auto eventResponse = VMI_EVENT_RESPONSE_NONE;
         try
         {
@@ -108,7 +118,7 @@ namespace VmiCore
         }
         catch (const std::exception& e)
         {
-            GlobalControl::endVmi = true;
+            GlobalControl::requestShutdown();
             GlobalControl::logger()->error("Unexpected exception", {{"logger", loggerName}, {"exception", e.what()}});
         }
         return eventResponse;
@@ -3,13 +3,17 @@
 
 #include "../io/ILogging.h"
 #include "LibvmiInterface.h"
-#include <functional>
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include <vmicore/io/ILogger.h>
 
 namespace VmiCore
 {
+    // Plain function pointer, so that arming a single step neither allocates nor copies any captured state
+    using SingleStepCallback = void (*)(vmi_event_t* event);
+
     class ISingleStepSupervisor
     {
       public:
@@ -19,8 +23,12 @@ namespace VmiCore
 
         virtual void teardown() = 0;
 
-        virtual void
-        setSingleStepCallback(uint vcpuId, const std::function<void(vmi_event_t*)>& eventCallback, uint64_t data) = 0;
+        /**
+         * Single steps the given vCPU and invokes the callback after the next instruction, with the data being
+         * available as the data member of the event. Requests for a vCPU that is already being single stepped are
+         * queued and served by subsequent steps in order.
+         */
+        virtual void setSingleStepCallback(uint vcpuId, SingleStepCallback eventCallback, uint64_t data) = 0;
 
       protected:
         ISingleStepSupervisor() = default;
@@ -39,15 +47,34 @@ namespace VmiCore
 
         static event_response_t _defaultSingleStepCallback(vmi_instance_t vmiInstance, vmi_event_t* event);
 
-        void setSingleStepCallback(uint vcpuId,
-                                   const std::function<void(vmi_event_t*)>& eventCallback,
-                                   uint64_t data) override;
+        void setSingleStepCallback(uint vcpuId, SingleStepCallback eventCallback, uint64_t data) override;
 
       private:
+        // Nested breakpoint hits on the same vCPU before its single step has completed are rare and shallow
+        static constexpr std::size_t maxQueuedRequests = 8;
+
+        struct SingleStepRequest
+        {
+            SingleStepCallback callback = nullptr;
+            uint64_t data = 0;
+        };
+
+        /**
+         * State of a single vCPU. The event is set up once and stays registered until all queued requests have been
+         * served. Events are only ever dispatched by the event loop thread, hence slots do not require any locking.
+         */
+        struct SingleStepSlot
+        {
+            vmi_event_t event{};
+            std::array<SingleStepRequest, maxQueuedRequests> requests{};
+            std::size_t firstRequest = 0;
+            std::size_t requestCount = 0;
+        };
+
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::unique_ptr<ILogger> logger;
-        std::vector<vmi_event_t> singleStepEvents{};
-        std::vector<std::function<void(vmi_event_t*)>> callbacks{};
+        // Sized once, as libvmi refers to the registered events by address
+        std::vector<SingleStepSlot> slots{};
 
         event_response_t singleStepCallback(vmi_event_t* event);
     };
@@ -0,0 +1,113 @@
+#ifndef VMICORE_STRUCTVIEW_H
+#define VMICORE_STRUCTVIEW_H
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fmt/core.h>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vmicore/types.h>
+#include <vmicore/vmi/VmiException.h>
+
+namespace VmiCore
+{
+    /**
+     * Local snapshot of a guest structure. The structure is read from guest memory once in its entirety and
+     * subsequently decoded without any further guest memory accesses.
+     *
+     * @tparam Capacity Size of the inline buffer. Has to be large enough for every profile the structure is used with.
+     */
+    template <std::size_t Capacity> class StructView
+    {
+      public:
+        explicit StructView(std::size_t structSize) : structSize(structSize)
+        {
+            if (structSize > Capacity)
+            {
+                throw VmiException(fmt::format(
+                    "{}: Struct size {:#x} exceeds view capacity of {:#x}", __func__, structSize, Capacity));
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return structSize;
+        }
+
+        /**
+         * Buffer that has to be filled with the contents of the structure.
+         */
+        [[nodiscard]] std::span<uint8_t> data()
+        {
+            return {buffer.data(), structSize};
+        }
+
+        template <typename T> [[nodiscard]] T read(addr_t offset) const
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Field type has to be trivially copyable");
+            expectInBounds(offset, sizeof(T));
+
+            T value;
+            std::memcpy(&value, buffer.data() + offset, sizeof(T));
+            return value;
+        }
+
+        /**
+         * Decodes the bits [startBit, endBit) of a bitfield that is either 4 or 8 bytes wide.
+         */
+        [[nodiscard]] uint64_t
+        readBitfield(addr_t offset, std::size_t fieldSize, std::size_t startBit, std::size_t endBit) const
+        {
+            uint64_t fieldValue = 0;
+            switch (fieldSize)
+            {
+                case sizeof(uint32_t):
+                    fieldValue = read<uint32_t>(offset);
+                    break;
+                case sizeof(uint64_t):
+                    fieldValue = read<uint64_t>(offset);
+                    break;
+                default:
+                    throw VmiException(fmt::format("{}: {} is unknown bitfield size", __func__, fieldSize));
+            }
+
+            auto length = endBit - startBit;
+            auto mask = length >= sizeof(uint64_t) * CHAR_BIT ? ~0ULL : (1ULL << length) - 1;
+            return (fieldValue >> startBit) & mask;
+        }
+
+        /**
+         * Decodes a null terminated string that is embedded into the structure as a fixed size character array.
+         */
+        [[nodiscard]] std::string readString(addr_t offset, std::size_t maxLength) const
+        {
+            expectInBounds(offset, maxLength);
+
+            auto begin = reinterpret_cast<const char*>(buffer.data() + offset);
+            return {begin, std::find(begin, begin + maxLength, '\0')};
+        }
+
+      private:
+        // Intentionally left uninitialized, as it will be overwritten by the read anyway
+        std::array<uint8_t, Capacity> buffer; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        std::size_t structSize;
+
+        void expectInBounds(addr_t offset, std::size_t length) const
+        {
+            if (offset + length > structSize)
+            {
+                throw VmiException(fmt::format("{}: Access of {} bytes at offset {:#x} exceeds struct size {:#x}",
+                                               __func__,
+                                               length,
+                                               offset,
+                                               structSize));
+            }
+        }
+    };
+}
+
+#endif // VMICORE_STRUCTVIEW_H
@@ -0,0 +1,127 @@
+#include "TranslationCache.h"
+#include <algorithm>
+#include <mutex>
+#include <vmicore/os/PagingDefinitions.h>
+
+namespace VmiCore
+{
+    std::optional<addr_t> TranslationCache::lookup(addr_t dtb, addr_t virtualAddress)
+    {
+        std::shared_lock lock(cacheLock);
+        if (auto addressSpace = gfnsByVirtualPageByDtb.find(dtb); addressSpace != gfnsByVirtualPageByDtb.end())
+        {
+            if (auto page = addressSpace->second.find(virtualAddress >> PagingDefinitions::numberOfPageIndexBits);
+                page != addressSpace->second.end())
+            {
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return (page->second << PagingDefinitions::numberOfPageIndexBits) +
+                       (virtualAddress & PagingDefinitions::pageOffsetMask);
+            }
+        }
+
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    void TranslationCache::insert(addr_t dtb, addr_t virtualAddress, addr_t physicalAddress)
+    {
+        auto virtualPage = virtualAddress >> PagingDefinitions::numberOfPageIndexBits;
+        auto gfn = physicalAddress >> PagingDefinitions::numberOfPageIndexBits;
+
+        std::unique_lock lock(cacheLock);
+        if (numberOfEntries >= maxEntries)
+        {
+            gfnsByVirtualPageByDtb.clear();
+            virtualPagesByGfn.clear();
+            numberOfEntries = 0;
+        }
+
+        auto [entry, inserted] = gfnsByVirtualPageByDtb[dtb].try_emplace(virtualPage, gfn);
+        if (!inserted)
+        {
+            if (entry->second == gfn)
+            {
+                return;
+            }
+            // The page has been remapped, so the stale frame must no longer refer to it
+            eraseReverseEntry(entry->second, dtb, virtualPage);
+            entry->second = gfn;
+        }
+        else
+        {
+            numberOfEntries++;
+        }
+        virtualPagesByGfn[gfn].emplace_back(dtb, virtualPage);
+    }
+
+    void TranslationCache::invalidateDtb(addr_t dtb)
+    {
+        std::unique_lock lock(cacheLock);
+        auto addressSpace = gfnsByVirtualPageByDtb.find(dtb);
+        if (addressSpace == gfnsByVirtualPageByDtb.end())
+        {
+            return;
+        }
+
+        for (const auto& [virtualPage, gfn] : addressSpace->second)
+        {
+            eraseReverseEntry(gfn, dtb, virtualPage);
+        }
+        numberOfEntries -= addressSpace->second.size();
+        gfnsByVirtualPageByDtb.erase(addressSpace);
+        invalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TranslationCache::invalidateGfn(addr_t gfn)
+    {
+        std::unique_lock lock(cacheLock);
+        auto virtualPages = virtualPagesByGfn.extract(gfn);
+        if (virtualPages.empty())
+        {
+            return;
+        }
+
+        for (const auto& [dtb, virtualPage] : virtualPages.mapped())
+        {
+            auto addressSpace = gfnsByVirtualPageByDtb.find(dtb);
+            addressSpace->second.erase(virtualPage);
+            if (addressSpace->second.empty())
+            {
+                gfnsByVirtualPageByDtb.erase(addressSpace);
+            }
+        }
+        numberOfEntries -= virtualPages.mapped().size();
+        invalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TranslationCache::clear()
+    {
+        std::unique_lock lock(cacheLock);
+        gfnsByVirtualPageByDtb.clear();
+        virtualPagesByGfn.clear();
+        numberOfEntries = 0;
+        invalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    TranslationCacheStatistics TranslationCache::getStatistics() const
+    {
+        return {.hits = hits.load(std::memory_order_relaxed),
+                .misses = misses.load(std::memory_order_relaxed),
+                .invalidations = invalidations.load(std::memory_order_relaxed)};
+    }
+
+    void TranslationCache::eraseReverseEntry(addr_t gfn, addr_t dtb, addr_t virtualPage)
+    {
+        auto virtualPages = virtualPagesByGfn.find(gfn);
+        if (virtualPages == virtualPagesByGfn.end())
+        {
+            return;
+        }
+
+        std::erase(virtualPages->second, std::make_pair(dtb, virtualPage));
+        if (virtualPages->second.empty())
+        {
+            virtualPagesByGfn.erase(virtualPages);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef VMICORE_TRANSLATIONCACHE_H
+#define VMICORE_TRANSLATIONCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vmicore/types.h>
+
+namespace VmiCore
+{
+    struct TranslationCacheStatistics
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t invalidations;
+    };
+
+    /**
+     * Caches virtual to physical page translations per directory table base. Entries are never aged out on their own,
+     * instead they have to be invalidated explicitly whenever a translation may have changed, either for a whole
+     * address space or for all pages that map a specific guest frame.
+     */
+    class TranslationCache
+    {
+      public:
+        [[nodiscard]] std::optional<addr_t> lookup(addr_t dtb, addr_t virtualAddress);
+
+        void insert(addr_t dtb, addr_t virtualAddress, addr_t physicalAddress);
+
+        void invalidateDtb(addr_t dtb);
+
+        void invalidateGfn(addr_t gfn);
+
+        void clear();
+
+        [[nodiscard]] TranslationCacheStatistics getStatistics() const;
+
+      private:
+        // Upper bound for the number of cached pages. The cache is simply dropped once it is exceeded.
+        static constexpr std::size_t maxEntries = 0x10000;
+
+        mutable std::shared_mutex cacheLock{};
+        std::unordered_map<addr_t, std::unordered_map<addr_t, addr_t>> gfnsByVirtualPageByDtb{};
+        std::unordered_map<addr_t, std::vector<std::pair<addr_t, addr_t>>> virtualPagesByGfn{};
+        std::size_t numberOfEntries = 0;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> invalidations{0};
+
+        // Expects cacheLock to be held exclusively by the caller
+        void eraseReverseEntry(addr_t gfn, addr_t dtb, addr_t virtualPage);
+    };
+}
+
+#endif // VMICORE_TRANSLATIONCACHE_H
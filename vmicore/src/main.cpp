@@ -18,6 +18,8 @@
 #include "lib/io/grpc/GRPCServer.h"
 #include "lib/vmi/InterruptEventSupervisor.h"
 #include "lib/vmi/LibvmiInterface.h"
+#include "lib/vmi/OfflineLibvmiInterface.h"
+#include "lib/vmi/ReplayLibvmiInterface.h"
 #include <boost/di.hpp>
 #include <cxx_rust_part/bridge.h>
 #include <iostream>
@@ -43,7 +45,20 @@ int main(int argc, const char* argv[])
 
         const auto injector = boost::di::make_injector(
             boost::di::bind<VmiCore::IConfigParser>().to<VmiCore::ConfigYAMLParser>(),
-            boost::di::bind<VmiCore::ILibvmiInterface>().to<VmiCore::LibvmiInterface>(),
+            boost::di::bind<VmiCore::ILibvmiInterface>().to(
+                [](const auto& injector) -> std::shared_ptr<VmiCore::ILibvmiInterface>
+                {
+                    auto configInterface = injector.template create<std::shared_ptr<VmiCore::IConfigParser>>();
+                    if (!configInterface->getEventReplayPath().empty())
+                    {
+                        return injector.template create<std::shared_ptr<VmiCore::ReplayLibvmiInterface>>();
+                    }
+                    if (!configInterface->getMemoryDumpPath().empty())
+                    {
+                        return injector.template create<std::shared_ptr<VmiCore::OfflineLibvmiInterface>>();
+                    }
+                    return injector.template create<std::shared_ptr<VmiCore::LibvmiInterface>>();
+                }),
             boost::di::bind<VmiCore::ISingleStepSupervisor>().to<VmiCore::SingleStepSupervisor>(),
             boost::di::bind<VmiCore::IRegisterEventSupervisor>().to<VmiCore::RegisterEventSupervisor>(),
             boost::di::bind<VmiCore::ILogging>().to(
@@ -90,6 +105,18 @@ int main(int argc, const char* argv[])
         {
             configInterface->setSocketPath(cmd.kvmiSocketArgument.getValue());
         }
+        if (cmd.memoryDumpArgument.isSet())
+        {
+            configInterface->setMemoryDumpPath(cmd.memoryDumpArgument.getValue());
+        }
+        if (cmd.recordEventsArgument.isSet())
+        {
+            configInterface->setEventRecordingPath(cmd.recordEventsArgument.getValue());
+        }
+        if (cmd.replayEventsArgument.isSet())
+        {
+            configInterface->setEventReplayPath(cmd.replayEventsArgument.getValue());
+        }
         if (cmd.resultsDirectoryArgument.isSet())
         {
             configInterface->setResultsDirectory(cmd.resultsDirectoryArgument.getValue());
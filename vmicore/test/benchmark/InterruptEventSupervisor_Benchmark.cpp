@@ -0,0 +1,229 @@
+#include "../lib/io/mock_EventStream.h"
+#include "../lib/io/mock_Logging.h"
+#include "../lib/os/windows/mock_ActiveProcessesSupervisor.h"
+#include "../lib/vmi/mock_LibvmiInterface.h"
+#include "../lib/vmi/mock_SingleStepSupervisor.h"
+#include <GlobalControl.h>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <vmi/InterruptEventSupervisor.h>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore_test/io/mock_Logger.h>
+
+using testing::_;
+using testing::NiceMock;
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr vmi_instance* vmiInstanceStub = nullptr;
+        constexpr uint8_t nopInstruction = 0x90;
+        constexpr std::size_t breakpointsPerPage = 4;
+        constexpr addr_t breakpointStride = 0x10;
+        constexpr addr_t firstTargetPA = 0x100000;
+        constexpr addr_t firstDtb = 0x10000000;
+        constexpr addr_t dtbStride = 0x1000;
+        // Large prime, so that consecutive hits are spread over the whole breakpoint table
+        constexpr std::size_t hitStride = 7919;
+
+        addr_t getTargetPA(std::size_t index)
+        {
+            return firstTargetPA + index / breakpointsPerPage * PagingDefinitions::pageSizeInBytes +
+                   index % breakpointsPerPage * breakpointStride;
+        }
+
+        addr_t getDtb(std::size_t addressSpaceIndex)
+        {
+            return firstDtb + addressSpaceIndex * dtbStride;
+        }
+
+        /**
+         * Serves guest memory accesses without recording them, so that only the bookkeeping of the supervisor is
+         * measured. Kernel addresses are translated by stripping the kernel space boundary.
+         */
+        class FakeLibvmiInterface : public NiceMock<MockLibvmiInterface>
+        {
+          public:
+            uint8_t read8PA(uint64_t /*physicalAddress*/) override
+            {
+                return nopInstruction;
+            }
+
+            void write8PA(uint64_t /*physicalAddress*/, uint8_t /*value*/) override {}
+
+            bool readXVA(uint64_t /*virtualAddress*/,
+                         uint64_t /*cr3*/,
+                         std::vector<uint8_t>& /*content*/,
+                         std::size_t /*size*/) override
+            {
+                return true;
+            }
+
+            bool readBatch(std::span<BatchReadEntry> entries) override
+            {
+                std::ranges::for_each(entries, [](BatchReadEntry& entry) { entry.success = true; });
+                return true;
+            }
+
+            addr_t convertVAToPA(addr_t virtualAddress, addr_t /*processCr3*/) override
+            {
+                return virtualAddress - PagingDefinitions::kernelspaceLowerBoundary;
+            }
+
+            void flushV2PCache(addr_t /*pt*/) override {}
+
+            bool areEventsPending() override
+            {
+                return false;
+            }
+        };
+
+        struct BenchmarkSetup
+        {
+            std::shared_ptr<FakeLibvmiInterface> vmiInterface = std::make_shared<FakeLibvmiInterface>();
+            std::shared_ptr<NiceMock<MockLogging>> logging = std::make_shared<NiceMock<MockLogging>>();
+            std::shared_ptr<NiceMock<MockSingleStepSupervisor>> singleStepSupervisor =
+                std::make_shared<NiceMock<MockSingleStepSupervisor>>();
+            std::shared_ptr<NiceMock<MockActiveProcessesSupervisor>> activeProcessesSupervisor =
+                std::make_shared<NiceMock<MockActiveProcessesSupervisor>>();
+            std::shared_ptr<InterruptEventSupervisor> interruptEventSupervisor;
+            vmi_event_t* interruptEvent = nullptr;
+            x86_registers_t registers{};
+            std::vector<std::shared_ptr<IBreakpoint>> breakpoints;
+
+            explicit BenchmarkSetup(BreakpointMode breakpointMode)
+            {
+                ON_CALL(*logging, newNamedLogger(_))
+                    .WillByDefault([](std::string_view) { return std::make_unique<NiceMock<MockLogger>>(); });
+                ON_CALL(*vmiInterface, registerEvent(_))
+                    .WillByDefault(
+                        [this](vmi_event_t& event)
+                        {
+                            if (event.type == VMI_EVENT_INTERRUPT)
+                            {
+                                interruptEvent = &event;
+                            }
+                        });
+                GlobalControl::init(std::make_unique<NiceMock<MockLogger>>(),
+                                    std::make_shared<NiceMock<MockEventStream>>());
+
+                interruptEventSupervisor = std::make_shared<InterruptEventSupervisor>(
+                    vmiInterface,
+                    singleStepSupervisor,
+                    activeProcessesSupervisor,
+                    std::make_shared<RegisterEventSupervisor>(vmiInterface, logging),
+                    logging,
+                    breakpointMode);
+                interruptEventSupervisor->initialize();
+                interruptEvent->x86_regs = &registers;
+            }
+
+            ~BenchmarkSetup()
+            {
+                breakpoints.clear();
+                interruptEventSupervisor->teardown();
+                GlobalControl::uninit();
+            }
+
+            BenchmarkSetup(const BenchmarkSetup&) = delete;
+
+            BenchmarkSetup(const BenchmarkSetup&&) = delete;
+
+            BenchmarkSetup& operator=(const BenchmarkSetup&) = delete;
+
+            BenchmarkSetup& operator=(const BenchmarkSetup&&) = delete;
+
+            // Breakpoint i belongs to address space i % addressSpaceCount
+            void createBreakpoints(std::size_t breakpointCount, std::size_t addressSpaceCount, bool global)
+            {
+                for (std::size_t index = 0; index < breakpointCount; index++)
+                {
+                    ActiveProcessInformation processInformation{.processDtb = getDtb(index % addressSpaceCount)};
+                    breakpoints.push_back(interruptEventSupervisor->createBreakpoint(
+                        getTargetPA(index) + PagingDefinitions::kernelspaceLowerBoundary,
+                        processInformation,
+                        [](IInterruptEvent&) { return BpResponse::Continue; },
+                        global));
+                }
+            }
+
+            // One process specific breakpoint per address space, all of which share the same INT3
+            void createSharedBreakpoints(std::size_t addressSpaceCount)
+            {
+                for (std::size_t index = 0; index < addressSpaceCount; index++)
+                {
+                    ActiveProcessInformation processInformation{.processDtb = getDtb(index)};
+                    breakpoints.push_back(interruptEventSupervisor->createBreakpoint(
+                        getTargetPA(0) + PagingDefinitions::kernelspaceLowerBoundary,
+                        processInformation,
+                        [](IInterruptEvent&) { return BpResponse::Continue; },
+                        false));
+                }
+            }
+        };
+    }
+
+    // Lookup of the breakpoints at the interrupted PA and invocation of a trivial callback. Emulation avoids the
+    // single step, so that no further events are involved.
+    void BM_InterruptEventSupervisor_interruptDispatch(benchmark::State& state)
+    {
+        auto breakpointCount = static_cast<std::size_t>(state.range(0));
+        BenchmarkSetup setup(BreakpointMode::Emulate);
+        setup.createBreakpoints(breakpointCount, 1, true);
+
+        std::size_t hit = 0;
+        for (auto _ : state)
+        {
+            auto targetPA = getTargetPA(hit * hitStride % breakpointCount);
+            setup.interruptEvent->interrupt_event.gfn = targetPA >> PagingDefinitions::numberOfPageIndexBits;
+            setup.interruptEvent->interrupt_event.offset = targetPA & PagingDefinitions::pageOffsetMask;
+            benchmark::DoNotOptimize(
+                InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, setup.interruptEvent));
+            hit++;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_InterruptEventSupervisor_interruptDispatch)->Arg(16)->Arg(10000);
+
+    // Hits of a single INT3 that is shared by process specific breakpoints of the given number of address spaces, as
+    // is the case for hooks within shared libraries
+    void BM_InterruptEventSupervisor_sharedInterruptDispatch(benchmark::State& state)
+    {
+        auto addressSpaceCount = static_cast<std::size_t>(state.range(0));
+        BenchmarkSetup setup(BreakpointMode::Emulate);
+        setup.createSharedBreakpoints(addressSpaceCount);
+        auto targetPA = getTargetPA(0);
+        setup.registers.cr3 = getDtb(0);
+        setup.interruptEvent->interrupt_event.gfn = targetPA >> PagingDefinitions::numberOfPageIndexBits;
+        setup.interruptEvent->interrupt_event.offset = targetPA & PagingDefinitions::pageOffsetMask;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(
+                InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, setup.interruptEvent));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_InterruptEventSupervisor_sharedInterruptDispatch)->Arg(1)->Arg(16)->Arg(256);
+
+    // Round robin switches between address spaces that share the given number of process specific breakpoints, so
+    // that every switch removes the INT3s of the previous address space and writes those of the next one.
+    void BM_InterruptEventSupervisor_contextSwitch(benchmark::State& state)
+    {
+        auto breakpointCount = static_cast<std::size_t>(state.range(0));
+        auto addressSpaceCount = static_cast<std::size_t>(state.range(1));
+        BenchmarkSetup setup(BreakpointMode::SingleStep);
+        setup.createBreakpoints(breakpointCount, addressSpaceCount, false);
+
+        std::size_t contextSwitch = 0;
+        for (auto _ : state)
+        {
+            setup.interruptEvent->reg_event.value = getDtb(contextSwitch % addressSpaceCount);
+            setup.interruptEventSupervisor->contextSwitchCallback(setup.interruptEvent);
+            contextSwitch++;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_InterruptEventSupervisor_contextSwitch)->Args({10000, 10})->Args({10000, 100});
+}
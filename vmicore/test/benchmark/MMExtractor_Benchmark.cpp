@@ -0,0 +1,178 @@
+#include "../lib/io/mock_Logging.h"
+#include "../lib/vmi/mock_LibvmiInterface.h"
+#include <benchmark/benchmark.h>
+#include <map>
+#include <mutex>
+#include <os/linux/MMExtractor.h>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vmicore_test/io/mock_Logger.h>
+
+using testing::_;
+using testing::NiceMock;
+
+namespace VmiCore::Linux
+{
+    namespace
+    {
+        constexpr addr_t kernelDtb = 0x1aa000;
+        constexpr addr_t mmBase = 0xffff888000100000;
+        constexpr addr_t firstVmaBase = 0xffff888000200000;
+        constexpr addr_t vmaStride = 0x100;
+
+        /**
+         * Serves guest memory from a hash map and emulates the memoized struct offset lookup of LibvmiInterface, i.e.
+         * a string keyed map lookup under a shared lock. The uncached profile lookup of libvmi is not modeled.
+         */
+        class FakeLibvmiInterface : public NiceMock<MockLibvmiInterface>
+        {
+          public:
+            FakeLibvmiInterface()
+            {
+                offsets = {{{"task_struct", "mm"}, 0x898},
+                           {{"task_struct", "tgid"}, 0x994},
+                           {{"task_struct", "real_parent"}, 0x9a0},
+                           {{"mm_struct", "exe_file"}, 0x3a8},
+                           {{"vm_area_struct", "vm_start"}, 0x0},
+                           {{"vm_area_struct", "vm_end"}, 0x8},
+                           {{"vm_area_struct", "vm_next"}, 0x10},
+                           {{"vm_area_struct", "vm_flags"}, 0x50},
+                           {{"vm_area_struct", "vm_file"}, 0xa0},
+                           {{"file", "f_path"}, 0x10},
+                           {{"path", "mnt"}, 0x0},
+                           {{"path", "dentry"}, 0x8},
+                           {{"dentry", "d_name"}, 0x20},
+                           {{"dentry", "d_parent"}, 0x18},
+                           {{"qstr", "name"}, 0x8},
+                           {{"mount", "mnt"}, 0x20},
+                           {{"mount", "mnt_mountpoint"}, 0x18},
+                           {{"mount", "mnt_parent"}, 0x10}};
+            }
+
+            [[nodiscard]] bool isInitialized() const override
+            {
+                return true;
+            }
+
+            uint64_t getOffset(const std::string& /*offsetName*/) override
+            {
+                std::scoped_lock lock(libvmiLock);
+                return 0;
+            }
+
+            uint64_t read64VA(addr_t virtualAddress, addr_t /*cr3*/) override
+            {
+                auto value = memory.find(virtualAddress);
+                return value != memory.end() ? value->second : 0;
+            }
+
+            addr_t getKernelStructOffset(const std::string& structName, const std::string& member) override
+            {
+                std::shared_lock lock(offsetsLock);
+                return offsets.at({structName, member});
+            }
+
+            void setupVmaList(std::size_t vmaCount)
+            {
+                memory.clear();
+                memory[mmBase] = vmaCount > 0 ? firstVmaBase : 0;
+                for (std::size_t i = 0; i < vmaCount; i++)
+                {
+                    auto vma = firstVmaBase + i * vmaStride;
+                    memory[vma + offsets.at({"vm_area_struct", "vm_start"})] = 0x400000 + i * 0x1000;
+                    memory[vma + offsets.at({"vm_area_struct", "vm_end"})] = 0x400fff + i * 0x1000;
+                    memory[vma + offsets.at({"vm_area_struct", "vm_flags"})] = 0x3;
+                    memory[vma + offsets.at({"vm_area_struct", "vm_next"})] = i + 1 < vmaCount ? vma + vmaStride : 0;
+                }
+            }
+
+          private:
+            std::mutex libvmiLock;
+            std::shared_mutex offsetsLock;
+            std::map<std::pair<std::string, std::string>, size_t> offsets;
+            std::unordered_map<addr_t, uint64_t> memory;
+        };
+
+        struct BenchmarkSetup
+        {
+            std::shared_ptr<FakeLibvmiInterface> vmiInterface = std::make_shared<FakeLibvmiInterface>();
+            std::shared_ptr<KernelAddressSpace> kernelAddressSpace =
+                std::make_shared<KernelAddressSpace>(vmiInterface, kernelDtb);
+            std::shared_ptr<NiceMock<MockLogging>> logging = std::make_shared<NiceMock<MockLogging>>();
+
+            explicit BenchmarkSetup(std::size_t vmaCount)
+            {
+                vmiInterface->setupVmaList(vmaCount);
+                ON_CALL(*logging, newNamedLogger(_))
+                    .WillByDefault([](std::string_view) { return std::make_unique<NiceMock<MockLogger>>(); });
+            }
+        };
+    }
+
+    // Access pattern prior to the introduction of KernelOffsets: Every field access looks up its memoized offset.
+    void BM_vmaWalk_offsetLookupPerAccess(benchmark::State& state)
+    {
+        auto vmaCount = static_cast<std::size_t>(state.range(0));
+        BenchmarkSetup setup(vmaCount);
+        auto& vmiInterface = setup.vmiInterface;
+
+        for (auto _ : state)
+        {
+            for (auto area = setup.kernelAddressSpace->read64(mmBase); area != 0;
+                 area = setup.kernelAddressSpace->read64(
+                     area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_next")))
+            {
+                benchmark::DoNotOptimize(setup.kernelAddressSpace->read64(
+                    area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_start")));
+                benchmark::DoNotOptimize(setup.kernelAddressSpace->read64(
+                    area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_end")));
+                benchmark::DoNotOptimize(setup.kernelAddressSpace->read64(
+                    area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_flags")));
+                benchmark::DoNotOptimize(setup.kernelAddressSpace->read64(
+                    area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_file")));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * vmaCount));
+    }
+    BENCHMARK(BM_vmaWalk_offsetLookupPerAccess)->Arg(64)->Arg(512);
+
+    // Same access pattern, with offsets resolved once beforehand.
+    void BM_vmaWalk_precomputedOffsets(benchmark::State& state)
+    {
+        auto vmaCount = static_cast<std::size_t>(state.range(0));
+        BenchmarkSetup setup(vmaCount);
+        auto kernelOffsets = KernelOffsets::init(setup.vmiInterface);
+
+        for (auto _ : state)
+        {
+            for (auto area = setup.kernelAddressSpace->read64(mmBase); area != 0;
+                 area = setup.kernelAddressSpace->read64(area + kernelOffsets.vmAreaStruct.vm_next))
+            {
+                benchmark::DoNotOptimize(setup.kernelAddressSpace->read64(area + kernelOffsets.vmAreaStruct.vm_start));
+                benchmark::DoNotOptimize(setup.kernelAddressSpace->read64(area + kernelOffsets.vmAreaStruct.vm_end));
+                benchmark::DoNotOptimize(setup.kernelAddressSpace->read64(area + kernelOffsets.vmAreaStruct.vm_flags));
+                benchmark::DoNotOptimize(setup.kernelAddressSpace->read64(area + kernelOffsets.vmAreaStruct.vm_file));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * vmaCount));
+    }
+    BENCHMARK(BM_vmaWalk_precomputedOffsets)->Arg(64)->Arg(512);
+
+    // End to end cost of extracting the memory regions of a process, including region construction and logging.
+    void BM_MMExtractor_extractAllMemoryRegions(benchmark::State& state)
+    {
+        auto vmaCount = static_cast<std::size_t>(state.range(0));
+        BenchmarkSetup setup(vmaCount);
+        auto kernelOffsets = std::make_shared<const KernelOffsets>(KernelOffsets::init(setup.vmiInterface));
+        MMExtractor mmExtractor(setup.kernelAddressSpace, kernelOffsets, setup.logging, mmBase);
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(mmExtractor.extractAllMemoryRegions());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * vmaCount));
+    }
+    BENCHMARK(BM_MMExtractor_extractAllMemoryRegions)->Arg(64)->Arg(512);
+}
@@ -34,6 +34,16 @@ namespace VmiCore::Plugin
                     (uint64_t, const ActiveProcessInformation&, const std::function<BpResponse(IInterruptEvent&)>&),
                     (override));
 
+        MOCK_METHOD(std::shared_ptr<IBreakpoint>,
+                    createBreakpoint,
+                    (uint64_t,
+                     const ActiveProcessInformation&,
+                     const std::function<BpResponse(IInterruptEvent&)>&,
+                     const BreakpointFilter&),
+                    (override));
+
+        MOCK_METHOD(bool, createBreakpoints, (const ActiveProcessInformation&, std::span<BreakpointSpec>), (override));
+
         MOCK_METHOD(std::unique_ptr<std::string>, getResultsDir, (), (const, override));
 
         MOCK_METHOD(std::unique_ptr<ILogger>, newNamedLogger, (std::string_view name), (const, override));
@@ -47,6 +57,8 @@ namespace VmiCore::Plugin
         MOCK_METHOD(void, sendInMemDetectionEvent, (std::string_view), (const, override));
 
         MOCK_METHOD(std::shared_ptr<IIntrospectionAPI>, getIntrospectionAPI, (), (const, override));
+
+        MOCK_METHOD(void, deferTask, (uint32_t, std::function<void()>), (override));
     };
 }
 
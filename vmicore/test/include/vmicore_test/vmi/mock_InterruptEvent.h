@@ -36,6 +36,8 @@ namespace VmiCore
         MOCK_METHOD(addr_t, getGfn, (), (const override));
 
         MOCK_METHOD(addr_t, getOffset, (), (const override));
+
+        MOCK_METHOD(uint32_t, getVcpuId, (), (const override));
     };
 }
 
@@ -21,8 +21,16 @@ namespace VmiCore
 
         MOCK_METHOD(uint64_t, readVA, (addr_t, addr_t, std::size_t), (override));
 
+        MOCK_METHOD(std::optional<uint8_t>, tryRead8VA, (uint64_t, uint64_t), (override));
+
+        MOCK_METHOD(std::optional<uint32_t>, tryRead32VA, (uint64_t, uint64_t), (override));
+
+        MOCK_METHOD(std::optional<uint64_t>, tryRead64VA, (uint64_t, uint64_t), (override));
+
         MOCK_METHOD(bool, readXVA, (uint64_t, uint64_t, std::vector<uint8_t>&, std::size_t size), (override));
 
+        MOCK_METHOD(bool, readBatch, (std::span<BatchReadEntry>), (override));
+
         MOCK_METHOD(uint64_t, getCurrentVmId, (), (override));
 
         MOCK_METHOD(uint, getNumberOfVCPUs, (), (const override));
@@ -41,13 +49,12 @@ namespace VmiCore
 
         MOCK_METHOD(std::optional<std::string>, extractWStringAtVA, (addr_t stringVA, addr_t cr3), (override));
 
-        MOCK_METHOD(std::optional<std::unique_ptr<std::string>>,
-                    tryExtractUnicodeStringAtVA,
-                    (addr_t, addr_t),
-                    (override));
+        MOCK_METHOD(std::optional<std::string>, tryExtractUnicodeStringAtVA, (addr_t, addr_t), (override));
 
         MOCK_METHOD(std::unique_ptr<std::string>, extractStringAtVA, (addr_t, addr_t), (override));
 
+        MOCK_METHOD(std::optional<std::string>, tryExtractStringAtVA, (addr_t, addr_t), (override));
+
         MOCK_METHOD(OperatingSystem, getOsType, (), (override));
 
         MOCK_METHOD(uint16_t, getWindowsBuild, (), (override));
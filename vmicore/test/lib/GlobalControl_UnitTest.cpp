@@ -0,0 +1,48 @@
+#include <GlobalControl.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <thread>
+
+namespace VmiCore
+{
+    TEST(GlobalControlTest, requestShutdown_eventLoopBlockedInWait_waitInterrupted)
+    {
+        constexpr int blockingTimeoutMs = 60000;
+        std::atomic<bool> registered = false;
+        std::atomic<bool> finished = false;
+        int pollResult = 0;
+        int pollErrno = 0;
+        auto startTime = std::chrono::steady_clock::now();
+        std::thread eventLoop(
+            [&]()
+            {
+                GlobalControl::registerEventLoopThread();
+                registered = true;
+                pollResult = poll(nullptr, 0, blockingTimeoutMs);
+                pollErrno = errno;
+                GlobalControl::unregisterEventLoopThread();
+                finished = true;
+            });
+        while (!registered)
+        {
+            std::this_thread::yield();
+        }
+
+        // The request is repeated in case it arrives before the wait has actually been entered
+        while (!finished)
+        {
+            GlobalControl::requestShutdown();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        eventLoop.join();
+
+        EXPECT_TRUE(GlobalControl::endVmi);
+        EXPECT_EQ(pollResult, -1);
+        EXPECT_EQ(pollErrno, EINTR);
+        EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(blockingTimeoutMs));
+        GlobalControl::endVmi = false;
+    }
+}
@@ -0,0 +1,102 @@
+#include "config/mock_ConfigInterface.h"
+#include "io/mock_EventStream.h"
+#include "io/mock_Logging.h"
+#include "os/mock_SystemEventSupervisor.h"
+#include "os/windows/mock_ActiveProcessesSupervisor.h"
+#include "plugins/mock_PluginSystem.h"
+#include "vmi/mock_LibvmiInterface.h"
+#include <GlobalControl.h>
+#include <VmiHub.h>
+#include <gtest/gtest.h>
+#include <plugins/PluginException.h>
+#include <vmicore_test/io/mock_Logger.h>
+
+using testing::_;
+using testing::InSequence;
+using testing::NiceMock;
+using testing::Return;
+using testing::Throw;
+
+namespace VmiCore
+{
+    class VmiHubFixture : public testing::Test
+    {
+      protected:
+        std::shared_ptr<MockLibvmiInterface> vmiInterface = std::make_shared<MockLibvmiInterface>();
+        std::shared_ptr<NiceMock<MockLogging>> logging = std::make_shared<NiceMock<MockLogging>>();
+        std::shared_ptr<NiceMock<MockEventStream>> eventStream = std::make_shared<NiceMock<MockEventStream>>();
+        MockPluginSystem pluginSystem;
+        MockSystemEventSupervisor systemEventSupervisor;
+        NiceMock<MockActiveProcessesSupervisor> activeProcessesSupervisor;
+        std::unique_ptr<VmiHub> vmiHub;
+        std::map<std::string, std::vector<std::string>, std::less<>> pluginArgs;
+
+        void SetUp() override
+        {
+            ON_CALL(*logging, newNamedLogger(_))
+                .WillByDefault([](std::string_view) { return std::make_unique<NiceMock<MockLogger>>(); });
+            vmiHub = std::make_unique<VmiHub>(std::make_shared<NiceMock<MockConfigInterface>>(),
+                                              vmiInterface,
+                                              logging,
+                                              eventStream,
+                                              nullptr,
+                                              nullptr,
+                                              nullptr);
+
+            GlobalControl::init(std::make_unique<NiceMock<MockLogger>>(),
+                                std::make_shared<NiceMock<MockEventStream>>());
+        }
+
+        void TearDown() override
+        {
+            GlobalControl::uninit();
+        }
+    };
+
+    TEST_F(VmiHubFixture, startMonitoring_validPlugins_onlySystemEventsSetUpWhileGuestIsPaused)
+    {
+        InSequence s;
+        EXPECT_CALL(pluginSystem, loadPlugins());
+        EXPECT_CALL(pluginSystem, initializePlugins(_));
+        EXPECT_CALL(*vmiInterface, pauseVm());
+        EXPECT_CALL(systemEventSupervisor, initialize());
+        EXPECT_CALL(*vmiInterface, resumeVm());
+        EXPECT_CALL(activeProcessesSupervisor, extractNextDiscoveredProcess()).WillOnce(Return(true));
+        EXPECT_CALL(*vmiInterface, areEventsPending()).WillOnce(Return(true));
+        EXPECT_CALL(*vmiInterface, eventsListen(0));
+        EXPECT_CALL(activeProcessesSupervisor, extractNextDiscoveredProcess()).WillOnce(Return(false));
+        EXPECT_CALL(pluginSystem, startPlugins());
+
+        EXPECT_TRUE(
+            vmiHub->startMonitoring(pluginSystem, systemEventSupervisor, activeProcessesSupervisor, pluginArgs));
+    }
+
+    TEST_F(VmiHubFixture, startMonitoring_pluginFailsToInitialize_guestNotPaused)
+    {
+        EXPECT_CALL(pluginSystem, loadPlugins());
+        EXPECT_CALL(pluginSystem, initializePlugins(_)).WillOnce(Throw(PluginException("test", "error")));
+        EXPECT_CALL(*vmiInterface, pauseVm()).Times(0);
+        EXPECT_CALL(systemEventSupervisor, initialize()).Times(0);
+        EXPECT_CALL(pluginSystem, startPlugins()).Times(0);
+
+        EXPECT_FALSE(
+            vmiHub->startMonitoring(pluginSystem, systemEventSupervisor, activeProcessesSupervisor, pluginArgs));
+    }
+
+    TEST_F(VmiHubFixture, startMonitoring_pluginFailsToStart_monitoringTornDownWhileGuestIsPaused)
+    {
+        EXPECT_CALL(pluginSystem, loadPlugins());
+        EXPECT_CALL(pluginSystem, initializePlugins(_));
+        InSequence s;
+        EXPECT_CALL(*vmiInterface, pauseVm());
+        EXPECT_CALL(systemEventSupervisor, initialize());
+        EXPECT_CALL(*vmiInterface, resumeVm());
+        EXPECT_CALL(pluginSystem, startPlugins()).WillOnce(Throw(PluginException("test", "error")));
+        EXPECT_CALL(*vmiInterface, pauseVm());
+        EXPECT_CALL(systemEventSupervisor, teardown());
+        EXPECT_CALL(*vmiInterface, resumeVm());
+
+        EXPECT_FALSE(
+            vmiHub->startMonitoring(pluginSystem, systemEventSupervisor, activeProcessesSupervisor, pluginArgs));
+    }
+}
@@ -29,6 +29,26 @@ namespace VmiCore
 
         MOCK_METHOD(std::string, getOffsetsFile, (), (const override));
 
+        MOCK_METHOD(std::size_t, getMappingPoolBudget, (), (const override));
+
+        MOCK_METHOD(BreakpointMode, getBreakpointMode, (), (const override));
+
+        MOCK_METHOD(std::filesystem::path, getMemoryDumpPath, (), (const override));
+
+        MOCK_METHOD(void, setMemoryDumpPath, (const std::filesystem::path&), (override));
+
+        MOCK_METHOD(std::filesystem::path, getEventRecordingPath, (), (const override));
+
+        MOCK_METHOD(void, setEventRecordingPath, (const std::filesystem::path&), (override));
+
+        MOCK_METHOD(std::filesystem::path, getEventReplayPath, (), (const override));
+
+        MOCK_METHOD(void, setEventReplayPath, (const std::filesystem::path&), (override));
+
+        MOCK_METHOD(bool, areLatencyHistogramsEnabled, (), (const override));
+
+        MOCK_METHOD(std::chrono::seconds, getLatencyHistogramDumpInterval, (), (const override));
+
         MOCK_METHOD(std::filesystem::path, getPluginDirectory, (), (const override));
 
         MOCK_METHOD((const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&),
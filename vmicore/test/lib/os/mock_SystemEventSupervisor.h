@@ -0,0 +1,13 @@
+#include <gmock/gmock.h>
+#include <os/ISystemEventSupervisor.h>
+
+namespace VmiCore
+{
+    class MockSystemEventSupervisor : public ISystemEventSupervisor
+    {
+      public:
+        MOCK_METHOD(void, initialize, (), (override));
+
+        MOCK_METHOD(void, teardown, (), (override));
+    };
+}
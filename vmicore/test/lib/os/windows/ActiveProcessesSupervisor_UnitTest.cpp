@@ -12,11 +12,25 @@ namespace VmiCore::Windows
 {
     class ActiveProcessesSupervisorFixture : public ProcessesMemoryStateFixture
     {
+      protected:
         void SetUp() override
         {
             ProcessesMemoryStateFixture::SetUp();
             ProcessesMemoryStateFixture::setupActiveProcesses();
         }
+
+        void initializeActiveProcesses()
+        {
+            activeProcessesSupervisor->initialize();
+            extractDiscoveredProcesses();
+        }
+
+        void extractDiscoveredProcesses()
+        {
+            while (activeProcessesSupervisor->extractNextDiscoveredProcess())
+            {
+            }
+        }
     };
 
     MATCHER_P(IsEqualProcess, expectedProcess, "")
@@ -59,12 +73,42 @@ namespace VmiCore::Windows
                                      StrEq(fmt::format("{:#x}", process248.cr3))))
             .Times(1);
 
+        EXPECT_NO_THROW(initializeActiveProcesses());
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, initialize_preexistingProcesses_onlySystemProcessExtracted)
+    {
         EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+
+        EXPECT_THAT(activeProcessesSupervisor->getSystemProcessInformation(), IsEqualProcess(process4));
+        EXPECT_THROW(
+            auto processInformation = activeProcessesSupervisor->getProcessInformationByPid(process248.processId),
+            std::invalid_argument);
     }
 
-    TEST_F(ActiveProcessesSupervisorFixture, addNewProcess_process332_processAdded)
+    TEST_F(ActiveProcessesSupervisorFixture, extractNextDiscoveredProcess_afterInitialize_allProcessesExtracted)
     {
         EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+
+        EXPECT_NO_THROW(extractDiscoveredProcesses());
+
+        EXPECT_THAT(*activeProcessesSupervisor->getActiveProcesses(),
+                    UnorderedElementsAre(IsEqualProcess(process4), IsEqualProcess(process248)));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, extractNextDiscoveredProcess_removedBeforeExtraction_processNotExtracted)
+    {
+        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        activeProcessesSupervisor->removeActiveProcess(process248.eprocessBase);
+
+        EXPECT_NO_THROW(extractDiscoveredProcesses());
+
+        EXPECT_THAT(*activeProcessesSupervisor->getActiveProcesses(), UnorderedElementsAre(IsEqualProcess(process4)));
+    }
+
+    TEST_F(ActiveProcessesSupervisorFixture, addNewProcess_process332_processAdded)
+    {
+        EXPECT_NO_THROW(initializeActiveProcesses());
         setupProcessWithLink(process332, process0.eprocessBase);
 
         EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process332.eprocessBase));
@@ -76,7 +120,7 @@ namespace VmiCore::Windows
 
     TEST_F(ActiveProcessesSupervisorFixture, addNewProcess_process332_processStartEventGenerated)
     {
-        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        EXPECT_NO_THROW(initializeActiveProcesses());
         setupProcessWithLink(process332, process0.eprocessBase);
 
         EXPECT_CALL(*mockEventStream,
@@ -90,7 +134,7 @@ namespace VmiCore::Windows
 
     TEST_F(ActiveProcessesSupervisorFixture, removeActiveProcess_presentProcess_processRemoved)
     {
-        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        EXPECT_NO_THROW(initializeActiveProcesses());
 
         EXPECT_NO_THROW(activeProcessesSupervisor->removeActiveProcess(process248.eprocessBase));
 
@@ -101,7 +145,7 @@ namespace VmiCore::Windows
 
     TEST_F(ActiveProcessesSupervisorFixture, removeActiveProcess_presentProcess_processTerminationEventGenerated)
     {
-        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        EXPECT_NO_THROW(initializeActiveProcesses());
 
         EXPECT_CALL(*mockEventStream,
                     sendProcessEvent(::grpc::ProcessState::Terminated,
@@ -114,7 +158,7 @@ namespace VmiCore::Windows
 
     TEST_F(ActiveProcessesSupervisorFixture, removeNotActiveProcess_inactiveProcess_noChange)
     {
-        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        EXPECT_NO_THROW(initializeActiveProcesses());
 
         EXPECT_NO_THROW(activeProcessesSupervisor->removeActiveProcess(process332.eprocessBase));
 
@@ -125,7 +169,7 @@ namespace VmiCore::Windows
 
     TEST_F(ActiveProcessesSupervisorFixture, getProcessInformationByPid_validPid_correctProcessInformation)
     {
-        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        EXPECT_NO_THROW(initializeActiveProcesses());
 
         std::shared_ptr<ActiveProcessInformation> processInformation;
         EXPECT_NO_THROW(processInformation =
@@ -136,7 +180,7 @@ namespace VmiCore::Windows
 
     TEST_F(ActiveProcessesSupervisorFixture, getProcessInformationByPid_notPresentPid_invalidArgumentException)
     {
-        EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+        EXPECT_NO_THROW(initializeActiveProcesses());
 
         EXPECT_THROW(auto processInformation = activeProcessesSupervisor->getProcessInformationByPid(unusedPid),
                      std::invalid_argument);
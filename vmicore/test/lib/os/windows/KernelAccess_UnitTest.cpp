@@ -2,9 +2,12 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <vmicore/os/PagingDefinitions.h>
+#include <vmicore/vmi/VmiException.h>
 
+using testing::_;
 using testing::Contains;
 using testing::Not;
+using testing::Return;
 using testing::StrEq;
 using testing::UnorderedElementsAre;
 
@@ -34,4 +37,57 @@ namespace VmiCore
         EXPECT_THROW(auto filename = kernelAccess->extractFileName(~PagingDefinitions::kernelspaceLowerBoundary),
                      std::invalid_argument);
     }
+
+    TEST_F(KernelAccessFixture, extractMmVadShortVpns_validVadShort_vpnsReadInSingleBatch)
+    {
+        systemVadTreeRootNodeMemoryState();
+
+        EXPECT_CALL(*mockVmiInterface, readBatch(_)).Times(1);
+        auto [startingVpn, endingVpn] = kernelAccess->extractMmVadShortVpns(vadRootNodeBase);
+
+        EXPECT_EQ(startingVpn, vadRootNodeStartingVpn);
+        EXPECT_EQ(endingVpn, vadRootNodeEndingVpn);
+    }
+
+    TEST_F(KernelAccessFixture, extractMmVadShortVpns_failingBatchRead_throwsVmiException)
+    {
+        ON_CALL(*mockVmiInterface, readBatch(_)).WillByDefault(Return(false));
+
+        EXPECT_THROW([[maybe_unused]] auto vpns = kernelAccess->extractMmVadShortVpns(vadRootNodeBase), VmiException);
+    }
+
+    TEST_F(KernelAccessFixture, tryExtractVadShortInformation_validVadShort_decodedFromSingleRead)
+    {
+        systemVadTreeRootNodeMemoryState();
+
+        EXPECT_CALL(*mockVmiInterface, readBatch(_)).Times(1);
+        auto vadShortInformation = kernelAccess->tryExtractVadShortInformation(vadRootNodeBase);
+
+        ASSERT_TRUE(vadShortInformation.has_value());
+        EXPECT_EQ(vadShortInformation->leftChildAddress, vadRootNodeLeftChildBase);
+        EXPECT_EQ(vadShortInformation->rightChildAddress, vadRootNodeRightChildBase);
+        EXPECT_EQ(vadShortInformation->startingVpn, vadRootNodeStartingVpn);
+        EXPECT_EQ(vadShortInformation->endingVpn, vadRootNodeEndingVpn);
+        EXPECT_EQ(vadShortInformation->protection, static_cast<uint8_t>(Windows::ProtectionValues::PAGE_READWRITE));
+        EXPECT_TRUE(vadShortInformation->isPrivateMemory);
+    }
+
+    TEST_F(KernelAccessFixture, tryExtractVadShortInformation_userspaceAddress_returnsNullopt)
+    {
+        EXPECT_CALL(*mockVmiInterface, readBatch(_)).Times(0);
+
+        EXPECT_FALSE(kernelAccess->tryExtractVadShortInformation(0x1000).has_value());
+    }
+
+    TEST_F(KernelAccessFixture, extractEprocessInformation_validEprocess_decodedFromSingleRead)
+    {
+        setupExtractProcessInformationReturns(process248);
+
+        EXPECT_CALL(*mockVmiInterface, readBatch(_)).Times(1);
+        auto eprocessInformation = kernelAccess->extractEprocessInformation(process248.eprocessBase);
+
+        EXPECT_EQ(eprocessInformation.directoryTableBase, process248.cr3);
+        EXPECT_EQ(eprocessInformation.pid, process248.processId);
+        EXPECT_EQ(eprocessInformation.imageFileName, process248.imageFileName);
+    }
 }
@@ -25,6 +25,9 @@ namespace VmiCore
             process4VadTreeMemoryState();
 
             activeProcessesSupervisor->initialize();
+            while (activeProcessesSupervisor->extractNextDiscoveredProcess())
+            {
+            }
         }
     };
 
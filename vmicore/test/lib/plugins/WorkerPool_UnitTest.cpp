@@ -0,0 +1,86 @@
+#include "../io/mock_Logging.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <plugins/WorkerPool.h>
+#include <stdexcept>
+#include <vector>
+#include <vmicore_test/io/mock_Logger.h>
+
+using testing::_;
+using testing::NiceMock;
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr std::size_t numberOfWorkers = 4;
+        constexpr std::size_t maxQueueDepth = 2;
+        constexpr uint64_t numberOfTasks = 100;
+    }
+
+    class WorkerPoolFixture : public testing::Test
+    {
+      protected:
+        std::shared_ptr<NiceMock<MockLogging>> logging = std::make_shared<NiceMock<MockLogging>>();
+
+        void SetUp() override
+        {
+            ON_CALL(*logging, newNamedLogger(_))
+                .WillByDefault([](std::string_view) { return std::make_unique<NiceMock<MockLogger>>(); });
+        }
+    };
+
+    TEST_F(WorkerPoolFixture, submit_tasksWithSameKey_executedInSubmissionOrder)
+    {
+        WorkerPool workerPool(logging, numberOfWorkers, maxQueueDepth);
+        std::vector<uint64_t> executionOrder;
+
+        for (uint64_t i = 0; i < numberOfTasks; i++)
+        {
+            workerPool.submit(1, [&executionOrder, i]() { executionOrder.push_back(i); });
+        }
+        workerPool.drain();
+
+        ASSERT_EQ(executionOrder.size(), numberOfTasks);
+        EXPECT_TRUE(std::ranges::is_sorted(executionOrder));
+    }
+
+    TEST_F(WorkerPoolFixture, submit_failingTask_followingTasksExecuted)
+    {
+        WorkerPool workerPool(logging, numberOfWorkers, maxQueueDepth);
+        bool executed = false;
+
+        workerPool.submit(1, []() { throw std::runtime_error("Task failed"); });
+        workerPool.submit(1, [&executed]() { executed = true; });
+        workerPool.drain();
+
+        EXPECT_TRUE(executed);
+    }
+
+    TEST_F(WorkerPoolFixture, submit_taskThrowsNonStandardException_followingTasksExecuted)
+    {
+        WorkerPool workerPool(logging, numberOfWorkers, maxQueueDepth);
+        bool executed = false;
+
+        workerPool.submit(1, []() { throw 1; });
+        workerPool.submit(1, [&executed]() { executed = true; });
+        workerPool.drain();
+
+        EXPECT_TRUE(executed);
+    }
+
+    TEST_F(WorkerPoolFixture, getStatistics_queueFull_queueDepthBounded)
+    {
+        WorkerPool workerPool(logging, numberOfWorkers, maxQueueDepth);
+
+        for (uint64_t i = 0; i < numberOfTasks; i++)
+        {
+            workerPool.submit(i, []() {});
+        }
+        workerPool.drain();
+
+        auto statistics = workerPool.getStatistics();
+        EXPECT_EQ(statistics.executedTasks, numberOfTasks);
+        EXPECT_LE(statistics.maxQueueDepth, maxQueueDepth);
+    }
+}
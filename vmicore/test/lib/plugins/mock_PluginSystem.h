@@ -31,6 +31,16 @@ namespace VmiCore
                     (uint64_t, const ActiveProcessInformation&, const std::function<BpResponse(IInterruptEvent&)>&),
                     (override));
 
+        MOCK_METHOD(std::shared_ptr<IBreakpoint>,
+                    createBreakpoint,
+                    (uint64_t,
+                     const ActiveProcessInformation&,
+                     const std::function<BpResponse(IInterruptEvent&)>&,
+                     const BreakpointFilter&),
+                    (override));
+
+        MOCK_METHOD(bool, createBreakpoints, (const ActiveProcessInformation&, std::span<BreakpointSpec>), (override));
+
         MOCK_METHOD(std::unique_ptr<std::string>, getResultsDir, (), (const override));
 
         MOCK_METHOD(std::unique_ptr<ILogger>, newNamedLogger, (std::string_view name), (const, override));
@@ -43,11 +53,15 @@ namespace VmiCore
 
         MOCK_METHOD(void, sendInMemDetectionEvent, (std::string_view), (const override));
 
+        MOCK_METHOD(void, loadPlugins, (), (override));
+
         MOCK_METHOD(void,
                     initializePlugins,
                     ((const std::map<std::string, std::vector<std::string>, std::less<>>&)),
                     (override));
 
+        MOCK_METHOD(void, startPlugins, (), (override));
+
         MOCK_METHOD(void,
                     passProcessStartEventToRegisteredPlugins,
                     (std::shared_ptr<const ActiveProcessInformation>),
@@ -61,5 +75,7 @@ namespace VmiCore
         MOCK_METHOD(void, unloadPlugins, (), (override));
 
         MOCK_METHOD(std::shared_ptr<IIntrospectionAPI>, getIntrospectionAPI, (), (const override));
+
+        MOCK_METHOD(void, deferTask, (uint32_t, std::function<void()>), (override));
     };
 }
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <vmi/BreakpointTable.h>
+#include <vmicore/os/PagingDefinitions.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr addr_t testPA = 0x1234 * PagingDefinitions::pageSizeInBytes;
+        constexpr std::size_t manyEntries = 1000;
+    }
+
+    TEST(BreakpointTableTest, find_emptyTable_noRecord)
+    {
+        BreakpointTable table;
+
+        EXPECT_EQ(table.find(testPA), nullptr);
+    }
+
+    TEST(BreakpointTableTest, findOrInsert_existingPA_existingRecordReturned)
+    {
+        BreakpointTable table;
+        table.findOrInsert(testPA).first.originalValue = 0xFE;
+
+        auto [record, inserted] = table.findOrInsert(testPA);
+
+        EXPECT_FALSE(inserted);
+        EXPECT_EQ(record.originalValue, 0xFE);
+        EXPECT_EQ(table.size(), 1);
+    }
+
+    TEST(BreakpointTableTest, erase_everySecondOfManyPAs_remainingRecordsFound)
+    {
+        BreakpointTable table;
+        for (std::size_t i = 0; i < manyEntries; i++)
+        {
+            table.findOrInsert(testPA + i).first.originalValue = static_cast<uint8_t>(i);
+        }
+
+        for (std::size_t i = 0; i < manyEntries; i += 2)
+        {
+            table.erase(testPA + i);
+        }
+
+        ASSERT_EQ(table.size(), manyEntries / 2);
+        for (std::size_t i = 0; i < manyEntries; i++)
+        {
+            auto* record = table.find(testPA + i);
+            if (i % 2 == 0)
+            {
+                EXPECT_EQ(record, nullptr);
+            }
+            else
+            {
+                ASSERT_NE(record, nullptr);
+                EXPECT_EQ(record->originalValue, static_cast<uint8_t>(i));
+            }
+        }
+    }
+
+    TEST(BreakpointTableTest, clear_recordsPresent_allRecordsRemoved)
+    {
+        BreakpointTable table;
+        table.findOrInsert(testPA);
+        table.findOrInsert(testPA + 1);
+
+        table.clear();
+
+        EXPECT_TRUE(table.empty());
+        EXPECT_EQ(table.find(testPA), nullptr);
+    }
+}
@@ -48,6 +48,7 @@ namespace VmiCore
     TEST_F(ContextSwitchHandlerFixture, defaultContextSwitchCallback_noCallbackRegistered_doesNotThrow)
     {
         contextSwitchHandler->setContextSwitchCallback([](vmi_event_t*) {});
+        contextSwitchHandler->enableContextSwitchEvent();
 
         EXPECT_NO_THROW(RegisterEventSupervisor::_defaultRegisterCallback(vmiInstanceStub, internalContextSwitchEvent));
     }
@@ -55,6 +56,7 @@ namespace VmiCore
     TEST_F(ContextSwitchHandlerFixture, defaultContextSwitchCallback_validCallback_doesNotThrow)
     {
         contextSwitchHandler->setContextSwitchCallback([](vmi_event_t*) {});
+        contextSwitchHandler->enableContextSwitchEvent();
 
         EXPECT_NO_THROW(RegisterEventSupervisor::_defaultRegisterCallback(vmiInstanceStub, internalContextSwitchEvent));
     }
@@ -65,4 +67,35 @@ namespace VmiCore
 
         EXPECT_ANY_THROW(contextSwitchHandler->setContextSwitchCallback([](vmi_event_t*) {}));
     }
+
+    TEST_F(ContextSwitchHandlerFixture, setContextSwitchCallback_validCallback_eventNotRegistered)
+    {
+        EXPECT_CALL(*vmiInterface, registerEvent(_)).Times(0);
+
+        contextSwitchHandler->setContextSwitchCallback([](vmi_event_t*) {});
+    }
+
+    TEST_F(ContextSwitchHandlerFixture, enableContextSwitchEvent_calledTwice_eventRegisteredOnce)
+    {
+        contextSwitchHandler->setContextSwitchCallback([](vmi_event_t*) {});
+        EXPECT_CALL(*vmiInterface, registerEvent(_)).Times(1);
+
+        contextSwitchHandler->enableContextSwitchEvent();
+        contextSwitchHandler->enableContextSwitchEvent();
+    }
+
+    TEST_F(ContextSwitchHandlerFixture, enableContextSwitchEvent_noCallbackSet_throws)
+    {
+        EXPECT_ANY_THROW(contextSwitchHandler->enableContextSwitchEvent());
+    }
+
+    TEST_F(ContextSwitchHandlerFixture, disableContextSwitchEvent_eventEnabled_eventCleared)
+    {
+        contextSwitchHandler->setContextSwitchCallback([](vmi_event_t*) {});
+        contextSwitchHandler->enableContextSwitchEvent();
+        EXPECT_CALL(*vmiInterface, clearEvent(Ref(*internalContextSwitchEvent), false)).Times(1);
+
+        contextSwitchHandler->disableContextSwitchEvent();
+        contextSwitchHandler->teardown();
+    }
 }
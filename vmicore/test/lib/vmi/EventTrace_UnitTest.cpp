@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <map>
+#include <thread>
+#include <vmi/EventTrace.h>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore/vmi/VmiException.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr addr_t testDtb = 0x1aa000;
+        constexpr addr_t testPageVA = 0x7ff612340000;
+        constexpr addr_t testRip = 0x7ff612340123;
+        constexpr uint32_t testVcpuId = 3;
+        constexpr addr_t testPagePA = 0x5000;
+        constexpr uint8_t originalByte = 0x48;
+    }
+
+    class EventTraceFixture : public testing::Test
+    {
+      protected:
+        std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "vmicore_eventtrace_test.trace";
+
+        void TearDown() override
+        {
+            std::filesystem::remove(tracePath);
+        }
+    };
+
+    TEST_F(EventTraceFixture, next_recordWithPage_recordRestored)
+    {
+        x86_registers_t registers{};
+        registers.rip = testRip;
+        vmi_event_t event{};
+        SETUP_INTERRUPT_EVENT(&event, nullptr);
+        event.vcpu_id = testVcpuId;
+        event.interrupt_event.gla = testRip;
+        event.x86_regs = &registers;
+        auto record = EventTraceRecord::fromEvent(event);
+        record.pages.push_back({.dtb = testDtb,
+                                .pageAddress = testPageVA,
+                                .content = std::vector<uint8_t>(PagingDefinitions::pageSizeInBytes, 0xCC)});
+        {
+            EventTraceWriter writer(tracePath);
+            writer.write(record);
+        }
+
+        EventTraceReader reader(tracePath);
+        auto restoredRecord = reader.next();
+
+        ASSERT_TRUE(restoredRecord.has_value());
+        EXPECT_EQ(restoredRecord->type, VMI_EVENT_INTERRUPT);
+        EXPECT_EQ(restoredRecord->vcpuId, testVcpuId);
+        EXPECT_EQ(restoredRecord->gla, testRip);
+        EXPECT_EQ(restoredRecord->registers.rip, testRip);
+        ASSERT_EQ(restoredRecord->pages.size(), 1);
+        EXPECT_EQ(restoredRecord->pages[0].dtb, testDtb);
+        EXPECT_EQ(restoredRecord->pages[0].content, record.pages[0].content);
+        EXPECT_FALSE(reader.next().has_value());
+    }
+
+    TEST_F(EventTraceFixture, constructor_noTraceFile_throwsVmiException)
+    {
+        EXPECT_THROW(EventTraceReader reader(tracePath), VmiException);
+    }
+
+    class EventRecorderFixture : public testing::Test
+    {
+      protected:
+        std::map<std::pair<addr_t, addr_t>, std::vector<uint8_t>> guestMemory{
+            {{0, testPagePA}, std::vector<uint8_t>(PagingDefinitions::pageSizeInBytes, originalByte)}};
+        EventRecorder eventRecorder{[this](addr_t dtb, addr_t pageAddress, std::span<uint8_t> content)
+                                    {
+                                        auto page = guestMemory.find({dtb, pageAddress});
+                                        if (page == guestMemory.end())
+                                        {
+                                            return false;
+                                        }
+                                        std::ranges::copy(page->second, content.begin());
+                                        return true;
+                                    }};
+        vmi_event_t event{};
+
+        void SetUp() override
+        {
+            SETUP_INTERRUPT_EVENT(&event, nullptr);
+        }
+
+        void writeByte(addr_t physicalAddress, uint8_t value)
+        {
+            eventRecorder.capture(0, physicalAddress, sizeof(value));
+            guestMemory[{0, physicalAddress & PagingDefinitions::stripPageOffsetMask}]
+                       [physicalAddress & PagingDefinitions::pageOffsetMask] = value;
+        }
+    };
+
+    TEST_F(EventRecorderFixture, finish_callbackWritesToPage_preWriteContentRecorded)
+    {
+        eventRecorder.begin(event);
+
+        writeByte(testPagePA + 0x10, 0xCC);
+        eventRecorder.capture(0, testPagePA + 0x10, 1);
+        auto record = eventRecorder.finish();
+
+        ASSERT_TRUE(record.has_value());
+        ASSERT_EQ(record->pages.size(), 1);
+        EXPECT_EQ(record->pages[0].content[0x10], originalByte);
+    }
+
+    TEST_F(EventRecorderFixture, finish_accessesSpanTwoPages_eachReadablePageRecordedOnce)
+    {
+        guestMemory[{testDtb, testPageVA}] = std::vector<uint8_t>(PagingDefinitions::pageSizeInBytes);
+        guestMemory[{testDtb, testPageVA + PagingDefinitions::pageSizeInBytes}] =
+            std::vector<uint8_t>(PagingDefinitions::pageSizeInBytes);
+        eventRecorder.begin(event);
+
+        eventRecorder.capture(testDtb, testPageVA + PagingDefinitions::pageSizeInBytes - 4, 8);
+        eventRecorder.capture(testDtb, testPageVA, 8);
+        eventRecorder.capture(testDtb, testPageVA + 2 * PagingDefinitions::pageSizeInBytes, 8);
+        auto record = eventRecorder.finish();
+
+        ASSERT_TRUE(record.has_value());
+        EXPECT_EQ(record->pages.size(), 2);
+    }
+
+    TEST_F(EventRecorderFixture, finish_accessFromOtherThread_pageNotRecorded)
+    {
+        eventRecorder.begin(event);
+
+        std::thread otherThread([this]() { eventRecorder.capture(0, testPagePA, 1); });
+        otherThread.join();
+        auto record = eventRecorder.finish();
+
+        ASSERT_TRUE(record.has_value());
+        EXPECT_TRUE(record->pages.empty());
+        EXPECT_FALSE(eventRecorder.isRecording());
+    }
+}
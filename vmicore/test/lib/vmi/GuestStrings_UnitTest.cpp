@@ -0,0 +1,68 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <vmi/GuestStrings.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        std::vector<uint8_t> toUtf16Le(const std::u16string& string)
+        {
+            std::vector<uint8_t> bytes;
+            for (auto codeUnit : string)
+            {
+                bytes.push_back(static_cast<uint8_t>(codeUnit & 0xFF));
+                bytes.push_back(static_cast<uint8_t>(codeUnit >> 8));
+            }
+            return bytes;
+        }
+    }
+
+    TEST(GuestStringsTest, appendUtf16LeAsUtf8_longAsciiString_convertedCompletely)
+    {
+        auto utf16 = toUtf16Le(u"\\Device\\HarddiskVolume2\\Windows\\System32\\ntdll.dll");
+        std::string result;
+
+        GuestStrings::appendUtf16LeAsUtf8(utf16, result);
+
+        EXPECT_EQ(result, "\\Device\\HarddiskVolume2\\Windows\\System32\\ntdll.dll");
+    }
+
+    TEST(GuestStringsTest, appendUtf16LeAsUtf8_mixedAsciiAndMultibyteCharacters_convertedCompletely)
+    {
+        auto utf16 = toUtf16Le(u"C:\\Users\\Jürgen\\Dokumente\\Preise in €\\\U0001F600.txt");
+        std::string result = "prefix:";
+
+        GuestStrings::appendUtf16LeAsUtf8(utf16, result);
+
+        EXPECT_EQ(result, "prefix:C:\\Users\\J\xC3\xBCrgen\\Dokumente\\Preise in \xE2\x82\xAC\\\xF0\x9F\x98\x80.txt");
+    }
+
+    TEST(GuestStringsTest, appendUtf16LeAsUtf8_unpairedSurrogates_replacedWithReplacementCharacter)
+    {
+        auto utf16 = toUtf16Le(std::u16string{u'a', 0xD83D, u'b', 0xDE00});
+        std::string result;
+
+        GuestStrings::appendUtf16LeAsUtf8(utf16, result);
+
+        EXPECT_EQ(result, "a\xEF\xBF\xBD"
+                          "b\xEF\xBF\xBD");
+    }
+
+    TEST(GuestStringsTest, findUtf16Terminator_terminatorAfterFirstVector_returnsByteOffset)
+    {
+        auto utf16 = toUtf16Le(std::u16string(u"0123456789abcdefghij") + u'\0' + u"klm");
+
+        EXPECT_EQ(GuestStrings::findUtf16Terminator(utf16), 20 * sizeof(char16_t));
+    }
+
+    TEST(GuestStringsTest, findUtf16Terminator_zeroBytesStraddlingCodeUnits_returnsNullopt)
+    {
+        // 0x0061 followed by 0x0100 contains two adjacent zero bytes, which do not form a terminating code unit
+        std::vector<uint8_t> bytes{'a', 0x00, 0x00, 0x01, 0x01, 0x00, 0x00};
+
+        EXPECT_FALSE(GuestStrings::findUtf16Terminator(bytes).has_value());
+    }
+}
@@ -0,0 +1,81 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <vmi/InstrumentedLock.h>
+
+using testing::SizeIs;
+
+namespace VmiCore
+{
+    class InstrumentedLockFixture : public testing::Test
+    {
+      protected:
+        std::mutex mutex;
+        LockStatistics lockStatistics;
+
+        void lockAtFirstSite()
+        {
+            InstrumentedLockGuard lock(mutex, lockStatistics);
+        }
+
+        void lockAtSecondSite()
+        {
+            InstrumentedLockGuard lock(mutex, lockStatistics);
+        }
+
+        void lockAtTwoSitesInSameFunction()
+        {
+            {
+                InstrumentedLockGuard lock(mutex, lockStatistics);
+            }
+            InstrumentedLockGuard lock(mutex, lockStatistics);
+        }
+
+        std::vector<std::pair<std::string, uint64_t>> collectAcquisitions()
+        {
+            std::vector<std::pair<std::string, uint64_t>> acquisitions;
+            lockStatistics.forEachSite(
+                [&acquisitions](std::string_view site, uint_least32_t, const LockSiteStatistics& statistics)
+                { acquisitions.emplace_back(site, statistics.acquisitions.load()); });
+            return acquisitions;
+        }
+    };
+
+    TEST_F(InstrumentedLockFixture, constructor_sameSiteTwice_singleSiteWithTwoAcquisitions)
+    {
+        lockAtFirstSite();
+        lockAtFirstSite();
+
+        auto acquisitions = collectAcquisitions();
+
+        ASSERT_THAT(acquisitions, SizeIs(1));
+        EXPECT_EQ(acquisitions[0].second, 2);
+    }
+
+    TEST_F(InstrumentedLockFixture, constructor_differentSites_separateStatistics)
+    {
+        lockAtFirstSite();
+        lockAtSecondSite();
+
+        EXPECT_THAT(collectAcquisitions(), SizeIs(2));
+    }
+
+    TEST_F(InstrumentedLockFixture, constructor_differentSitesInSameFunction_separateStatistics)
+    {
+        lockAtTwoSitesInSameFunction();
+
+        auto acquisitions = collectAcquisitions();
+
+        ASSERT_THAT(acquisitions, SizeIs(2));
+        EXPECT_EQ(acquisitions[0].first, acquisitions[1].first);
+    }
+
+    TEST_F(InstrumentedLockFixture, destructor_lockGuardLeavesScope_mutexReleased)
+    {
+        lockAtFirstSite();
+
+        EXPECT_TRUE(mutex.try_lock());
+        mutex.unlock();
+    }
+}
@@ -13,15 +13,18 @@
 
 using testing::_;
 using testing::AnyNumber;
+using testing::ElementsAre;
 using testing::NiceMock;
 using testing::Ref;
 using testing::Return;
 using testing::SaveArg;
+using testing::SizeIs;
+using testing::Throw;
+using testing::UnorderedElementsAre;
 
 namespace VmiCore
 {
     using breakpointCallbackFunction_t = std::function<BpResponse(IInterruptEvent&)>;
-    using singleStepCallbackFunction_t = std::function<void(vmi_event_t*)>;
 
     namespace
     {
@@ -36,7 +39,8 @@ namespace VmiCore
                            testUserVA2 = 0x9876 * PagingDefinitions::pageSizeInBytes;
         ;
         constexpr uint64_t testPA1 = 0x1234 * PagingDefinitions::pageSizeInBytes,
-                           testPA2 = 0x5678 * PagingDefinitions::pageSizeInBytes;
+                           testPA2 = 0x5678 * PagingDefinitions::pageSizeInBytes,
+                           testPA3 = 0x9abc * PagingDefinitions::pageSizeInBytes;
         constexpr uint64_t testSystemDtb = 0xaaa00000;
         constexpr uint64_t testTracedProcessDtb = 0xbbb00000;
         constexpr uint64_t testTracedProcessUserDtb = 0xccc00000;
@@ -49,18 +53,16 @@ namespace VmiCore
         };
     }
 
-    MATCHER_P(IsCorrectMemEvent, expectedGfn, "")
+    MATCHER(IsGenericMemEvent, "")
     {
         if (arg.type != VMI_EVENT_MEMORY)
         {
             *result_listener << "\nNot a memory event: type = " << arg.type;
             return false;
         }
-        if (expectedGfn != arg.mem_event.gfn)
+        if (!arg.mem_event.generic)
         {
-            *result_listener << "\nTarget gfn not equal:";
-            *result_listener << "\nExpected: " << expectedGfn;
-            *result_listener << "\nActual: " << arg.mem_event.gfn;
+            *result_listener << "\nNot a generic memory event: gfn = " << arg.mem_event.gfn;
             return false;
         }
         return true;
@@ -80,6 +82,7 @@ namespace VmiCore
         vmi_event_t* interruptSupervisorInternalEvent = nullptr;
         std::shared_ptr<RegisterEventSupervisor> contextSwitchHandler =
             std::make_shared<RegisterEventSupervisor>(vmiInterface, mockLogging);
+        BreakpointMode breakpointMode = BreakpointMode::SingleStep;
 
         std::shared_ptr<ActiveProcessInformation> systemProcessInformation =
             std::make_shared<ActiveProcessInformation>(ActiveProcessInformation{.processDtb = testSystemDtb});
@@ -113,8 +116,14 @@ namespace VmiCore
         {
             ON_CALL(*activeProcessesSupervisor, getSystemProcessInformation())
                 .WillByDefault(Return(systemProcessInformation));
-            // Required for InterruptGuard
-            ON_CALL(*vmiInterface, readXVA(_, _, _, _)).WillByDefault(Return(true));
+            // Required for InterruptGuardManager
+            ON_CALL(*vmiInterface, readBatch(_))
+                .WillByDefault(
+                    [](std::span<BatchReadEntry> entries)
+                    {
+                        std::ranges::for_each(entries, [](BatchReadEntry& entry) { entry.success = true; });
+                        return true;
+                    });
             ON_CALL(*mockLogging, newNamedLogger(_))
                 .WillByDefault([](std::string_view) { return std::make_unique<MockLogger>(); });
 
@@ -129,8 +138,12 @@ namespace VmiCore
                         }
                     });
 
-            interruptEventSupervisor = std::make_shared<InterruptEventSupervisor>(
-                vmiInterface, singleStepSupervisor, activeProcessesSupervisor, contextSwitchHandler, mockLogging);
+            interruptEventSupervisor = std::make_shared<InterruptEventSupervisor>(vmiInterface,
+                                                                                  singleStepSupervisor,
+                                                                                  activeProcessesSupervisor,
+                                                                                  contextSwitchHandler,
+                                                                                  mockLogging,
+                                                                                  breakpointMode);
             interruptEventSupervisor->initialize();
 
             GlobalControl::init(std::make_unique<NiceMock<MockLogger>>(),
@@ -167,14 +180,10 @@ namespace VmiCore
     {
         testing::Sequence s1;
         setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        EXPECT_CALL(*vmiInterface, setMemAccess(_, _)).Times(AnyNumber());
+        EXPECT_CALL(*vmiInterface, readBatch(SizeIs(2))).Times(1).InSequence(s1).RetiresOnSaturation();
         EXPECT_CALL(*vmiInterface,
-                    readXVA(testKernelVA1, systemProcessInformation->processDtb, _, PagingDefinitions::pageSizeInBytes))
-            .Times(1)
-            .InSequence(s1)
-            .RetiresOnSaturation();
-        EXPECT_CALL(
-            *vmiInterface,
-            readXVA(testKernelVA1 + PagingDefinitions::pageSizeInBytes, systemProcessInformation->processDtb, _, 16))
+                    setMemAccess(ElementsAre(testPA1 >> PagingDefinitions::numberOfPageIndexBits), VMI_MEMACCESS_RW))
             .Times(1)
             .InSequence(s1)
             .RetiresOnSaturation();
@@ -202,6 +211,28 @@ namespace VmiCore
         InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent);
     }
 
+    TEST_F(InterruptEventFixture, _defaultInterruptCallback_sharedPA_otherAddressSpacesSkipped)
+    {
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        setupBreakpoint(testKernelVA1, testPA1, defaultTestProcessInfo->processDtb);
+        auto systemMockFunction = std::make_shared<testing::MockFunction<BpResponse(IInterruptEvent&)>>();
+        auto _systemBreakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, systemMockFunction->AsStdFunction(), false);
+        auto tracedProcessMockFunction = std::make_shared<testing::MockFunction<BpResponse(IInterruptEvent&)>>();
+        auto _tracedProcessBreakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *defaultTestProcessInfo, tracedProcessMockFunction->AsStdFunction(), false);
+        auto globalMockFunction = std::make_shared<testing::MockFunction<BpResponse(IInterruptEvent&)>>();
+        auto _globalBreakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *defaultTestProcessInfo, globalMockFunction->AsStdFunction(), true);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs);
+
+        EXPECT_CALL(*systemMockFunction, Call(_)).Times(1);
+        EXPECT_CALL(*globalMockFunction, Call(_)).Times(1);
+        EXPECT_CALL(*tracedProcessMockFunction, Call(_)).Times(0);
+
+        InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent);
+    }
+
     TEST_F(InterruptEventFixture, teardown_twoDistinctEventsRegisteredOnSamePage_doesNotThrow)
     {
         ON_CALL(*vmiInterface, convertVAToPA(testKernelVA1, systemProcessInformation->processDtb))
@@ -234,6 +265,79 @@ namespace VmiCore
         EXPECT_EQ(expectedR8, result);
     }
 
+    TEST_F(InterruptEventFixture, _defaultInterruptCallback_filterConditionNotMet_callbackNotInvoked)
+    {
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        BreakpointFilter filter{.conditions = {{.reg = FilterRegister::R8, .value = expectedR8 + 1}}};
+        auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true, filter);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs);
+
+        EXPECT_CALL(*mockBreakpointCallback, Call(_)).Times(0);
+
+        InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent);
+    }
+
+    TEST_F(InterruptEventFixture, _defaultInterruptCallback_memoryFilterConditionMet_callbackInvoked)
+    {
+        constexpr int64_t argumentOffset = 0x10;
+        constexpr uint64_t argument = 0x42;
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        BreakpointFilter filter{.conditions = {{.reg = FilterRegister::R8,
+                                                .memoryReadSize = sizeof(uint64_t),
+                                                .offset = argumentOffset,
+                                                .value = argument}}};
+        auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true, filter);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs);
+        ON_CALL(*vmiInterface, tryRead64VA(expectedR8 + argumentOffset, x86Regs.cr3)).WillByDefault(Return(argument));
+
+        EXPECT_CALL(*mockBreakpointCallback, Call(_)).Times(1);
+
+        InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent);
+    }
+
+    TEST_F(InterruptEventFixture, _defaultInterruptCallback_filterMemoryNotAccessible_callbackInvoked)
+    {
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        BreakpointFilter filter{
+            .conditions = {{.reg = FilterRegister::R8, .memoryReadSize = sizeof(uint8_t), .value = 0x1}}};
+        auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true, filter);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs);
+        ON_CALL(*vmiInterface, tryRead8VA(_, _)).WillByDefault(Return(std::nullopt));
+
+        EXPECT_CALL(*mockBreakpointCallback, Call(_)).Times(1);
+
+        InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent);
+    }
+
+    TEST_F(InterruptEventFixture, createBreakpoint_filterWithUnsupportedReadSize_throwsVmiException)
+    {
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        BreakpointFilter filter{.conditions = {{.reg = FilterRegister::Rsp, .memoryReadSize = 3}}};
+
+        auto callback = mockBreakpointCallback->AsStdFunction();
+
+        EXPECT_THROW(auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+                         testKernelVA1, *systemProcessInformation, callback, true, filter),
+                     VmiException);
+    }
+
+    TEST_F(InterruptEventFixture, _defaultInterruptCallback_interruptEventTriggered_translationsKept)
+    {
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs);
+
+        EXPECT_CALL(*vmiInterface, flushV2PCache(_)).Times(0);
+        EXPECT_CALL(*vmiInterface, invalidateTranslationsToGfn(_)).Times(0);
+        EXPECT_CALL(*vmiInterface, flushPageCache()).Times(0);
+
+        InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent);
+    }
+
     TEST_F(InterruptEventFixture, _defaultInterruptCallback_nonRegisteredPA_reinjectsEvent)
     {
         uint64_t unknownVA = 0;
@@ -269,7 +373,7 @@ namespace VmiCore
         setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
         auto _breakpoint = interruptEventSupervisor->createBreakpoint(
             testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
-        singleStepCallbackFunction_t singleStepCallback;
+        SingleStepCallback singleStepCallback = nullptr;
         auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs, testVcpuId);
         EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(testVcpuId, _, _))
             .WillOnce(SaveArg<1>(&singleStepCallback));
@@ -277,7 +381,7 @@ namespace VmiCore
         EXPECT_CALL(*vmiInterface, write8PA(testPA1, INT3_BREAKPOINT)).Times(1).RetiresOnSaturation();
 
         EXPECT_NO_THROW(InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent));
-        ASSERT_TRUE(singleStepCallback);
+        ASSERT_NE(singleStepCallback, nullptr);
         EXPECT_NO_THROW(singleStepCallback(&singleStepEvent));
     }
 
@@ -351,11 +455,11 @@ namespace VmiCore
         auto _breakpoint2 = interruptEventSupervisor->createBreakpoint(
             testKernelVA2, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
         EXPECT_CALL(*vmiInterface, clearEvent(_, _)).Times(AnyNumber());
+        EXPECT_CALL(*vmiInterface, clearEvent(IsGenericMemEvent(), false)).Times(1);
         EXPECT_CALL(*vmiInterface,
-                    clearEvent(IsCorrectMemEvent(testPA1 >> PagingDefinitions::numberOfPageIndexBits), false))
-            .Times(1);
-        EXPECT_CALL(*vmiInterface,
-                    clearEvent(IsCorrectMemEvent(testPA2 >> PagingDefinitions::numberOfPageIndexBits), false))
+                    setMemAccess(UnorderedElementsAre(testPA1 >> PagingDefinitions::numberOfPageIndexBits,
+                                                      testPA2 >> PagingDefinitions::numberOfPageIndexBits),
+                                 VMI_MEMACCESS_N))
             .Times(1);
 
         interruptEventSupervisor->teardown();
@@ -530,4 +634,253 @@ namespace VmiCore
 
         interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
     }
+
+    TEST_F(InterruptEventFixtureWithoutInterruptEventSupervisorTeardown,
+           contextSwitchCallback_switchBetweenTracedProcesses_onlyBreakpointsOfBothProcessesToggled)
+    {
+        ActiveProcessInformation secondTestProcess{.processUserDtb = 0x666000};
+        ActiveProcessInformation thirdTestProcess{.processUserDtb = 0x777000};
+        setupBreakpoint(testUserVA1, testPA1, defaultTestProcessInfo->processUserDtb);
+        setupBreakpoint(testUserVA1, testPA2, secondTestProcess.processUserDtb, testOriginalMemoryContent2);
+        setupBreakpoint(testUserVA2, testPA3, thirdTestProcess.processUserDtb);
+        auto breakpoint1 = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, *defaultTestProcessInfo, mockBreakpointCallback->AsStdFunction(), false);
+        auto breakpoint2 = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, secondTestProcess, mockBreakpointCallback->AsStdFunction(), false);
+        auto breakpoint3 = interruptEventSupervisor->createBreakpoint(
+            testUserVA2, thirdTestProcess, mockBreakpointCallback->AsStdFunction(), false);
+        interruptSupervisorInternalEvent->reg_event.value = defaultTestProcessInfo->processUserDtb;
+        interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
+        interruptSupervisorInternalEvent->reg_event.value = secondTestProcess.processUserDtb;
+        EXPECT_CALL(*vmiInterface, write8PA(testPA1, testOriginalMemoryContent)).Times(1);
+        EXPECT_CALL(*vmiInterface, write8PA(testPA2, INT3_BREAKPOINT)).Times(1);
+        EXPECT_CALL(*vmiInterface, write8PA(testPA3, _)).Times(0);
+
+        interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
+    }
+
+    TEST_F(InterruptEventFixtureWithoutInterruptEventSupervisorTeardown,
+           contextSwitchCallback_breakpointsOfBothProcessesOnSamePA_int3Unchanged)
+    {
+        ActiveProcessInformation secondTestProcess{.processUserDtb = 0x666000};
+        setupBreakpoint(testUserVA1, testPA1, defaultTestProcessInfo->processUserDtb);
+        setupBreakpoint(testUserVA1, testPA1, secondTestProcess.processUserDtb);
+        auto breakpoint1 = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, *defaultTestProcessInfo, mockBreakpointCallback->AsStdFunction(), false);
+        auto breakpoint2 = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, secondTestProcess, mockBreakpointCallback->AsStdFunction(), false);
+        interruptSupervisorInternalEvent->reg_event.value = defaultTestProcessInfo->processUserDtb;
+        interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
+        interruptSupervisorInternalEvent->reg_event.value = secondTestProcess.processUserDtb;
+        EXPECT_CALL(*vmiInterface, write8PA(testPA1, _)).Times(0);
+
+        interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
+    }
+
+    TEST_F(InterruptEventFixtureWithoutInterruptEventSupervisorTeardown,
+           deleteBreakpoint_globalBreakpointSharingPAWithProcessBreakpoint_int3DisabledOnNextContextSwitch)
+    {
+        setupBreakpoint(testUserVA1, testPA1, defaultTestProcessInfo->processUserDtb);
+        setupBreakpoint(testUserVA1, testPA1, systemProcessInformation->processUserDtb);
+        auto globalBreakpoint = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
+        auto processBreakpoint = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, *defaultTestProcessInfo, mockBreakpointCallback->AsStdFunction(), false);
+        globalBreakpoint->remove();
+        interruptSupervisorInternalEvent->reg_event.value = testSystemDtb;
+        EXPECT_CALL(*vmiInterface, write8PA(testPA1, testOriginalMemoryContent)).Times(1);
+
+        interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
+    }
+
+    TEST_F(InterruptEventFixtureWithoutInterruptEventSupervisorTeardown,
+           createBreakpoint_globalBreakpoint_contextSwitchEventNotEnabled)
+    {
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+
+        auto breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
+
+        EXPECT_FALSE(contextSwitchHandler->isContextSwitchEventEnabled());
+    }
+
+    TEST_F(InterruptEventFixtureWithoutInterruptEventSupervisorTeardown,
+           createBreakpoint_processSpecificBreakpoint_contextSwitchEventEnabled)
+    {
+        setupBreakpoint(testUserVA1, testPA1, defaultTestProcessInfo->processUserDtb);
+
+        auto breakpoint = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, *defaultTestProcessInfo, mockBreakpointCallback->AsStdFunction(), false);
+
+        EXPECT_TRUE(contextSwitchHandler->isContextSwitchEventEnabled());
+    }
+
+    TEST_F(InterruptEventFixtureWithoutInterruptEventSupervisorTeardown,
+           deleteBreakpoint_lastProcessSpecificBreakpoint_contextSwitchEventDisabled)
+    {
+        setupBreakpoint(testUserVA1, testPA1, defaultTestProcessInfo->processUserDtb);
+        setupBreakpoint(testUserVA2, testPA2, defaultTestProcessInfo->processUserDtb);
+        auto breakpoint1 = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, *defaultTestProcessInfo, mockBreakpointCallback->AsStdFunction(), false);
+        auto breakpoint2 = interruptEventSupervisor->createBreakpoint(
+            testUserVA2, *defaultTestProcessInfo, mockBreakpointCallback->AsStdFunction(), false);
+
+        breakpoint1->remove();
+        EXPECT_TRUE(contextSwitchHandler->isContextSwitchEventEnabled());
+        breakpoint2->remove();
+        EXPECT_FALSE(contextSwitchHandler->isContextSwitchEventEnabled());
+    }
+
+    TEST_F(InterruptEventFixtureWithoutInterruptEventSupervisorTeardown,
+           contextSwitchCallback_kptiSwitchWithinTracedProcess_int3sUnchanged)
+    {
+        setupBreakpoint(testKernelVA1, testPA1, defaultTestProcessInfo->processDtb);
+        setupBreakpoint(testUserVA1, testPA2, defaultTestProcessInfo->processUserDtb);
+        auto kernelBreakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *defaultTestProcessInfo, mockBreakpointCallback->AsStdFunction(), false);
+        auto userBreakpoint = interruptEventSupervisor->createBreakpoint(
+            testUserVA1, *defaultTestProcessInfo, mockBreakpointCallback->AsStdFunction(), false);
+        interruptSupervisorInternalEvent->reg_event.value = testSystemDtb;
+        interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
+        interruptSupervisorInternalEvent->reg_event.value = defaultTestProcessInfo->processUserDtb;
+        EXPECT_CALL(*vmiInterface, write8PA(testPA1, INT3_BREAKPOINT)).Times(1);
+        EXPECT_CALL(*vmiInterface, write8PA(testPA2, INT3_BREAKPOINT)).Times(1);
+        interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
+        testing::Mock::VerifyAndClearExpectations(vmiInterface.get());
+        interruptSupervisorInternalEvent->reg_event.value = defaultTestProcessInfo->processDtb;
+        EXPECT_CALL(*vmiInterface, write8PA(_, _)).Times(0);
+
+        interruptEventSupervisor->contextSwitchCallback(interruptSupervisorInternalEvent);
+    }
+
+    class InterruptEventEmulationFixture : public InterruptEventFixture
+    {
+      protected:
+        InterruptEventEmulationFixture()
+        {
+            breakpointMode = BreakpointMode::Emulate;
+        }
+    };
+
+    TEST_F(InterruptEventEmulationFixture, _defaultInterruptCallback_emulatableInstruction_originalInstructionEmulated)
+    {
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs);
+        EXPECT_CALL(*vmiInterface, write8PA(testPA1, testOriginalMemoryContent)).Times(0);
+        EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(_, _, _)).Times(0);
+
+        auto response = InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent);
+        testing::Mock::VerifyAndClearExpectations(vmiInterface.get());
+
+        EXPECT_EQ(response, VMI_EVENT_RESPONSE_EMULATE | VMI_EVENT_RESPONSE_SET_EMUL_INSN);
+        ASSERT_NE(interruptEvent->emul_insn, nullptr);
+        EXPECT_EQ(interruptEvent->emul_insn->data[0], testOriginalMemoryContent);
+    }
+
+    TEST_F(InterruptEventEmulationFixture, _defaultInterruptCallback_breakpointDeactivated_notRecordedAsEmulatedHit)
+    {
+        auto& emulatedHitLatency = GlobalControl::latencyHistograms().get("breakpoint.emulate");
+        auto& singleStepHitLatency = GlobalControl::latencyHistograms().get("breakpoint.singleStep");
+        auto emulatedHitCount = emulatedHitLatency.getCount();
+        auto singleStepHitCount = singleStepHitLatency.getCount();
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb);
+        auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs);
+        EXPECT_CALL(*mockBreakpointCallback, Call(_)).WillOnce(Return(BpResponse::Deactivate));
+        EXPECT_CALL(*vmiInterface, write8PA(_, _)).Times(AnyNumber());
+        GlobalControl::latencyHistograms().setEnabled(true);
+
+        auto response = InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent);
+        GlobalControl::latencyHistograms().setEnabled(false);
+
+        EXPECT_EQ(response, VMI_EVENT_RESPONSE_NONE);
+        EXPECT_EQ(emulatedHitLatency.getCount(), emulatedHitCount);
+        EXPECT_EQ(singleStepHitLatency.getCount(), singleStepHitCount + 1);
+    }
+
+    TEST_F(InterruptEventEmulationFixture, _defaultInterruptCallback_nonEmulatableInstruction_fallsBackToSingleStep)
+    {
+        constexpr uint8_t hltInstruction = 0xF4;
+        setupBreakpoint(testKernelVA1, testPA1, systemProcessInformation->processDtb, hltInstruction);
+        auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1, testPA1, x86Regs, testVcpuId);
+        EXPECT_CALL(*vmiInterface, write8PA(_, _)).Times(AnyNumber());
+        EXPECT_CALL(*vmiInterface, write8PA(testPA1, hltInstruction)).Times(1).RetiresOnSaturation();
+        EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(testVcpuId, _, testPA1)).Times(1);
+
+        EXPECT_EQ(InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent),
+                  VMI_EVENT_RESPONSE_NONE);
+    }
+
+    TEST_F(InterruptEventEmulationFixture, _defaultInterruptCallback_instructionAtEndOfPage_fallsBackToSingleStep)
+    {
+        constexpr auto pageEndOffset = PagingDefinitions::pageSizeInBytes - 1;
+        setupBreakpoint(testKernelVA1 + pageEndOffset, testPA1 + pageEndOffset, systemProcessInformation->processDtb);
+        auto _breakpoint = interruptEventSupervisor->createBreakpoint(
+            testKernelVA1 + pageEndOffset, *systemProcessInformation, mockBreakpointCallback->AsStdFunction(), true);
+        auto* interruptEvent = setupInterruptEvent(testKernelVA1 + pageEndOffset, testPA1 + pageEndOffset, x86Regs);
+        EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(_, _, testPA1 + pageEndOffset)).Times(1);
+
+        EXPECT_EQ(InterruptEventSupervisor::_defaultInterruptCallback(vmiInstanceStub, interruptEvent),
+                  VMI_EVENT_RESPONSE_NONE);
+    }
+
+    TEST_F(InterruptEventFixture, createBreakpoints_twoTargetsOnSamePage_singleFlushPauseAndGuard)
+    {
+        setupBreakpoint(testUserVA1, testPA1, defaultTestProcessInfo->processUserDtb);
+        setupBreakpoint(testUserVA1 + 1, testPA1 + 1, defaultTestProcessInfo->processUserDtb);
+        std::vector<BreakpointSpec> breakpointSpecs{
+            {.targetVA = testUserVA1, .callbackFunction = mockBreakpointCallback->AsStdFunction()},
+            {.targetVA = testUserVA1 + 1, .callbackFunction = mockBreakpointCallback->AsStdFunction()}};
+        EXPECT_CALL(*vmiInterface, flushV2PCache(defaultTestProcessInfo->processUserDtb)).Times(1);
+        EXPECT_CALL(*vmiInterface, pauseVm()).Times(1);
+        EXPECT_CALL(*vmiInterface, resumeVm()).Times(1);
+        EXPECT_CALL(*vmiInterface, setMemAccess(_, _)).Times(AnyNumber());
+        EXPECT_CALL(*vmiInterface,
+                    setMemAccess(ElementsAre(testPA1 >> PagingDefinitions::numberOfPageIndexBits), VMI_MEMACCESS_RW))
+            .Times(1);
+        EXPECT_CALL(*vmiInterface, write8PA(testPA1, INT3_BREAKPOINT)).Times(1);
+        EXPECT_CALL(*vmiInterface, write8PA(testPA1 + 1, INT3_BREAKPOINT)).Times(1);
+
+        EXPECT_TRUE(interruptEventSupervisor->createBreakpoints(*defaultTestProcessInfo, breakpointSpecs, false));
+        testing::Mock::VerifyAndClearExpectations(vmiInterface.get());
+
+        EXPECT_TRUE(breakpointSpecs[0].breakpoint);
+        EXPECT_TRUE(breakpointSpecs[1].breakpoint);
+    }
+
+    TEST_F(InterruptEventFixture, createBreakpoints_untranslatableTarget_remainingBreakpointsCreated)
+    {
+        setupBreakpoint(testUserVA1, testPA1, defaultTestProcessInfo->processUserDtb);
+        ON_CALL(*vmiInterface, convertVAToPA(testUserVA2, defaultTestProcessInfo->processUserDtb))
+            .WillByDefault(Throw(VmiException("Page not present")));
+        std::vector<BreakpointSpec> breakpointSpecs{
+            {.targetVA = testUserVA2, .callbackFunction = mockBreakpointCallback->AsStdFunction()},
+            {.targetVA = testUserVA1, .callbackFunction = mockBreakpointCallback->AsStdFunction()}};
+
+        EXPECT_FALSE(interruptEventSupervisor->createBreakpoints(*defaultTestProcessInfo, breakpointSpecs, false));
+
+        EXPECT_FALSE(breakpointSpecs[0].breakpoint);
+        EXPECT_FALSE(breakpointSpecs[0].error.empty());
+        EXPECT_TRUE(breakpointSpecs[1].breakpoint);
+        EXPECT_TRUE(breakpointSpecs[1].error.empty());
+    }
+
+    TEST_F(InterruptEventFixture, createBreakpoints_setMemAccessFails_guestResumed)
+    {
+        setupBreakpoint(testUserVA1, testPA1, defaultTestProcessInfo->processUserDtb);
+        std::vector<BreakpointSpec> breakpointSpecs{
+            {.targetVA = testUserVA1, .callbackFunction = mockBreakpointCallback->AsStdFunction()}};
+        ON_CALL(*vmiInterface, setMemAccess(_, _)).WillByDefault(Throw(VmiException("Unable to set access")));
+        EXPECT_CALL(*vmiInterface, pauseVm()).Times(1);
+        EXPECT_CALL(*vmiInterface, resumeVm()).Times(1);
+
+        EXPECT_THROW(interruptEventSupervisor->createBreakpoints(*defaultTestProcessInfo, breakpointSpecs, false),
+                     VmiException);
+        testing::Mock::VerifyAndClearExpectations(vmiInterface.get());
+    }
 }
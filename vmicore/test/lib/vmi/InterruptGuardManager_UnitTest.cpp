@@ -0,0 +1,113 @@
+#include "../io/mock_EventStream.h"
+#include "../io/mock_Logging.h"
+#include "mock_LibvmiInterface.h"
+#include <GlobalControl.h>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vmi/InterruptGuardManager.h>
+#include <vmicore/vmi/VmiException.h>
+#include <vmicore_test/io/mock_Logger.h>
+
+using testing::_;
+using testing::AnyNumber;
+using testing::ElementsAre;
+using testing::NiceMock;
+using testing::Return;
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr addr_t testGfn = 0x1234;
+        constexpr addr_t testPageVA = 0x7fff0000;
+        constexpr addr_t testDtb = 0xaaa00000;
+        constexpr uint8_t shadowContent = 0x90;
+    }
+
+    class InterruptGuardManagerFixture : public testing::Test
+    {
+      protected:
+        std::shared_ptr<NiceMock<MockLibvmiInterface>> vmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+        std::shared_ptr<NiceMock<MockLogging>> mockLogging = std::make_shared<NiceMock<MockLogging>>();
+        std::unique_ptr<InterruptGuardManager> guardManager;
+        vmi_event_t* guardEvent = nullptr;
+
+        void SetUp() override
+        {
+            ON_CALL(*mockLogging, newNamedLogger(_))
+                .WillByDefault([](std::string_view) { return std::make_unique<NiceMock<MockLogger>>(); });
+            ON_CALL(*vmiInterface, registerEvent(_)).WillByDefault([this](vmi_event_t& event) { guardEvent = &event; });
+            ON_CALL(*vmiInterface, readBatch(_))
+                .WillByDefault(
+                    [](std::span<BatchReadEntry> entries)
+                    {
+                        for (auto& entry : entries)
+                        {
+                            std::memset(entry.destination, shadowContent, entry.size);
+                            entry.success = true;
+                        }
+                        return true;
+                    });
+            GlobalControl::init(std::make_unique<NiceMock<MockLogger>>(),
+                                std::make_shared<NiceMock<MockEventStream>>());
+
+            // Individual tests only restrict the access changes they are interested in
+            EXPECT_CALL(*vmiInterface, setMemAccess(_, _)).Times(AnyNumber());
+
+            guardManager = std::make_unique<InterruptGuardManager>(vmiInterface, mockLogging);
+            guardManager->initialize();
+        }
+
+        void TearDown() override
+        {
+            guardManager->teardown();
+            GlobalControl::uninit();
+        }
+    };
+
+    TEST_F(InterruptGuardManagerFixture, addGuard_twoPages_bothGuardedWithSingleAccessChange)
+    {
+        EXPECT_CALL(*vmiInterface, setMemAccess(ElementsAre(testGfn, testGfn + 1), VMI_MEMACCESS_RW)).Times(1);
+
+        guardManager->addGuard(testGfn, testPageVA, testDtb);
+        guardManager->addGuard(testGfn + 1, testPageVA + PagingDefinitions::pageSizeInBytes, testDtb);
+        guardManager->commitGuards();
+
+        EXPECT_TRUE(guardManager->isGuarded(testGfn));
+        EXPECT_TRUE(guardManager->isGuarded(testGfn + 1));
+    }
+
+    TEST_F(InterruptGuardManagerFixture, addGuard_unreadablePage_throwsVmiException)
+    {
+        ON_CALL(*vmiInterface, readBatch(_)).WillByDefault(Return(false));
+
+        EXPECT_THROW(guardManager->addGuard(testGfn, testPageVA, testDtb), VmiException);
+        EXPECT_FALSE(guardManager->isGuarded(testGfn));
+    }
+
+    TEST_F(InterruptGuardManagerFixture, removeGuard_addedSinceLastCommit_pageNeverRestricted)
+    {
+        EXPECT_CALL(*vmiInterface, setMemAccess(_, VMI_MEMACCESS_RW)).Times(0);
+
+        guardManager->addGuard(testGfn, testPageVA, testDtb);
+        guardManager->removeGuard(testGfn);
+        guardManager->commitGuards();
+    }
+
+    TEST_F(InterruptGuardManagerFixture, guardCallback_readOfGuardedPage_shadowContentEmulatedAndHitCounted)
+    {
+        guardManager->addGuard(testGfn, testPageVA, testDtb);
+        guardManager->commitGuards();
+        guardEvent->mem_event.gfn = testGfn;
+        guardEvent->mem_event.offset = PagingDefinitions::pageSizeInBytes - 1;
+        guardEvent->mem_event.out_access = VMI_MEMACCESS_R;
+
+        auto response = guardEvent->callback(nullptr, guardEvent);
+
+        EXPECT_EQ(response, VMI_EVENT_RESPONSE_SET_EMUL_READ_DATA);
+        ASSERT_NE(guardEvent->emul_read, nullptr);
+        EXPECT_EQ(guardEvent->emul_read->data[0], shadowContent);
+        EXPECT_EQ(guardEvent->emul_read->data[15], shadowContent);
+        EXPECT_EQ(guardManager->getHitCount(testGfn), 1);
+    }
+}
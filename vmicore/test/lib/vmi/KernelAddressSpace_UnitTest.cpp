@@ -0,0 +1,47 @@
+#include "mock_LibvmiInterface.h"
+#include <gtest/gtest.h>
+#include <vmi/KernelAddressSpace.h>
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr addr_t kernelDtb = 0x1aa000;
+        constexpr addr_t testVA = 0xfffff80000001000;
+    }
+
+    TEST(KernelAddressSpaceTest, read64_validAddress_readsWithKernelDtb)
+    {
+        auto vmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+        auto kernelAddressSpace = KernelAddressSpace(vmiInterface, kernelDtb);
+        ON_CALL(*vmiInterface, read64VA(testVA, kernelDtb)).WillByDefault(Return(0x42));
+
+        EXPECT_EQ(kernelAddressSpace.read64(testVA), 0x42);
+    }
+
+    TEST(KernelAddressSpaceTest, read32_multipleReads_kernelDtbNeverResolvedAgain)
+    {
+        auto vmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+        auto kernelAddressSpace = KernelAddressSpace(vmiInterface, kernelDtb);
+
+        EXPECT_CALL(*vmiInterface, convertPidToDtb(_)).Times(0);
+        EXPECT_CALL(*vmiInterface, read32VA(_, kernelDtb)).Times(2);
+
+        [[maybe_unused]] auto first = kernelAddressSpace.read32(testVA);
+        [[maybe_unused]] auto second = kernelAddressSpace.read32(testVA + sizeof(uint32_t));
+    }
+
+    TEST(KernelAddressSpaceTest, tryReadStruct_unreadableAddress_returnsNullopt)
+    {
+        auto vmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+        auto kernelAddressSpace = KernelAddressSpace(vmiInterface, kernelDtb);
+        ON_CALL(*vmiInterface, readBatch(_)).WillByDefault(Return(false));
+
+        EXPECT_FALSE(kernelAddressSpace.tryReadStruct<0x10>(testVA, 0x10).has_value());
+        EXPECT_THROW([[maybe_unused]] auto view = kernelAddressSpace.readStruct<0x10>(testVA, 0x10), VmiException);
+    }
+}
@@ -0,0 +1,96 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <unistd.h>
+#include <vmi/LatencyHistogram.h>
+
+namespace VmiCore
+{
+    TEST(LatencyHistogramTest, getValueAtPercentile_uniformValues_withinRelativeError)
+    {
+        LatencyHistograms histograms;
+        auto& histogram = histograms.get("test");
+        for (uint64_t value = 1; value <= 100000; value++)
+        {
+            histogram.record(value);
+        }
+
+        EXPECT_EQ(histogram.getCount(), 100000);
+        EXPECT_DOUBLE_EQ(histogram.getMean(), 50000.5);
+        EXPECT_NEAR(static_cast<double>(histogram.getValueAtPercentile(50.0)), 50000.0, 50000.0 / 16);
+        EXPECT_NEAR(static_cast<double>(histogram.getValueAtPercentile(99.0)), 99000.0, 99000.0 / 16);
+        EXPECT_EQ(histogram.getValueAtPercentile(100.0), 100000);
+    }
+
+    TEST(LatencyHistogramTest, getValueAtPercentile_smallValues_exact)
+    {
+        LatencyHistograms histograms;
+        auto& histogram = histograms.get("test");
+        histogram.record(3);
+        histogram.record(7);
+        histogram.record(29);
+
+        EXPECT_EQ(histogram.getValueAtPercentile(0.0), 3);
+        EXPECT_EQ(histogram.getValueAtPercentile(50.0), 7);
+        EXPECT_EQ(histogram.getValueAtPercentile(100.0), 29);
+    }
+
+    TEST(LatencyHistogramTest, scopedLatency_histogramsDisabled_nothingRecorded)
+    {
+        LatencyHistograms histograms;
+        auto& histogram = histograms.get("test");
+
+        {
+            ScopedLatency measurement(histogram);
+        }
+        histograms.setEnabled(true);
+        {
+            ScopedLatency measurement(histogram);
+        }
+
+        EXPECT_EQ(histogram.getCount(), 1);
+    }
+
+    TEST(LatencyHistogramTest, scopedLatency_retargeted_recordedToNewHistogramOnly)
+    {
+        LatencyHistograms histograms;
+        histograms.setEnabled(true);
+        auto& initialHistogram = histograms.get("initial");
+        auto& finalHistogram = histograms.get("final");
+
+        {
+            ScopedLatency measurement(initialHistogram);
+            measurement.retarget(finalHistogram);
+        }
+
+        EXPECT_EQ(initialHistogram.getCount(), 0);
+        EXPECT_EQ(finalHistogram.getCount(), 1);
+    }
+
+    TEST(LatencyHistogramTest, get_sameNameTwice_sameHistogram)
+    {
+        LatencyHistograms histograms;
+
+        EXPECT_EQ(&histograms.get("test"), &histograms.get("test"));
+        EXPECT_NE(&histograms.get("test"), &histograms.get("other"));
+    }
+
+    TEST(LatencyHistogramTest, writeTo_recordedValues_summaryAndBucketsWritten)
+    {
+        LatencyHistograms histograms;
+        histograms.get("callback.interrupt").record(1000);
+        histograms.get("callback.guard");
+        auto path = std::filesystem::temp_directory_path() / ("latency_histograms_" + std::to_string(getpid()));
+
+        histograms.writeTo(path);
+
+        std::ifstream input(path);
+        std::stringstream content;
+        content << input.rdbuf();
+        std::filesystem::remove(path);
+        EXPECT_NE(content.str().find("callback.interrupt 1 1000 1000 1000 1000 1000 1000 1000\n"), std::string::npos);
+        EXPECT_NE(content.str().find("callback.interrupt 992 1023 1\n"), std::string::npos);
+        EXPECT_EQ(content.str().find("callback.guard"), std::string::npos);
+    }
+}
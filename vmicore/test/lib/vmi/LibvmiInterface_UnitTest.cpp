@@ -1,7 +1,9 @@
 #include "../io/mock_EventStream.h"
 #include "../io/mock_Logging.h"
 #include <gtest/gtest.h>
+#include <array>
 #include <memory>
+#include <vmicore/os/PagingDefinitions.h>
 #include <vmi/LibvmiInterface.h>
 
 using testing::_;
@@ -30,4 +32,35 @@ namespace VmiCore
                                                         std::make_shared<NiceMock<MockEventStream>>()),
                      std::runtime_error);
     }
+
+    TEST(LibvmiInterfaceTest, relocateMappedRegions_regionsWithinPhysicalRange_regionsMovedToVirtualBase)
+    {
+        constexpr addr_t basePA = 0x40000000;
+        constexpr addr_t baseVA = 0x7ff000200000;
+        std::array<mapped_region_t, 2> regionArray{
+            mapped_region_t{.start_va = basePA, .num_pages = 2, .access_ptr = nullptr},
+            mapped_region_t{
+                .start_va = basePA + 3 * PagingDefinitions::pageSizeInBytes, .num_pages = 1, .access_ptr = nullptr}};
+        mapped_regions_t regions{.size = regionArray.size(), .regions = regionArray.data()};
+
+        ASSERT_TRUE(LibvmiInterface::relocateMappedRegions(regions, basePA, baseVA, 4));
+
+        EXPECT_EQ(regionArray[0].start_va, baseVA);
+        EXPECT_EQ(regionArray[1].start_va, baseVA + 3 * PagingDefinitions::pageSizeInBytes);
+    }
+
+    TEST(LibvmiInterfaceTest, relocateMappedRegions_regionOutsideOfPhysicalRange_regionsUnchanged)
+    {
+        constexpr addr_t basePA = 0x40000000;
+        constexpr addr_t baseVA = 0x7ff000200000;
+        std::array<mapped_region_t, 2> regionArray{
+            mapped_region_t{.start_va = basePA, .num_pages = 1, .access_ptr = nullptr},
+            mapped_region_t{.start_va = baseVA, .num_pages = 1, .access_ptr = nullptr}};
+        mapped_regions_t regions{.size = regionArray.size(), .regions = regionArray.data()};
+
+        EXPECT_FALSE(LibvmiInterface::relocateMappedRegions(regions, basePA, baseVA, 4));
+
+        EXPECT_EQ(regionArray[0].start_va, basePA);
+        EXPECT_EQ(regionArray[1].start_va, baseVA);
+    }
 }
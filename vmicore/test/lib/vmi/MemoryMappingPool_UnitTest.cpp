@@ -0,0 +1,95 @@
+#include "../io/mock_Logging.h"
+#include "mock_LibvmiInterface.h"
+#include <gtest/gtest.h>
+#include <vmi/MemoryMappingPool.h>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore_test/io/mock_Logger.h>
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr addr_t testDtb = 0x1aa000;
+        constexpr addr_t otherDtb = 0x2bb000;
+        constexpr addr_t firstRegionVA = 0x400000;
+        constexpr addr_t secondRegionVA = 0x500000;
+        constexpr addr_t thirdRegionVA = 0x600000;
+        constexpr std::size_t numberOfPages = 2;
+        constexpr std::size_t twoRegionsBudget = 2 * numberOfPages * PagingDefinitions::pageSizeInBytes;
+    }
+
+    class MemoryMappingPoolFixture : public testing::Test
+    {
+      protected:
+        std::shared_ptr<NiceMock<MockLibvmiInterface>> vmiInterface =
+            std::make_shared<NiceMock<MockLibvmiInterface>>();
+        std::shared_ptr<NiceMock<MockLogging>> logging = std::make_shared<NiceMock<MockLogging>>();
+
+        void SetUp() override
+        {
+            ON_CALL(*logging, newNamedLogger(_))
+                .WillByDefault([](std::string_view) { return std::make_unique<NiceMock<MockLogger>>(); });
+            ON_CALL(*vmiInterface, mmapGuest(_, _, _)).WillByDefault(Return(std::vector<mapped_regions_t>(1)));
+        }
+    };
+
+    TEST_F(MemoryMappingPoolFixture, map_sameRegionTwice_mappedOnlyOnce)
+    {
+        MemoryMappingPool pool(logging, vmiInterface, twoRegionsBudget);
+
+        EXPECT_CALL(*vmiInterface, mmapGuest(firstRegionVA, testDtb, numberOfPages)).Times(1);
+        auto first = pool.map(firstRegionVA, testDtb, numberOfPages);
+        first->unmap();
+        auto second = pool.map(firstRegionVA, testDtb, numberOfPages);
+
+        EXPECT_NO_THROW(auto _mappings = second->getMappedRegions());
+    }
+
+    TEST_F(MemoryMappingPoolFixture, map_budgetExceeded_leastRecentlyUsedRegionUnmapped)
+    {
+        MemoryMappingPool pool(logging, vmiInterface, twoRegionsBudget);
+        [[maybe_unused]] auto first = pool.map(firstRegionVA, testDtb, numberOfPages);
+        [[maybe_unused]] auto second = pool.map(secondRegionVA, testDtb, numberOfPages);
+        first.reset();
+        second.reset();
+        [[maybe_unused]] auto firstAgain = pool.map(firstRegionVA, testDtb, numberOfPages);
+
+        EXPECT_CALL(*vmiInterface, freeMappedRegions(_)).Times(1);
+        [[maybe_unused]] auto third = pool.map(thirdRegionVA, testDtb, numberOfPages);
+        testing::Mock::VerifyAndClearExpectations(vmiInterface.get());
+
+        EXPECT_CALL(*vmiInterface, mmapGuest(secondRegionVA, testDtb, numberOfPages)).Times(1);
+        [[maybe_unused]] auto secondAgain = pool.map(secondRegionVA, testDtb, numberOfPages);
+    }
+
+    TEST_F(MemoryMappingPoolFixture, invalidateDtb_mappingStillInUse_unmappedAfterLastHandleReleased)
+    {
+        MemoryMappingPool pool(logging, vmiInterface, twoRegionsBudget);
+        auto mapping = pool.map(firstRegionVA, testDtb, numberOfPages);
+        [[maybe_unused]] auto otherMapping = pool.map(firstRegionVA, otherDtb, numberOfPages);
+
+        EXPECT_CALL(*vmiInterface, freeMappedRegions(_)).Times(0);
+        pool.invalidateDtb(testDtb);
+        EXPECT_NO_THROW(auto _mappings = mapping->getMappedRegions());
+        testing::Mock::VerifyAndClearExpectations(vmiInterface.get());
+
+        EXPECT_CALL(*vmiInterface, freeMappedRegions(_)).Times(1);
+        mapping->unmap();
+        EXPECT_ANY_THROW(auto _mappings = mapping->getMappedRegions());
+        testing::Mock::VerifyAndClearExpectations(vmiInterface.get());
+    }
+
+    TEST_F(MemoryMappingPoolFixture, map_zeroBudget_regionNotPooled)
+    {
+        MemoryMappingPool pool(logging, vmiInterface, 0);
+
+        EXPECT_CALL(*vmiInterface, mmapGuest(firstRegionVA, testDtb, numberOfPages)).Times(2);
+        EXPECT_CALL(*vmiInterface, freeMappedRegions(_)).Times(2);
+        [[maybe_unused]] auto first = pool.map(firstRegionVA, testDtb, numberOfPages);
+        [[maybe_unused]] auto second = pool.map(firstRegionVA, testDtb, numberOfPages);
+    }
+}
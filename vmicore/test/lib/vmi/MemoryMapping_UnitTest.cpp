@@ -1,8 +1,10 @@
 #include "../io/mock_Logging.h"
 #include "mock_LibvmiInterface.h"
+#include <array>
 #include <gtest/gtest.h>
 #include <vmi/MemoryMapping.h>
 
+using testing::_;
 using testing::NiceMock;
 
 namespace VmiCore
@@ -11,7 +13,7 @@ namespace VmiCore
     {
         auto memoryMapping = MemoryMapping(std::make_shared<NiceMock<MockLogging>>(),
                                            std::make_shared<NiceMock<MockLibvmiInterface>>(),
-                                           mapped_regions_t{});
+                                           std::vector<mapped_regions_t>{});
 
         EXPECT_NO_THROW(auto _mappings = memoryMapping.getMappedRegions());
     }
@@ -20,10 +22,29 @@ namespace VmiCore
     {
         auto memoryMapping = MemoryMapping(std::make_shared<NiceMock<MockLogging>>(),
                                            std::make_shared<NiceMock<MockLibvmiInterface>>(),
-                                           mapped_regions_t{});
+                                           std::vector<mapped_regions_t>{});
 
         memoryMapping.unmap();
 
         EXPECT_ANY_THROW(auto _mappings = memoryMapping.getMappedRegions());
     }
+
+    TEST(MemoryMappingTest, getMappedRegions_multipleChunks_regionsOfAllChunksInOrder)
+    {
+        std::array<mapped_region_t, 2> firstChunk{mapped_region_t{0x400000, 1, nullptr},
+                                                  mapped_region_t{0x402000, 2, nullptr}};
+        std::array<mapped_region_t, 1> secondChunk{mapped_region_t{0x600000, 0x200, nullptr}};
+        auto vmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+        auto memoryMapping = MemoryMapping(
+            std::make_shared<NiceMock<MockLogging>>(),
+            vmiInterface,
+            {mapped_regions_t{firstChunk.size(), firstChunk.data()}, mapped_regions_t{1, secondChunk.data()}});
+
+        auto mappings = memoryMapping.getMappedRegions();
+
+        ASSERT_EQ(mappings.size(), 3);
+        EXPECT_EQ(mappings[1], MappedRegion(0x402000, 2, nullptr));
+        EXPECT_EQ(mappings[2], MappedRegion(0x600000, 0x200, nullptr));
+        EXPECT_CALL(*vmiInterface, freeMappedRegions(_)).Times(2);
+    }
 }
@@ -0,0 +1,24 @@
+#include "../io/mock_EventStream.h"
+#include "../io/mock_Logging.h"
+#include <GlobalControl.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vmi/OfflineLibvmiInterface.h>
+
+using testing::NiceMock;
+
+namespace VmiCore
+{
+    TEST(OfflineLibvmiInterfaceTest, eventsListen_memoryDump_endsAnalysis)
+    {
+        OfflineLibvmiInterface vmiInterface(std::shared_ptr<IConfigParser>(),
+                                            std::make_shared<NiceMock<MockLogging>>(),
+                                            std::make_shared<NiceMock<MockEventStream>>());
+        GlobalControl::endVmi = false;
+
+        vmiInterface.eventsListen(500);
+
+        EXPECT_TRUE(GlobalControl::endVmi);
+        GlobalControl::endVmi = false;
+    }
+}
@@ -6,6 +6,7 @@
 #include "../io/mock_EventStream.h"
 #include "../io/mock_Logging.h"
 #include "mock_LibvmiInterface.h"
+#include <algorithm>
 #include <cstring>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -15,7 +16,9 @@
 #include <os/windows/KernelOffsets.h>
 #include <os/windows/ProtectionValues.h>
 #include <plugins/PluginSystem.h>
+#include <span>
 #include <vmicore/os/PagingDefinitions.h>
+#include <vmicore/vmi/BatchReadEntry.h>
 #include <vmicore_test/io/mock_Logger.h>
 
 namespace VmiCore
@@ -98,6 +101,12 @@ namespace VmiCore
         constexpr addr_t ImageFileName = 1104;
     }
 
+    namespace STRUCT_SIZES
+    {
+        constexpr size_t _EPROCESS = 0x700;
+        constexpr size_t _MMVAD_SHORT = 0x40;
+    }
+
     using processValues = struct processValues_t
     {
         uint64_t eprocessBase;
@@ -176,6 +185,7 @@ namespace VmiCore
 
         std::shared_ptr<testing::NiceMock<MockLibvmiInterface>> mockVmiInterface =
             std::make_shared<testing::NiceMock<MockLibvmiInterface>>();
+        std::shared_ptr<KernelAddressSpace> kernelAddressSpace;
         std::shared_ptr<Windows::KernelAccess> kernelAccess;
 
         std::shared_ptr<testing::NiceMock<MockLogging>> mockLogging = []()
@@ -262,6 +272,116 @@ namespace VmiCore
                 .WillByDefault(testing::Return(4));
             ON_CALL(*mockVmiInterface, getStructSizeFromJson(Windows::KernelStructOffsets::mmsection_flags::structName))
                 .WillByDefault(testing::Return(4));
+            ON_CALL(*mockVmiInterface, getStructSizeFromJson("_EPROCESS"))
+                .WillByDefault(testing::Return(STRUCT_SIZES::_EPROCESS));
+            ON_CALL(*mockVmiInterface, getStructSizeFromJson("_MMVAD_SHORT"))
+                .WillByDefault(testing::Return(STRUCT_SIZES::_MMVAD_SHORT));
+            ON_CALL(*mockVmiInterface, readBatch(testing::_))
+                .WillByDefault([this](std::span<BatchReadEntry> entries) { return readBatchBySingleReads(entries); });
+        }
+
+        template <typename T> static void writeField(std::span<uint8_t> snapshot, addr_t offset, T value)
+        {
+            std::memcpy(snapshot.data() + offset, &value, sizeof(value));
+        }
+
+        // Composes struct snapshots from the single value read mocks of the fields that are decoded from them
+        void readStructBySingleReads(const BatchReadEntry& entry)
+        {
+            std::span snapshot(static_cast<uint8_t*>(entry.destination), entry.size);
+            std::ranges::fill(snapshot, 0);
+            auto base = entry.virtualAddress;
+            if (entry.size == STRUCT_SIZES::_EPROCESS)
+            {
+                writeField(snapshot,
+                           _EPROCESS_OFFSETS::UniqueProcessId,
+                           mockVmiInterface->read32VA(base + _EPROCESS_OFFSETS::UniqueProcessId, entry.dtb));
+                writeField(
+                    snapshot,
+                    _EPROCESS_OFFSETS::InheritedFromUniqueProcessId,
+                    mockVmiInterface->read64VA(base + _EPROCESS_OFFSETS::InheritedFromUniqueProcessId, entry.dtb));
+                writeField(snapshot,
+                           _KPROCESS_OFFSETS::DirectoryTableBase,
+                           mockVmiInterface->read64VA(base + _KPROCESS_OFFSETS::DirectoryTableBase, entry.dtb));
+                if (auto imageFileName =
+                        mockVmiInterface->extractStringAtVA(base + _EPROCESS_OFFSETS::ImageFileName, entry.dtb))
+                {
+                    constexpr size_t imageFileNameLength = 15;
+                    std::memcpy(snapshot.data() + _EPROCESS_OFFSETS::ImageFileName,
+                                imageFileName->data(),
+                                std::min(imageFileName->size(), imageFileNameLength));
+                }
+            }
+            else if (entry.size == STRUCT_SIZES::_MMVAD_SHORT)
+            {
+                writeField(snapshot,
+                           __MMVAD_SHORT_OFFSETS::VadNode + _RTL_BALANCED_NODE_OFFSETS::Left,
+                           mockVmiInterface->read64VA(
+                               base + __MMVAD_SHORT_OFFSETS::VadNode + _RTL_BALANCED_NODE_OFFSETS::Left, entry.dtb));
+                writeField(snapshot,
+                           __MMVAD_SHORT_OFFSETS::VadNode + _RTL_BALANCED_NODE_OFFSETS::Right,
+                           mockVmiInterface->read64VA(
+                               base + __MMVAD_SHORT_OFFSETS::VadNode + _RTL_BALANCED_NODE_OFFSETS::Right, entry.dtb));
+                for (auto offset : {__MMVAD_SHORT_OFFSETS::StartingVpn,
+                                    __MMVAD_SHORT_OFFSETS::EndingVpn,
+                                    __MMVAD_SHORT_OFFSETS::Flags})
+                {
+                    writeField(snapshot, offset, mockVmiInterface->read32VA(base + offset, entry.dtb));
+                }
+                for (auto offset : {__MMVAD_SHORT_OFFSETS::StartingVpnHigh, __MMVAD_SHORT_OFFSETS::EndingVpnHigh})
+                {
+                    writeField(snapshot, offset, mockVmiInterface->read8VA(base + offset, entry.dtb));
+                }
+            }
+        }
+
+        // Resolves batch reads via the single value read mocks so that memory state only has to be set up once
+        bool readBatchBySingleReads(std::span<BatchReadEntry> entries)
+        {
+            bool allSuccessful = true;
+            for (auto& entry : entries)
+            {
+                switch (entry.size)
+                {
+                    case sizeof(uint8_t):
+                    {
+                        auto value = mockVmiInterface->read8VA(entry.virtualAddress, entry.dtb);
+                        std::memcpy(entry.destination, &value, sizeof(value));
+                        entry.success = true;
+                        break;
+                    }
+                    case sizeof(uint32_t):
+                    {
+                        auto value = mockVmiInterface->read32VA(entry.virtualAddress, entry.dtb);
+                        std::memcpy(entry.destination, &value, sizeof(value));
+                        entry.success = true;
+                        break;
+                    }
+                    case sizeof(uint64_t):
+                    {
+                        auto value = mockVmiInterface->read64VA(entry.virtualAddress, entry.dtb);
+                        std::memcpy(entry.destination, &value, sizeof(value));
+                        entry.success = true;
+                        break;
+                    }
+                    case STRUCT_SIZES::_EPROCESS:
+                    case STRUCT_SIZES::_MMVAD_SHORT:
+                    {
+                        readStructBySingleReads(entry);
+                        entry.success = true;
+                        break;
+                    }
+                    default:
+                    {
+                        std::vector<uint8_t> buffer(entry.size);
+                        entry.success = mockVmiInterface->readXVA(entry.virtualAddress, entry.dtb, buffer, entry.size);
+                        std::memcpy(entry.destination, buffer.data(), entry.size);
+                        break;
+                    }
+                }
+                allSuccessful = entry.success && allSuccessful;
+            }
+            return allSuccessful;
         }
 
         void setupProcessWithLink(const processValues& process, uint64_t link)
@@ -562,9 +682,10 @@ namespace VmiCore
             setupReturnsForVmiInterface();
             setupReturnsForConfigInterface();
 
-            kernelAccess = std::make_shared<Windows::KernelAccess>(mockVmiInterface);
+            kernelAddressSpace = std::make_shared<KernelAddressSpace>(mockVmiInterface, systemCR3);
+            kernelAccess = std::make_shared<Windows::KernelAccess>(mockVmiInterface, kernelAddressSpace);
             activeProcessesSupervisor = std::make_shared<Windows::ActiveProcessesSupervisor>(
-                mockVmiInterface, kernelAccess, mockLogging, mockEventStream);
+                mockVmiInterface, kernelAddressSpace, kernelAccess, mockLogging, mockEventStream);
             pluginSystem = std::make_shared<PluginSystem>(mockConfigInterface,
                                                           mockVmiInterface,
                                                           activeProcessesSupervisor,
@@ -0,0 +1,101 @@
+#include "../config/mock_ConfigInterface.h"
+#include "../io/mock_EventStream.h"
+#include "../io/mock_Logging.h"
+#include <GlobalControl.h>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <optional>
+#include <vmi/ReplayLibvmiInterface.h>
+#include <vmicore/os/PagingDefinitions.h>
+#include <vmicore_test/io/mock_Logger.h>
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr addr_t testDtb = 0x1aa000;
+        constexpr addr_t testPageVA = 0x7ff612340000;
+        constexpr addr_t testRip = 0x7ff612340120;
+        constexpr uint64_t testValue = 0xCCCCCCCCCCCCCCCC;
+
+        struct ReplayedCallback
+        {
+            ReplayLibvmiInterface* vmiInterface;
+            std::optional<uint64_t> valueAtRip;
+        };
+
+        event_response_t readValueAtRip([[maybe_unused]] vmi_instance_t vmi, vmi_event_t* event)
+        {
+            auto* replayedCallback = static_cast<ReplayedCallback*>(event->data);
+            replayedCallback->valueAtRip = replayedCallback->vmiInterface->tryRead64VA(event->x86_regs->rip, testDtb);
+            return VMI_EVENT_RESPONSE_NONE;
+        }
+    }
+
+    class ReplayLibvmiInterfaceFixture : public testing::Test
+    {
+      protected:
+        std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "vmicore_replay_test.trace";
+        std::shared_ptr<NiceMock<MockConfigInterface>> configInterface =
+            std::make_shared<NiceMock<MockConfigInterface>>();
+        std::shared_ptr<NiceMock<MockLogging>> logging = std::make_shared<NiceMock<MockLogging>>();
+
+        void SetUp() override
+        {
+            ON_CALL(*logging, newNamedLogger(_))
+                .WillByDefault([](std::string_view) { return std::make_unique<NiceMock<MockLogger>>(); });
+            ON_CALL(*configInterface, getEventReplayPath()).WillByDefault(Return(tracePath));
+
+            EventTraceRecord record{};
+            record.type = VMI_EVENT_INTERRUPT;
+            record.registers.rip = testRip;
+            record.pages.push_back({.dtb = testDtb,
+                                    .pageAddress = testPageVA,
+                                    .content = std::vector<uint8_t>(PagingDefinitions::pageSizeInBytes, 0xCC)});
+            EventTraceWriter writer(tracePath);
+            writer.write(record);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(tracePath);
+            GlobalControl::endVmi = false;
+        }
+    };
+
+    TEST_F(ReplayLibvmiInterfaceFixture, eventsListen_recordedInterrupt_readsServedFromRecordedPages)
+    {
+        ReplayLibvmiInterface vmiInterface(
+            configInterface, logging, std::make_shared<NiceMock<MockEventStream>>());
+        ReplayedCallback replayedCallback{.vmiInterface = &vmiInterface, .valueAtRip = std::nullopt};
+        vmi_event_t event{};
+        SETUP_INTERRUPT_EVENT(&event, readValueAtRip);
+        event.data = &replayedCallback;
+        vmiInterface.registerEvent(event);
+
+        vmiInterface.eventsListen(500);
+
+        EXPECT_EQ(replayedCallback.valueAtRip, testValue);
+        EXPECT_TRUE(GlobalControl::endVmi);
+    }
+
+    TEST_F(ReplayLibvmiInterfaceFixture, eventsListen_noRegisteredEvent_callbackNotInvoked)
+    {
+        ReplayLibvmiInterface vmiInterface(
+            configInterface, logging, std::make_shared<NiceMock<MockEventStream>>());
+        ReplayedCallback replayedCallback{.vmiInterface = &vmiInterface, .valueAtRip = std::nullopt};
+        vmi_event_t event{};
+        SETUP_INTERRUPT_EVENT(&event, readValueAtRip);
+        event.data = &replayedCallback;
+        vmiInterface.registerEvent(event);
+        vmiInterface.clearEvent(event, false);
+
+        vmiInterface.eventsListen(500);
+
+        EXPECT_FALSE(replayedCallback.valueAtRip.has_value());
+    }
+}
@@ -9,11 +9,23 @@
 
 using testing::_;
 using testing::AtLeast;
+using testing::Field;
+using testing::InSequence;
 using testing::NiceMock;
 using testing::Return;
 
 namespace VmiCore
 {
+    namespace
+    {
+        testing::MockFunction<void(vmi_event_t*)>* activeSingleStepCallback = nullptr;
+
+        void forwardSingleStepCallback(vmi_event_t* event)
+        {
+            activeSingleStepCallback->Call(event);
+        }
+    }
+
     TEST(SingleStepSupervisorTest, constructor_multipleInstances_throwsRuntimeError)
     {
         std::shared_ptr<NiceMock<MockLogging>> mockLogging = std::make_shared<NiceMock<MockLogging>>();
@@ -31,8 +43,7 @@ namespace VmiCore
       protected:
         std::shared_ptr<MockLibvmiInterface> vmiInterface = std::make_shared<MockLibvmiInterface>();
         std::unique_ptr<SingleStepSupervisor> singleStepSupervisor;
-        std::shared_ptr<testing::internal::MockFunction<void(vmi_event_t*)>> mockSinglestepCallback =
-            std::make_shared<testing::MockFunction<void(vmi_event_t*)>>();
+        testing::MockFunction<void(vmi_event_t*)> mockSinglestepCallback;
         std::shared_ptr<NiceMock<MockLogging>> mockLogging = std::make_shared<NiceMock<MockLogging>>();
         uint numberOfTestVcpus = 1;
         uint testVcpuId = 0;
@@ -48,37 +59,63 @@ namespace VmiCore
 
             GlobalControl::init(std::make_unique<NiceMock<MockLogger>>(),
                                 std::make_shared<NiceMock<MockEventStream>>());
+            activeSingleStepCallback = &mockSinglestepCallback;
         }
 
         void TearDown() override
         {
+            activeSingleStepCallback = nullptr;
             GlobalControl::uninit();
         }
     };
 
     TEST_F(SingleStepSupvervisorValidStateFixture, setSingleStepCallback_validCallbackTarget_triggersCallback)
     {
-        singleStepSupervisor->setSingleStepCallback(testVcpuId, mockSinglestepCallback->AsStdFunction(), 0);
+        singleStepSupervisor->setSingleStepCallback(testVcpuId, forwardSingleStepCallback, 0);
         vmi_event_t testEvent{};
         testEvent.vcpu_id = testVcpuId;
 
-        EXPECT_CALL(*mockSinglestepCallback, Call(_)).Times(1);
+        EXPECT_CALL(mockSinglestepCallback, Call(_)).Times(1);
         EXPECT_NO_THROW(SingleStepSupervisor::_defaultSingleStepCallback(nullptr, &testEvent));
     }
 
     TEST_F(SingleStepSupvervisorValidStateFixture,
-           setSingleStepCallback_callbackAlreadyRegisteredForCurrentVcpu_throwsVmiException)
+           setSingleStepCallback_callbackAlreadyRegisteredForCurrentVcpu_secondCallbackQueuedForNextStep)
+    {
+        constexpr uint64_t firstData = 1;
+        constexpr uint64_t secondData = 2;
+        EXPECT_CALL(*vmiInterface, registerEvent(_)).Times(1);
+        singleStepSupervisor->setSingleStepCallback(testVcpuId, forwardSingleStepCallback, firstData);
+        singleStepSupervisor->setSingleStepCallback(testVcpuId, forwardSingleStepCallback, secondData);
+        vmi_event_t testEvent{};
+        testEvent.vcpu_id = testVcpuId;
+
+        {
+            InSequence sequence;
+            EXPECT_CALL(mockSinglestepCallback, Call(Field(&vmi_event_t::data, reinterpret_cast<void*>(firstData))));
+            EXPECT_CALL(*vmiInterface, stopSingleStepForVcpu(&testEvent, testVcpuId));
+            EXPECT_CALL(mockSinglestepCallback, Call(Field(&vmi_event_t::data, reinterpret_cast<void*>(secondData))));
+        }
+        SingleStepSupervisor::_defaultSingleStepCallback(nullptr, &testEvent);
+        SingleStepSupervisor::_defaultSingleStepCallback(nullptr, &testEvent);
+    }
+
+    TEST_F(SingleStepSupvervisorValidStateFixture, setSingleStepCallback_tooManyPendingCallbacks_throwsVmiException)
     {
-        singleStepSupervisor->setSingleStepCallback(testVcpuId, mockSinglestepCallback->AsStdFunction(), 0);
+        constexpr uint64_t maxQueuedRequests = 8;
+        EXPECT_CALL(*vmiInterface, registerEvent(_)).Times(1);
+        for (uint64_t request = 0; request < maxQueuedRequests; request++)
+        {
+            singleStepSupervisor->setSingleStepCallback(testVcpuId, forwardSingleStepCallback, request);
+        }
 
-        EXPECT_THROW(
-            singleStepSupervisor->setSingleStepCallback(testVcpuId, mockSinglestepCallback->AsStdFunction(), 0),
-            VmiException);
+        EXPECT_THROW(singleStepSupervisor->setSingleStepCallback(testVcpuId, forwardSingleStepCallback, 0),
+                     VmiException);
     }
 
     TEST_F(SingleStepSupvervisorValidStateFixture, setSingleStepCallback_validCallbackTarget_stopSingleStepForVCPU)
     {
-        singleStepSupervisor->setSingleStepCallback(testVcpuId, mockSinglestepCallback->AsStdFunction(), 0);
+        singleStepSupervisor->setSingleStepCallback(testVcpuId, forwardSingleStepCallback, 0);
         vmi_event_t testEvent{};
         testEvent.vcpu_id = testVcpuId;
 
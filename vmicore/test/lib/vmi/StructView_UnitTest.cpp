@@ -0,0 +1,45 @@
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vmi/StructView.h>
+#include <vmicore/vmi/VmiException.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr std::size_t testCapacity = 0x20;
+        constexpr std::size_t testStructSize = 0x10;
+    }
+
+    TEST(StructViewTest, constructor_structSizeExceedsCapacity_throwsVmiException)
+    {
+        EXPECT_THROW(StructView<testCapacity> view(testCapacity + 1), VmiException);
+    }
+
+    TEST(StructViewTest, readBitfield_fourByteField_extractsBits)
+    {
+        StructView<testCapacity> view(testStructSize);
+        uint32_t flags = 0b1011'0000'0000;
+        std::memcpy(view.data().data() + 4, &flags, sizeof(flags));
+
+        EXPECT_EQ(view.readBitfield(4, sizeof(flags), 8, 12), 0b1011);
+    }
+
+    TEST(StructViewTest, readString_unterminatedCharacterArray_truncatedToMaxLength)
+    {
+        StructView<testCapacity> view(testStructSize);
+        std::array<char, testStructSize> characters{};
+        characters.fill('A');
+        std::memcpy(view.data().data(), characters.data(), characters.size());
+
+        EXPECT_EQ(view.readString(0, 4), "AAAA");
+    }
+
+    TEST(StructViewTest, read_accessBeyondStructSize_throwsVmiException)
+    {
+        StructView<testCapacity> view(testStructSize);
+
+        EXPECT_THROW([[maybe_unused]] auto value = view.read<uint64_t>(testStructSize - 4), VmiException);
+    }
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <vmi/TranslationCache.h>
+#include <vmicore/os/PagingDefinitions.h>
+
+namespace VmiCore
+{
+    namespace
+    {
+        constexpr addr_t testDtb1 = 0x1aa000;
+        constexpr addr_t testDtb2 = 0x2bb000;
+        constexpr addr_t testVA = 0xfffff80000001234;
+        constexpr addr_t testPA = 0x5678000;
+        constexpr addr_t testGFN = testPA >> PagingDefinitions::numberOfPageIndexBits;
+    }
+
+    TEST(TranslationCacheTest, lookup_cachedPage_physicalAddressIncludesPageOffset)
+    {
+        TranslationCache translationCache{};
+        translationCache.insert(testDtb1, testVA & PagingDefinitions::stripPageOffsetMask, testPA);
+
+        EXPECT_EQ(translationCache.lookup(testDtb1, testVA), testPA + (testVA & PagingDefinitions::pageOffsetMask));
+    }
+
+    TEST(TranslationCacheTest, invalidateDtb_twoAddressSpaces_otherAddressSpaceStaysCached)
+    {
+        TranslationCache translationCache{};
+        translationCache.insert(testDtb1, testVA, testPA);
+        translationCache.insert(testDtb2, testVA, testPA);
+
+        translationCache.invalidateDtb(testDtb1);
+
+        EXPECT_FALSE(translationCache.lookup(testDtb1, testVA).has_value());
+        EXPECT_TRUE(translationCache.lookup(testDtb2, testVA).has_value());
+    }
+
+    TEST(TranslationCacheTest, invalidateGfn_frameMappedInTwoAddressSpaces_bothTranslationsDropped)
+    {
+        TranslationCache translationCache{};
+        translationCache.insert(testDtb1, testVA, testPA);
+        translationCache.insert(testDtb2, testVA, testPA);
+
+        translationCache.invalidateGfn(testGFN);
+
+        EXPECT_FALSE(translationCache.lookup(testDtb1, testVA).has_value());
+        EXPECT_FALSE(translationCache.lookup(testDtb2, testVA).has_value());
+    }
+
+    TEST(TranslationCacheTest, invalidateGfn_pageRemappedToOtherFrame_newTranslationKept)
+    {
+        TranslationCache translationCache{};
+        translationCache.insert(testDtb1, testVA, testPA);
+        translationCache.insert(testDtb1, testVA, testPA + PagingDefinitions::pageSizeInBytes);
+
+        translationCache.invalidateGfn(testGFN);
+
+        EXPECT_TRUE(translationCache.lookup(testDtb1, testVA).has_value());
+    }
+
+    TEST(TranslationCacheTest, getStatistics_oneHitOneMiss_countersUpdated)
+    {
+        TranslationCache translationCache{};
+        translationCache.insert(testDtb1, testVA, testPA);
+
+        [[maybe_unused]] auto hit = translationCache.lookup(testDtb1, testVA);
+        [[maybe_unused]] auto miss = translationCache.lookup(testDtb2, testVA);
+
+        auto statistics = translationCache.getStatistics();
+        EXPECT_EQ(statistics.hits, 1);
+        EXPECT_EQ(statistics.misses, 1);
+    }
+}
@@ -19,6 +19,20 @@ namespace VmiCore
             (uint64_t, const ActiveProcessInformation&, const std::function<BpResponse(IInterruptEvent&)>&, bool),
             (override));
 
+        MOCK_METHOD(std::shared_ptr<IBreakpoint>,
+                    createBreakpoint,
+                    (uint64_t,
+                     const ActiveProcessInformation&,
+                     const std::function<BpResponse(IInterruptEvent&)>&,
+                     bool,
+                     const std::optional<BreakpointFilter>&),
+                    (override));
+
+        MOCK_METHOD(bool,
+                    createBreakpoints,
+                    (const ActiveProcessInformation&, std::span<BreakpointSpec>, bool),
+                    (override));
+
         MOCK_METHOD(void, deleteBreakpoint, (IBreakpoint*), (override));
     };
 }
@@ -25,9 +25,17 @@ namespace VmiCore
 
         MOCK_METHOD(uint64_t, readVA, (addr_t, addr_t, std::size_t), (override));
 
+        MOCK_METHOD(std::optional<uint8_t>, tryRead8VA, (uint64_t, uint64_t), (override));
+
+        MOCK_METHOD(std::optional<uint32_t>, tryRead32VA, (uint64_t, uint64_t), (override));
+
+        MOCK_METHOD(std::optional<uint64_t>, tryRead64VA, (uint64_t, uint64_t), (override));
+
         MOCK_METHOD(bool, readXVA, (uint64_t, uint64_t, std::vector<uint8_t>&, std::size_t), (override));
 
-        MOCK_METHOD(mapped_regions_t, mmapGuest, (addr_t, addr_t, std::size_t), (override));
+        MOCK_METHOD(bool, readBatch, (std::span<BatchReadEntry>), (override));
+
+        MOCK_METHOD(std::vector<mapped_regions_t>, mmapGuest, (addr_t, addr_t, std::size_t), (override));
 
         MOCK_METHOD(void, freeMappedRegions, (const mapped_regions_t&), (override));
 
@@ -37,6 +45,8 @@ namespace VmiCore
 
         MOCK_METHOD(void, registerEvent, (vmi_event_t&), (override));
 
+        MOCK_METHOD(void, setMemAccess, (std::span<const addr_t>, vmi_mem_access_t), (override));
+
         MOCK_METHOD(uint64_t, getCurrentVmId, (), (override));
 
         MOCK_METHOD(uint, getNumberOfVCPUs, (), (const override));
@@ -61,13 +71,12 @@ namespace VmiCore
 
         MOCK_METHOD(std::optional<std::string>, extractWStringAtVA, (addr_t stringVA, addr_t cr3), (override));
 
-        MOCK_METHOD(std::optional<std::unique_ptr<std::string>>,
-                    tryExtractUnicodeStringAtVA,
-                    (addr_t, addr_t),
-                    (override));
+        MOCK_METHOD(std::optional<std::string>, tryExtractUnicodeStringAtVA, (addr_t, addr_t), (override));
 
         MOCK_METHOD(std::unique_ptr<std::string>, extractStringAtVA, (addr_t, addr_t), (override));
 
+        MOCK_METHOD(std::optional<std::string>, tryExtractStringAtVA, (addr_t, addr_t), (override));
+
         MOCK_METHOD(void, stopSingleStepForVcpu, (vmi_event_t*, uint), (override));
 
         MOCK_METHOD(OperatingSystem, getOsType, (), (override));
@@ -90,6 +99,10 @@ namespace VmiCore
         MOCK_METHOD(void, flushV2PCache, (addr_t), (override));
 
         MOCK_METHOD(void, flushPageCache, (), (override));
+
+        MOCK_METHOD(void, invalidateTranslationsToGfn, (addr_t), (override));
+
+        MOCK_METHOD(TranslationCacheStatistics, getTranslationCacheStatistics, (), (const, override));
     };
 }
 
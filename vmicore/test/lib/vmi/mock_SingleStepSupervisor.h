@@ -11,10 +11,7 @@ namespace VmiCore
       public:
         MOCK_METHOD(void, initializeSingleStepEvents, (), (override));
         MOCK_METHOD(void, teardown, (), (override));
-        MOCK_METHOD(void,
-                    setSingleStepCallback,
-                    (uint, const std::function<void(vmi_event_t*)>&, uint64_t),
-                    (override));
+        MOCK_METHOD(void, setSingleStepCallback, (uint, SingleStepCallback, uint64_t), (override));
     };
 }
 